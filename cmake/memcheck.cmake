@@ -64,15 +64,28 @@ add_dependencies(memcheck-short
     memcheck-conformance_concurrent_queue
     memcheck-conformance_concurrent_hash_map
     memcheck-test_parallel_for
+    memcheck-test_parallel_for_chain
+    memcheck-test_parallel_wavefront
     memcheck-test_parallel_for_each
     memcheck-test_parallel_reduce
+    memcheck-test_parallel_transform_reduce
     memcheck-test_parallel_sort
+    memcheck-test_parallel_stable_sort
     memcheck-test_parallel_invoke
     memcheck-test_parallel_scan
     memcheck-test_parallel_pipeline
     memcheck-test_eh_algorithms
     memcheck-test_task_group
     memcheck-test_task_arena
+    memcheck-test_scheduler_statistics
+    memcheck-test_scheduler_tracing
+    memcheck-test_worker_wait_policy
+    memcheck-test_task_arena_resizing
+    memcheck-test_task_arena_weights
+    memcheck-test_task_deadlines
+    memcheck-test_coro_task
+    memcheck-test_task_dependencies
+    memcheck-test_scratch_allocator
     memcheck-test_enumerable_thread_specific
     memcheck-test_resumable_tasks
     memcheck-conformance_mutex
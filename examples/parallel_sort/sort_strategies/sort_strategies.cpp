@@ -0,0 +1,160 @@
+/*
+    Copyright (c) 2024 Intel Corporation
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#define TBB_PREVIEW_PARALLEL_SORT_STRATEGIES 1
+
+#include "oneapi/tbb/parallel_sort.h"
+#include "oneapi/tbb/global_control.h"
+#include "oneapi/tbb/tick_count.h"
+
+#include "common/utility/get_default_num_threads.hpp"
+#include "common/utility/utility.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+std::size_t num_elements = 10000000;
+bool silent = false;
+
+template <typename T>
+void generate(std::vector<T>& data, std::mt19937_64& rng) {
+    for (auto& value : data) {
+        value = static_cast<T>(rng());
+    }
+}
+
+void generate(std::vector<float>& data, std::mt19937_64& rng) {
+    std::uniform_real_distribution<float> distribution(-1e6f, 1e6f);
+    for (auto& value : data) {
+        value = distribution(rng);
+    }
+}
+
+void generate(std::vector<std::string>& data, std::mt19937_64& rng) {
+    for (auto& value : data) {
+        value = std::to_string(rng());
+    }
+}
+
+template <typename T, typename Sort>
+void measure(const char* type_name, const char* sort_name, const std::vector<T>& input, Sort sort) {
+    std::vector<T> data = input;
+    tbb::tick_count t0 = tbb::tick_count::now();
+    sort(data);
+    double seconds = (tbb::tick_count::now() - t0).seconds();
+    if (!std::is_sorted(data.begin(), data.end())) {
+        throw std::runtime_error(std::string("the result of ") + sort_name + " is not sorted");
+    }
+    if (!silent) {
+        std::cout << type_name << "\t" << sort_name << "\t" << seconds << " sec\n";
+    }
+}
+
+template <typename T>
+void run_arithmetic(const char* type_name, const std::vector<T>& input) {
+    measure(type_name, "quick_sort", input, [](std::vector<T>& data) {
+        tbb::parallel_sort(data, std::less<T>(), tbb::quick_sort_tag());
+    });
+    measure(type_name, "radix_sort", input, [](std::vector<T>& data) {
+        tbb::parallel_sort(data, std::less<T>(), tbb::radix_sort_tag());
+    });
+    measure(type_name, "sample_sort", input, [](std::vector<T>& data) {
+        tbb::parallel_sort(data, std::less<T>(), tbb::sample_sort_tag());
+    });
+    measure(type_name, "auto", input, [](std::vector<T>& data) {
+        tbb::parallel_sort(data);
+    });
+}
+
+void run_strings(const std::vector<std::string>& input) {
+    measure("string", "quick_sort", input, [](std::vector<std::string>& data) {
+        tbb::parallel_sort(data, std::less<std::string>(), tbb::quick_sort_tag());
+    });
+    measure("string", "sample_sort", input, [](std::vector<std::string>& data) {
+        tbb::parallel_sort(data, std::less<std::string>(), tbb::sample_sort_tag());
+    });
+    measure("string", "auto", input, [](std::vector<std::string>& data) {
+        tbb::parallel_sort(data);
+    });
+}
+
+int main(int argc, char* argv[]) {
+    try {
+        tbb::tick_count main_start_time = tbb::tick_count::now();
+        // zero number of threads means to run std::sort
+        utility::thread_number_range threads(utility::get_default_num_threads, 0);
+
+        utility::parse_cli_arguments(
+            argc,
+            argv,
+            utility::cli_argument_pack()
+                //"-h" option for displaying help is present implicitly
+                .positional_arg(threads, "n-of-threads", utility::thread_number_range_desc)
+                .positional_arg(num_elements, "n-of-elements", "number of elements to sort")
+                .arg(silent, "silent", "no output except time elapsed"));
+
+        std::mt19937_64 rng(42);
+        std::vector<std::int32_t> ints(num_elements);
+        std::vector<std::uint64_t> uints(num_elements);
+        std::vector<float> floats(num_elements);
+        // Strings are much more expensive to compare, sort fewer of them
+        std::vector<std::string> strings(num_elements / 10);
+        generate(ints, rng);
+        generate(uints, rng);
+        generate(floats, rng);
+        generate(strings, rng);
+
+        for (int p = threads.first; p <= threads.last; p = threads.step(p)) {
+            if (!silent) {
+                std::cout << "Threads: " << p << "\n";
+            }
+            if (p == 0) {
+                measure("int32", "std::sort", ints, [](std::vector<std::int32_t>& data) {
+                    std::sort(data.begin(), data.end());
+                });
+                measure("uint64", "std::sort", uints, [](std::vector<std::uint64_t>& data) {
+                    std::sort(data.begin(), data.end());
+                });
+                measure("float", "std::sort", floats, [](std::vector<float>& data) {
+                    std::sort(data.begin(), data.end());
+                });
+                measure("string", "std::sort", strings, [](std::vector<std::string>& data) {
+                    std::sort(data.begin(), data.end());
+                });
+            }
+            else {
+                tbb::global_control control(tbb::global_control::max_allowed_parallelism, p);
+                run_arithmetic("int32", ints);
+                run_arithmetic("uint64", uints);
+                run_arithmetic("float", floats);
+                run_strings(strings);
+            }
+        }
+
+        utility::report_elapsed_time((tbb::tick_count::now() - main_start_time).seconds());
+        return 0;
+    }
+    catch (std::exception& e) {
+        std::cerr << "error occurred. error text is :\"" << e.what() << "\"\n";
+        return 1;
+    }
+}
@@ -0,0 +1,163 @@
+/*
+    Copyright (c) 2024 Intel Corporation
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#define TBB_PREVIEW_TASK_DEADLINES 1
+
+#include "oneapi/tbb/global_control.h"
+#include "oneapi/tbb/task_arena.h"
+#include "oneapi/tbb/tick_count.h"
+
+#include "common/utility/get_default_num_threads.hpp"
+#include "common/utility/utility.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+int num_requests = 1000;
+int interval_us = 200;
+bool silent = false;
+
+using clock_type = std::chrono::steady_clock;
+
+//! The number of batch tasks waiting in the arena per thread
+constexpr int batch_backlog = 4;
+//! The work of a batch task
+constexpr std::chrono::microseconds batch_work{100};
+//! The latency class of the interactive requests
+constexpr std::chrono::microseconds request_latency{50};
+
+void spin_for(std::chrono::microseconds duration) {
+    clock_type::time_point finish = clock_type::now() + duration;
+    while (clock_type::now() < finish) {}
+}
+
+//! Keeps the arena saturated: every batch task enqueues its successor until the load is stopped
+class batch_load {
+public:
+    batch_load(tbb::task_arena& arena, int num_threads) : my_arena(arena) {
+        for (int i = 0; i < batch_backlog * num_threads; ++i) {
+            ++my_num_active;
+            my_arena.enqueue(batch_task{this});
+        }
+    }
+
+    void stop() {
+        my_is_stopped = true;
+        while (my_num_active != 0) {
+            std::this_thread::yield();
+        }
+    }
+
+private:
+    struct batch_task {
+        batch_load* my_load;
+        void operator()() const {
+            spin_for(batch_work);
+            if (my_load->my_is_stopped) {
+                --my_load->my_num_active;
+            } else {
+                my_load->my_arena.enqueue(*this);
+            }
+        }
+    };
+
+    tbb::task_arena& my_arena;
+    std::atomic<bool> my_is_stopped{false};
+    std::atomic<int> my_num_active{0};
+};
+
+//! Returns the percentile of the sorted latencies
+long long percentile(const std::vector<long long>& sorted, double fraction) {
+    std::size_t idx = std::min(sorted.size() - 1, std::size_t(fraction * sorted.size()));
+    return sorted[idx];
+}
+
+//! Sends the requests to the saturated arena and reports the time until they start
+void measure(const char* mode_name, bool use_deadlines, int num_threads) {
+    tbb::task_arena arena(num_threads, 0);
+    batch_load load(arena, num_threads);
+
+    std::vector<long long> latencies(num_requests);
+    std::atomic<int> num_done{0};
+    clock_type::time_point next_arrival = clock_type::now();
+    for (int i = 0; i < num_requests; ++i) {
+        next_arrival += std::chrono::microseconds(interval_us);
+        std::this_thread::sleep_until(next_arrival);
+        clock_type::time_point arrival = clock_type::now();
+        auto request = [&latencies, &num_done, arrival, i] {
+            latencies[i] = std::chrono::duration_cast<std::chrono::microseconds>(clock_type::now() - arrival).count();
+            ++num_done;
+        };
+        if (use_deadlines) {
+            arena.enqueue(request, request_latency);
+        } else {
+            arena.enqueue(request);
+        }
+    }
+    while (num_done != num_requests) {
+        std::this_thread::yield();
+    }
+    load.stop();
+
+    std::sort(latencies.begin(), latencies.end());
+    if (!silent) {
+        std::cout << mode_name << "\tlatency: p50 " << percentile(latencies, 0.5) << " us, p99 "
+                  << percentile(latencies, 0.99) << " us, p99.9 " << percentile(latencies, 0.999)
+                  << " us, max " << latencies.back() << " us\n";
+    }
+}
+
+int main(int argc, char* argv[]) {
+    try {
+        tbb::tick_count main_start_time = tbb::tick_count::now();
+        utility::thread_number_range threads(utility::get_default_num_threads);
+
+        utility::parse_cli_arguments(
+            argc,
+            argv,
+            utility::cli_argument_pack()
+                //"-h" option for displaying help is present implicitly
+                .positional_arg(threads, "n-of-threads", utility::thread_number_range_desc)
+                .positional_arg(num_requests, "n-of-requests", "number of interactive requests")
+                .positional_arg(interval_us, "interval", "time between the requests in microseconds")
+                .arg(silent, "silent", "no output except time elapsed"));
+
+        if (num_requests < 1) {
+            std::cerr << "n-of-requests should be positive\n";
+            return 1;
+        }
+        for (int p = threads.first; p <= threads.last; p = threads.step(p)) {
+            if (!silent) {
+                std::cout << "Threads: " << p << "\n";
+            }
+            // The thread that sends the requests does not work in the arena
+            tbb::global_control parallelism(tbb::global_control::max_allowed_parallelism, p + 1);
+            measure("enqueue", /*use_deadlines*/ false, p);
+            measure("deadline", /*use_deadlines*/ true, p);
+        }
+
+        utility::report_elapsed_time((tbb::tick_count::now() - main_start_time).seconds());
+        return 0;
+    }
+    catch (std::exception& e) {
+        std::cerr << "error occurred. error text is :\"" << e.what() << "\"\n";
+        return 1;
+    }
+}
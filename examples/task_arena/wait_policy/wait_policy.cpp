@@ -0,0 +1,121 @@
+/*
+    Copyright (c) 2024 Intel Corporation
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#define TBB_PREVIEW_WORKER_WAIT_POLICY 1
+
+#include "oneapi/tbb/global_control.h"
+#include "oneapi/tbb/parallel_for.h"
+#include "oneapi/tbb/task_arena.h"
+#include "oneapi/tbb/tick_count.h"
+
+#include "common/utility/get_default_num_threads.hpp"
+#include "common/utility/utility.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <ctime>
+#include <iostream>
+#include <thread>
+
+int num_bursts = 100;
+int gap_ms = 1;
+bool silent = false;
+
+using clock_type = std::chrono::steady_clock;
+
+//! Busy work of a task, so the threads cannot finish a burst before all of them join it
+void spin_for(std::chrono::microseconds duration) {
+    clock_type::time_point finish = clock_type::now() + duration;
+    while (clock_type::now() < finish) {}
+}
+
+void update_max(std::atomic<long long>& max_value, long long value) {
+    long long current = max_value.load(std::memory_order_relaxed);
+    while (current < value && !max_value.compare_exchange_weak(current, value)) {}
+}
+
+//! Runs the bursts of work separated by idle periods and reports how fast the threads join
+//! every burst and how much processor time is spent
+void measure(const char* policy_name, tbb::global_control::wait_policy policy, int num_threads) {
+    tbb::global_control control(tbb::global_control::worker_wait_policy, policy);
+    tbb::task_arena arena(num_threads);
+    // Warm up to create the worker threads
+    arena.execute([num_threads] {
+        tbb::parallel_for(0, num_threads, [](int) { spin_for(std::chrono::microseconds(1000)); },
+                          tbb::simple_partitioner());
+    });
+
+    long long total_latency = 0, max_latency = 0;
+    std::clock_t cpu_start = std::clock();
+    tbb::tick_count wall_start = tbb::tick_count::now();
+    for (int burst = 0; burst < num_bursts; ++burst) {
+        // The threads run out of work and wait for the next burst according to the policy
+        std::this_thread::sleep_for(std::chrono::milliseconds(gap_ms));
+        std::atomic<long long> latency{0};
+        clock_type::time_point burst_start = clock_type::now();
+        arena.execute([&] {
+            tbb::parallel_for(0, num_threads, [&](int) {
+                auto started = std::chrono::duration_cast<std::chrono::microseconds>(clock_type::now() - burst_start);
+                update_max(latency, started.count());
+                spin_for(std::chrono::microseconds(50));
+            }, tbb::simple_partitioner());
+        });
+        total_latency += latency;
+        max_latency = std::max(max_latency, latency.load());
+    }
+    double wall_time = (tbb::tick_count::now() - wall_start).seconds();
+    double cpu_time = double(std::clock() - cpu_start) / CLOCKS_PER_SEC;
+
+    if (!silent) {
+        std::cout << policy_name << "\twake-up latency: average " << total_latency / num_bursts
+                  << " us, max " << max_latency << " us\tCPU load: " << cpu_time / wall_time << " cores\n";
+    }
+}
+
+int main(int argc, char* argv[]) {
+    try {
+        tbb::tick_count main_start_time = tbb::tick_count::now();
+        utility::thread_number_range threads(utility::get_default_num_threads);
+
+        utility::parse_cli_arguments(
+            argc,
+            argv,
+            utility::cli_argument_pack()
+                //"-h" option for displaying help is present implicitly
+                .positional_arg(threads, "n-of-threads", utility::thread_number_range_desc)
+                .positional_arg(num_bursts, "n-of-bursts", "number of bursts of work")
+                .positional_arg(gap_ms, "gap", "idle time between the bursts in milliseconds")
+                .arg(silent, "silent", "no output except time elapsed"));
+
+        for (int p = threads.first; p <= threads.last; p = threads.step(p)) {
+            if (!silent) {
+                std::cout << "Threads: " << p << "\n";
+            }
+            tbb::global_control parallelism(tbb::global_control::max_allowed_parallelism, p);
+            measure("power_saving", tbb::global_control::power_saving_wait_policy, p);
+            measure("balanced", tbb::global_control::balanced_wait_policy, p);
+            measure("low_latency", tbb::global_control::low_latency_wait_policy, p);
+        }
+
+        utility::report_elapsed_time((tbb::tick_count::now() - main_start_time).seconds());
+        return 0;
+    }
+    catch (std::exception& e) {
+        std::cerr << "error occurred. error text is :\"" << e.what() << "\"\n";
+        return 1;
+    }
+}
@@ -0,0 +1,183 @@
+/*
+    Copyright (c) 2024 Intel Corporation
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#define TBB_PREVIEW_TASK_DEPENDENCIES 1
+
+#include "oneapi/tbb/flow_graph.h"
+#include "oneapi/tbb/global_control.h"
+#include "oneapi/tbb/task_group.h"
+#include "oneapi/tbb/tick_count.h"
+
+#include "common/utility/get_default_num_threads.hpp"
+#include "common/utility/utility.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+int num_nodes = 100000;
+int num_predecessors = 3;
+bool silent = false;
+
+//! The nodes are numbered in a topological order: every node depends on some of the recent nodes
+constexpr int window = 1000;
+
+//! The dependency graph stored as the lists of the predecessors of the nodes
+struct dependency_graph {
+    std::vector<std::size_t> offsets;
+    std::vector<int> predecessors;
+
+    dependency_graph() : offsets(1, 0) {
+        std::uint32_t seed = 42;
+        for (int node = 0; node < num_nodes; ++node) {
+            int num_recent = node < window ? node : window;
+            for (int i = 0; i < num_predecessors && num_recent > 0; ++i) {
+                seed = seed * 1664525u + 1013904223u;
+                predecessors.push_back(node - 1 - int(seed % std::uint32_t(num_recent)));
+            }
+            offsets.push_back(predecessors.size());
+        }
+    }
+
+    template <typename F>
+    void for_each_edge(F f) const {
+        for (int node = 0; node < num_nodes; ++node) {
+            for (std::size_t i = offsets[node]; i < offsets[node + 1]; ++i) {
+                f(predecessors[i], node);
+            }
+        }
+    }
+};
+
+//! Records the order of the execution of the nodes
+class execution_log {
+public:
+    execution_log() : my_order(num_nodes) {}
+
+    void execute(int node) {
+        my_order[node] = ++my_counter;
+    }
+
+    bool is_valid(const dependency_graph& g) const {
+        bool valid = my_counter == num_nodes;
+        g.for_each_edge([this, &valid](int predecessor, int successor) {
+            valid = valid && my_order[predecessor] < my_order[successor];
+        });
+        return valid;
+    }
+
+private:
+    std::vector<int> my_order;
+    std::atomic<int> my_counter{0};
+};
+
+void report(const char* mode_name, double build_time, double run_time, bool is_valid) {
+    if (!silent) {
+        std::cout << mode_name << "\tbuild: " << build_time << " s, run: " << run_time << " s"
+                  << (is_valid ? "" : ", the order of the nodes is broken") << "\n";
+    }
+}
+
+//! Runs the graph as the tasks of a task group ordered by the dependencies of the task handles
+void run_task_handles(const dependency_graph& g) {
+    execution_log log;
+    tbb::task_group tg;
+
+    tbb::tick_count start = tbb::tick_count::now();
+    std::vector<tbb::task_handle> handles;
+    handles.reserve(num_nodes);
+    for (int node = 0; node < num_nodes; ++node) {
+        handles.push_back(tg.defer([&log, node] { log.execute(node); }));
+    }
+    g.for_each_edge([&handles](int predecessor, int successor) {
+        tbb::task_group::set_task_order(handles[predecessor], handles[successor]);
+    });
+    tbb::tick_count built = tbb::tick_count::now();
+
+    for (auto& h : handles) {
+        tg.run(std::move(h));
+    }
+    tg.wait();
+    tbb::tick_count finish = tbb::tick_count::now();
+    report("task_handle", (built - start).seconds(), (finish - built).seconds(), log.is_valid(g));
+}
+
+//! Runs the graph as a flow graph of continue nodes
+void run_flow_graph(const dependency_graph& g) {
+    using node_type = tbb::flow::continue_node<tbb::flow::continue_msg>;
+    execution_log log;
+    tbb::flow::graph fg;
+
+    tbb::tick_count start = tbb::tick_count::now();
+    std::vector<std::unique_ptr<node_type>> nodes;
+    nodes.reserve(num_nodes);
+    for (int node = 0; node < num_nodes; ++node) {
+        nodes.emplace_back(new node_type(fg, [&log, node](const tbb::flow::continue_msg&) { log.execute(node); }));
+    }
+    g.for_each_edge([&nodes](int predecessor, int successor) {
+        tbb::flow::make_edge(*nodes[predecessor], *nodes[successor]);
+    });
+    tbb::tick_count built = tbb::tick_count::now();
+
+    for (int node = 0; node < num_nodes; ++node) {
+        if (g.offsets[node] == g.offsets[node + 1]) {
+            nodes[node]->try_put(tbb::flow::continue_msg());
+        }
+    }
+    fg.wait_for_all();
+    tbb::tick_count finish = tbb::tick_count::now();
+    report("flow_graph", (built - start).seconds(), (finish - built).seconds(), log.is_valid(g));
+}
+
+int main(int argc, char* argv[]) {
+    try {
+        tbb::tick_count main_start_time = tbb::tick_count::now();
+        utility::thread_number_range threads(utility::get_default_num_threads);
+
+        utility::parse_cli_arguments(
+            argc,
+            argv,
+            utility::cli_argument_pack()
+                //"-h" option for displaying help is present implicitly
+                .positional_arg(threads, "n-of-threads", utility::thread_number_range_desc)
+                .positional_arg(num_nodes, "n-of-nodes", "number of nodes in the graph")
+                .positional_arg(num_predecessors, "n-of-predecessors", "number of predecessors of a node")
+                .arg(silent, "silent", "no output except time elapsed"));
+
+        if (num_nodes < 1 || num_predecessors < 0) {
+            std::cerr << "n-of-nodes should be positive and n-of-predecessors should not be negative\n";
+            return 1;
+        }
+        dependency_graph g;
+        for (int p = threads.first; p <= threads.last; p = threads.step(p)) {
+            if (!silent) {
+                std::cout << "Threads: " << p << "\n";
+            }
+            tbb::global_control parallelism(tbb::global_control::max_allowed_parallelism, p);
+            run_task_handles(g);
+            run_flow_graph(g);
+        }
+
+        utility::report_elapsed_time((tbb::tick_count::now() - main_start_time).seconds());
+        return 0;
+    }
+    catch (std::exception& e) {
+        std::cerr << "error occurred. error text is :\"" << e.what() << "\"\n";
+        return 1;
+    }
+}
@@ -29,6 +29,12 @@
 #include "oneapi/tbb/blocked_range2d.h"
 #include "oneapi/tbb/blocked_range3d.h"
 #include "oneapi/tbb/blocked_nd_range.h"
+#if TBB_PREVIEW_BLOCKED_RANGE_TRAVERSAL
+#include "tbb/blocked_range_traversal.h"
+#endif
+#if TBB_PREVIEW_WEIGHTED_BLOCKED_RANGE
+#include "tbb/weighted_blocked_range.h"
+#endif
 #include "oneapi/tbb/cache_aligned_allocator.h"
 #include "oneapi/tbb/combinable.h"
 #include "oneapi/tbb/concurrent_hash_map.h"
@@ -43,6 +49,9 @@
 #include "oneapi/tbb/concurrent_map.h"
 #include "oneapi/tbb/concurrent_set.h"
 #include "oneapi/tbb/concurrent_vector.h"
+#if TBB_PREVIEW_COROUTINES && __TBB_CPP20_COROUTINES_PRESENT
+#include "oneapi/tbb/coro_task.h"
+#endif
 #include "oneapi/tbb/enumerable_thread_specific.h"
 #include "oneapi/tbb/flow_graph.h"
 #include "oneapi/tbb/global_control.h"
@@ -50,15 +59,36 @@
 #include "oneapi/tbb/null_mutex.h"
 #include "oneapi/tbb/null_rw_mutex.h"
 #include "oneapi/tbb/parallel_for.h"
+#if TBB_PREVIEW_PARALLEL_FOR_CHAIN
+#include "tbb/parallel_for_chain.h"
+#endif
 #include "oneapi/tbb/parallel_for_each.h"
 #include "oneapi/tbb/parallel_invoke.h"
 #include "oneapi/tbb/parallel_pipeline.h"
 #include "oneapi/tbb/parallel_reduce.h"
 #include "oneapi/tbb/parallel_scan.h"
 #include "oneapi/tbb/parallel_sort.h"
+#if TBB_PREVIEW_PARALLEL_STABLE_SORT
+#include "tbb/parallel_stable_sort.h"
+#endif
+#if TBB_PREVIEW_PARALLEL_TRANSFORM_REDUCE
+#include "tbb/parallel_transform_reduce.h"
+#endif
+#if TBB_PREVIEW_PARALLEL_WAVEFRONT
+#include "tbb/parallel_wavefront.h"
+#endif
 #include "oneapi/tbb/partitioner.h"
 #include "oneapi/tbb/queuing_mutex.h"
 #include "oneapi/tbb/queuing_rw_mutex.h"
+#if TBB_PREVIEW_SCHEDULER_STATISTICS
+#include "oneapi/tbb/scheduler_statistics.h"
+#endif
+#if TBB_PREVIEW_SCHEDULER_TRACING
+#include "oneapi/tbb/scheduler_tracing.h"
+#endif
+#if TBB_PREVIEW_SCRATCH_ALLOCATOR
+#include "oneapi/tbb/scratch_allocator.h"
+#endif
 #include "oneapi/tbb/spin_mutex.h"
 #include "oneapi/tbb/spin_rw_mutex.h"
 #include "oneapi/tbb/mutex.h"
@@ -0,0 +1,365 @@
+/*
+    Copyright (c) 2024 Intel Corporation
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#ifndef __TBB_blocked_range_traversal_H
+#define __TBB_blocked_range_traversal_H
+
+#if ! TBB_PREVIEW_BLOCKED_RANGE_TRAVERSAL
+    #error Set TBB_PREVIEW_BLOCKED_RANGE_TRAVERSAL to include blocked_range_traversal.h
+#endif
+
+#include "detail/_config.h"
+#include "detail/_namespace_injection.h"
+#include "detail/_range_common.h"
+#include "detail/_template_helpers.h" // index_sequence
+#include "detail/_utils.h"
+
+#include "blocked_range.h"
+#include "blocked_range2d.h"
+#include "blocked_range3d.h"
+#include "blocked_nd_range.h"
+
+#include <array>
+#include <cstddef>
+
+namespace tbb {
+namespace detail {
+namespace d1 {
+
+//! Order in which for_each_tile visits the tiles of a range
+enum class traversal_order {
+    //! The last dimension changes fastest
+    row_major,
+    //! Z-order curve: the tiles are visited quadrant by quadrant, recursively
+    morton,
+    //! Hilbert curve: consecutive tiles share a side. Treated as morton for more than two dimensions.
+    hilbert
+};
+
+//! Number of tiles of the grain size that cover the dimension
+template <typename Value>
+std::size_t tile_count( const blocked_range<Value>& d ) {
+    return d.empty() ? 0 : (d.size() + d.grainsize() - 1) / d.grainsize();
+}
+
+//! The tile with the given index; the last tile may be smaller than the grain size
+template <typename Value>
+blocked_range<Value> tile_of( const blocked_range<Value>& d, std::size_t index ) {
+    const std::size_t first = index * d.grainsize();
+    const std::size_t last = first + d.grainsize() < d.size() ? first + d.grainsize() : d.size();
+    return blocked_range<Value>(d.begin() + first, d.begin() + last, d.grainsize());
+}
+
+template <std::size_t N>
+using tile_index = std::array<std::size_t, N>;
+
+template <std::size_t N, typename F>
+void row_major_walk( const tile_index<N>& counts, const F& f ) {
+    for (std::size_t d = 0; d < N; ++d) {
+        if (counts[d] == 0) {
+            return;
+        }
+    }
+    tile_index<N> t{};
+    for (;;) {
+        f(t);
+        std::size_t d = N;
+        while (d > 0 && ++t[d - 1] == counts[d - 1]) {
+            t[--d] = 0;
+        }
+        if (d == 0) {
+            return;
+        }
+    }
+}
+
+//! Visits the cells of the cube [origin, origin + side) that are inside the grid in Z-order.
+/** The first dimension corresponds to the most significant bit of the Morton code. */
+template <std::size_t N, typename F>
+void morton_walk( const tile_index<N>& counts, tile_index<N> origin, std::size_t side, const F& f ) {
+    for (std::size_t d = 0; d < N; ++d) {
+        if (origin[d] >= counts[d]) {
+            return;
+        }
+    }
+    if (side == 1) {
+        f(origin);
+        return;
+    }
+    const std::size_t half = side / 2;
+    for (std::size_t child = 0; child < (std::size_t(1) << N); ++child) {
+        tile_index<N> child_origin = origin;
+        for (std::size_t d = 0; d < N; ++d) {
+            if (child & (std::size_t(1) << (N - 1 - d))) {
+                child_origin[d] += half;
+            }
+        }
+        morton_walk<N>(counts, child_origin, half, f);
+    }
+}
+
+//! Visits the cells of the square spanned by the vectors (xi, xj) and (yi, yj) from (x0, y0) along the Hilbert curve.
+/** The cells outside of the grid are skipped together with the subsquares that contain them. */
+template <typename F>
+void hilbert_walk( const tile_index<2>& counts, long x0, long y0, long xi, long xj, long yi, long yj, const F& f ) {
+    const long side = (xi < 0 ? -xi : xi) + (yi < 0 ? -yi : yi);
+    const long low_x = x0 + (xi < 0 ? xi : 0) + (yi < 0 ? yi : 0);
+    const long low_y = y0 + (xj < 0 ? xj : 0) + (yj < 0 ? yj : 0);
+    if (std::size_t(low_x) >= counts[0] || std::size_t(low_y) >= counts[1]) {
+        return;
+    }
+    if (side == 1) {
+        f(tile_index<2>{{std::size_t(low_x), std::size_t(low_y)}});
+        return;
+    }
+    hilbert_walk(counts, x0, y0, yi / 2, yj / 2, xi / 2, xj / 2, f);
+    hilbert_walk(counts, x0 + xi / 2, y0 + xj / 2, xi / 2, xj / 2, yi / 2, yj / 2, f);
+    hilbert_walk(counts, x0 + xi / 2 + yi / 2, y0 + xj / 2 + yj / 2, xi / 2, xj / 2, yi / 2, yj / 2, f);
+    hilbert_walk(counts, x0 + xi / 2 + yi, y0 + xj / 2 + yj, -yi / 2, -yj / 2, -xi / 2, -xj / 2, f);
+}
+
+//! Space-filling curve traversal of a grid with more than two dimensions
+template <std::size_t N, typename F>
+void curve_walk( const tile_index<N>& counts, std::size_t side, traversal_order, const F& f ) {
+    morton_walk<N>(counts, tile_index<N>{}, side, f);
+}
+
+template <typename F>
+void curve_walk( const tile_index<2>& counts, std::size_t side, traversal_order order, const F& f ) {
+    if (order == traversal_order::hilbert) {
+        hilbert_walk(counts, 0, 0, long(side), 0, 0, long(side), f);
+    } else {
+        morton_walk<2>(counts, tile_index<2>{}, side, f);
+    }
+}
+
+//! Calls f for the index of every tile of the grid in the given order
+template <std::size_t N, typename F>
+void walk_tiles( const tile_index<N>& counts, traversal_order order, const F& f ) {
+    std::size_t side = 1;
+    for (std::size_t d = 0; d < N; ++d) {
+        if (counts[d] == 0) {
+            return;
+        }
+        while (side < counts[d]) {
+            side *= 2;
+        }
+    }
+    if (order == traversal_order::row_major) {
+        row_major_walk<N>(counts, f);
+    } else {
+        curve_walk(counts, side, order, f);
+    }
+}
+
+/** \name for_each_tile
+    Calls the body for each tile of the range in the given order. The tiles have the grain size
+    of the range in each dimension and are aligned to the beginning of the range; the last tile
+    in a dimension may be smaller. A tile has the type of the range. **/
+//@{
+
+template <typename RowValue, typename ColValue, typename Body>
+void for_each_tile( const blocked_range2d<RowValue, ColValue>& range, traversal_order order, const Body& body ) {
+    const tile_index<2> counts{{tile_count(range.rows()), tile_count(range.cols())}};
+    walk_tiles<2>(counts, order, [&] (const tile_index<2>& t) {
+        blocked_range<RowValue> rows = tile_of(range.rows(), t[0]);
+        blocked_range<ColValue> cols = tile_of(range.cols(), t[1]);
+        tbb::detail::invoke(body, blocked_range2d<RowValue, ColValue>(rows.begin(), rows.end(), rows.grainsize(),
+                                                                      cols.begin(), cols.end(), cols.grainsize()));
+    });
+}
+
+template <typename PageValue, typename RowValue, typename ColValue, typename Body>
+void for_each_tile( const blocked_range3d<PageValue, RowValue, ColValue>& range, traversal_order order, const Body& body ) {
+    const tile_index<3> counts{{tile_count(range.pages()), tile_count(range.rows()), tile_count(range.cols())}};
+    walk_tiles<3>(counts, order, [&] (const tile_index<3>& t) {
+        blocked_range<PageValue> pages = tile_of(range.pages(), t[0]);
+        blocked_range<RowValue> rows = tile_of(range.rows(), t[1]);
+        blocked_range<ColValue> cols = tile_of(range.cols(), t[2]);
+        tbb::detail::invoke(body, blocked_range3d<PageValue, RowValue, ColValue>(
+            pages.begin(), pages.end(), pages.grainsize(),
+            rows.begin(), rows.end(), rows.grainsize(),
+            cols.begin(), cols.end(), cols.grainsize()));
+    });
+}
+
+template <typename Value, unsigned int N, std::size_t... Is, typename Body>
+void for_each_tile( const blocked_nd_range_impl<Value, N, index_sequence<Is...>>& range, traversal_order order,
+                    const Body& body ) {
+    using range_type = blocked_nd_range_impl<Value, N, index_sequence<Is...>>;
+    const tile_index<N> counts{{tile_count(range.dim(Is))...}};
+    walk_tiles<N>(counts, order, [&] (const tile_index<N>& t) {
+        tbb::detail::invoke(body, range_type(tile_of(range.dim(Is), t[Is])...));
+    });
+}
+//@}
+
+//! Splits the dimension into two parts of about the same size, keeping the boundaries aligned to the grain size.
+/** d keeps the first part; the second part is returned. */
+template <typename Value>
+blocked_range<Value> bisect_dimension( blocked_range<Value>& d ) {
+    __TBB_ASSERT(d.is_divisible(), "cannot split blocked_range that is not divisible");
+    const std::size_t grainsize = d.grainsize();
+    std::size_t half = (d.size() / 2 + grainsize / 2) / grainsize * grainsize;
+    if (half == 0) {
+        half = grainsize;
+    }
+    __TBB_ASSERT(half < d.size(), nullptr);
+    Value middle = d.begin() + half;
+    blocked_range<Value> second(middle, d.end(), grainsize);
+    d = blocked_range<Value>(d.begin(), middle, grainsize);
+    return second;
+}
+
+//! Size of the dimension if it can be split, zero otherwise
+template <typename Value>
+std::size_t bisection_size( const blocked_range<Value>& d ) {
+    return d.is_divisible() ? d.size() : 0;
+}
+
+//! A multidimensional range that is split in the cache-oblivious way.
+/** The range is always split in half along the dimension with the largest number of elements,
+    regardless of the proportion requested by the partitioner, and the split points are aligned
+    to the grain size relative to the beginning of the range. The leaves form a k-d tree of tiles,
+    so the parts executed one after another by the same thread are close in the iteration space.
+    Range is one of blocked_range2d, blocked_range3d, or blocked_nd_range; the range can be constructed
+    from the same arguments as Range.
+    @ingroup algorithms */
+template <typename Range>
+class cache_oblivious_range;
+
+template <typename RowValue, typename ColValue>
+class cache_oblivious_range<blocked_range2d<RowValue, ColValue>> : public blocked_range2d<RowValue, ColValue> {
+    using base_type = blocked_range2d<RowValue, ColValue>;
+public:
+    cache_oblivious_range( RowValue row_begin, RowValue row_end, std::size_t row_grainsize,
+                           ColValue col_begin, ColValue col_end, std::size_t col_grainsize )
+        : base_type(row_begin, row_end, row_grainsize, col_begin, col_end, col_grainsize) {}
+
+    cache_oblivious_range( RowValue row_begin, RowValue row_end, ColValue col_begin, ColValue col_end )
+        : base_type(row_begin, row_end, col_begin, col_end) {}
+
+    cache_oblivious_range( const base_type& range ) : base_type(range) {}
+
+    cache_oblivious_range( cache_oblivious_range& r, split ) : base_type(r) {
+        blocked_range<RowValue> rows = r.rows();
+        blocked_range<ColValue> cols = r.cols();
+        if (bisection_size(rows) >= bisection_size(cols)) {
+            blocked_range<RowValue> second = bisect_dimension(rows);
+            assign(r, rows, cols);
+            assign(*this, second, cols);
+        } else {
+            blocked_range<ColValue> second = bisect_dimension(cols);
+            assign(r, rows, cols);
+            assign(*this, rows, second);
+        }
+    }
+
+private:
+    static void assign( base_type& range, const blocked_range<RowValue>& rows, const blocked_range<ColValue>& cols ) {
+        range = base_type(rows.begin(), rows.end(), rows.grainsize(), cols.begin(), cols.end(), cols.grainsize());
+    }
+};
+
+template <typename PageValue, typename RowValue, typename ColValue>
+class cache_oblivious_range<blocked_range3d<PageValue, RowValue, ColValue>>
+    : public blocked_range3d<PageValue, RowValue, ColValue>
+{
+    using base_type = blocked_range3d<PageValue, RowValue, ColValue>;
+public:
+    cache_oblivious_range( PageValue page_begin, PageValue page_end, std::size_t page_grainsize,
+                           RowValue row_begin, RowValue row_end, std::size_t row_grainsize,
+                           ColValue col_begin, ColValue col_end, std::size_t col_grainsize )
+        : base_type(page_begin, page_end, page_grainsize, row_begin, row_end, row_grainsize,
+                    col_begin, col_end, col_grainsize) {}
+
+    cache_oblivious_range( PageValue page_begin, PageValue page_end,
+                           RowValue row_begin, RowValue row_end,
+                           ColValue col_begin, ColValue col_end )
+        : base_type(page_begin, page_end, row_begin, row_end, col_begin, col_end) {}
+
+    cache_oblivious_range( const base_type& range ) : base_type(range) {}
+
+    cache_oblivious_range( cache_oblivious_range& r, split ) : base_type(r) {
+        blocked_range<PageValue> pages = r.pages();
+        blocked_range<RowValue> rows = r.rows();
+        blocked_range<ColValue> cols = r.cols();
+        const std::size_t pages_size = bisection_size(pages);
+        const std::size_t rows_size = bisection_size(rows);
+        const std::size_t cols_size = bisection_size(cols);
+        if (pages_size >= rows_size && pages_size >= cols_size) {
+            blocked_range<PageValue> second = bisect_dimension(pages);
+            assign(r, pages, rows, cols);
+            assign(*this, second, rows, cols);
+        } else if (rows_size >= cols_size) {
+            blocked_range<RowValue> second = bisect_dimension(rows);
+            assign(r, pages, rows, cols);
+            assign(*this, pages, second, cols);
+        } else {
+            blocked_range<ColValue> second = bisect_dimension(cols);
+            assign(r, pages, rows, cols);
+            assign(*this, pages, rows, second);
+        }
+    }
+
+private:
+    static void assign( base_type& range, const blocked_range<PageValue>& pages,
+                        const blocked_range<RowValue>& rows, const blocked_range<ColValue>& cols ) {
+        range = base_type(pages.begin(), pages.end(), pages.grainsize(),
+                          rows.begin(), rows.end(), rows.grainsize(),
+                          cols.begin(), cols.end(), cols.grainsize());
+    }
+};
+
+template <typename Value, unsigned int N, std::size_t... Is>
+class cache_oblivious_range<blocked_nd_range_impl<Value, N, index_sequence<Is...>>>
+    : public blocked_nd_range_impl<Value, N, index_sequence<Is...>>
+{
+    using base_type = blocked_nd_range_impl<Value, N, index_sequence<Is...>>;
+    using dim_range_type = typename base_type::dim_range_type;
+public:
+    cache_oblivious_range( const indexed_t<dim_range_type, Is>&... args ) : base_type(args...) {}
+
+    cache_oblivious_range( const Value (&size)[N], std::size_t grainsize = 1 ) : base_type(size, grainsize) {}
+
+    cache_oblivious_range( const base_type& range ) : base_type(range) {}
+
+    cache_oblivious_range( cache_oblivious_range& r, split ) : base_type(r) {
+        std::array<dim_range_type, N> dims{{r.dim(Is)...}};
+        unsigned int longest = 0;
+        for (unsigned int d = 1; d < N; ++d) {
+            if (bisection_size(dims[d]) > bisection_size(dims[longest])) {
+                longest = d;
+            }
+        }
+        dim_range_type second = bisect_dimension(dims[longest]);
+        static_cast<base_type&>(r) = base_type(dims[Is]...);
+        dims[longest] = second;
+        static_cast<base_type&>(*this) = base_type(dims[Is]...);
+    }
+};
+
+} // namespace d1
+} // namespace detail
+
+inline namespace v1 {
+using detail::d1::traversal_order;
+using detail::d1::for_each_tile;
+using detail::d1::cache_oblivious_range;
+} // namespace v1
+} // namespace tbb
+
+#endif /* __TBB_blocked_range_traversal_H */
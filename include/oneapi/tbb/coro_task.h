@@ -0,0 +1,344 @@
+/*
+    Copyright (c) 2024 Intel Corporation
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#ifndef __TBB_coro_task_H
+#define __TBB_coro_task_H
+
+#include "detail/_config.h"
+#include "detail/_namespace_injection.h"
+
+#if !__TBB_PREVIEW_COROUTINES
+    #error Set TBB_PREVIEW_COROUTINES to include coro_task.h
+#endif
+
+#if !__TBB_CPP20_COROUTINES_PRESENT
+    #error coro_task.h requires the support of C++20 coroutines
+#endif
+
+#include "detail/_small_object_pool.h"
+#include "task_arena.h"
+#include "task_group.h"
+
+#include <coroutine>
+#include <cstring>
+#include <exception>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace tbb {
+namespace detail {
+namespace d2 {
+
+template <typename T>
+class coro_promise;
+
+//! The part of the coroutine promise that does not depend on the result type
+class coro_promise_base {
+public:
+    //! The coroutine frames are recycled by the small object pool of the allocating thread
+    static void* operator new(std::size_t frame_size) {
+        d1::small_object_pool* pool{};
+        void* frame = r1::allocate(pool, frame_size + sizeof(pool));
+        std::memcpy(static_cast<char*>(frame) + frame_size, &pool, sizeof(pool));
+        return frame;
+    }
+
+    static void operator delete(void* frame, std::size_t frame_size) {
+        d1::small_object_pool* pool{};
+        std::memcpy(&pool, static_cast<char*>(frame) + frame_size, sizeof(pool));
+        r1::deallocate(*pool, frame, frame_size + sizeof(pool));
+    }
+
+    class final_awaiter {
+    public:
+        bool await_ready() const noexcept { return false; }
+
+        template <typename Promise>
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> finished) noexcept {
+            return finished.promise().complete(finished);
+        }
+
+        void await_resume() const noexcept {}
+    };
+
+    //! The coroutine starts when it is awaited or executed by a task
+    std::suspend_always initial_suspend() const noexcept { return {}; }
+    final_awaiter final_suspend() const noexcept { return {}; }
+
+    void unhandled_exception() noexcept {
+        my_exception = std::current_exception();
+    }
+
+protected:
+    void rethrow_if_failed() {
+        if (my_exception) {
+            std::rethrow_exception(my_exception);
+        }
+    }
+
+private:
+    template <typename T>
+    friend class coro_task;
+
+    //! Returns the coroutine to continue with after the completion of this one
+    /** A coroutine run by a task group has no awaiting coroutine: its frame is destroyed and the
+        group is released, so the group is complete when its last coroutine is. **/
+    std::coroutine_handle<> complete(std::coroutine_handle<> finished) noexcept {
+        if (!my_group) {
+            __TBB_ASSERT(my_continuation, "The completed coroutine was not awaited");
+            return my_continuation;
+        }
+        // The frame including this promise is destroyed below
+        task_group* group = my_group;
+        std::exception_ptr exception = std::move(my_exception);
+        task_handle reservation = std::move(my_reservation);
+        finished.destroy();
+        if (exception) {
+            // Thrown by a task of the group, the exception cancels the group and is rethrown by its wait
+            group->run([exception] { std::rethrow_exception(exception); });
+        }
+        return std::noop_coroutine();
+    }
+
+    std::coroutine_handle<> my_continuation{};
+    std::exception_ptr my_exception{};
+    //! The group that runs the coroutine and its reference held until the coroutine is complete
+    task_group* my_group{nullptr};
+    task_handle my_reservation{};
+};
+
+//! Starts the coroutine when executed by a task; destroys the coroutine that was not started
+class coro_starter {
+public:
+    explicit coro_starter(std::coroutine_handle<> handle) noexcept : my_handle(handle) {}
+    coro_starter(coro_starter&& other) noexcept : my_handle(std::exchange(other.my_handle, nullptr)) {}
+
+    ~coro_starter() {
+        if (my_handle) {
+            my_handle.destroy();
+        }
+    }
+
+    void operator()() const {
+        std::exchange(my_handle, nullptr).resume();
+    }
+
+private:
+    mutable std::coroutine_handle<> my_handle;
+};
+
+//! The coroutine that starts lazily and either is awaited by another coroutine or is run by a task group
+/** Awaiting the coro_task starts it on the awaiting thread and resumes the awaiting coroutine on
+    the thread that completes it. task_group::run spawns the coroutine as a task that can be stolen. **/
+template <typename T = void>
+class coro_task {
+    static_assert(!std::is_reference<T>::value, "coro_task does not support reference results");
+public:
+    using promise_type = coro_promise<T>;
+
+    coro_task(coro_task&& other) noexcept : my_handle(std::exchange(other.my_handle, nullptr)) {}
+
+    coro_task& operator=(coro_task&& other) noexcept {
+        if (this != &other) {
+            if (my_handle) {
+                my_handle.destroy();
+            }
+            my_handle = std::exchange(other.my_handle, nullptr);
+        }
+        return *this;
+    }
+
+    ~coro_task() {
+        if (my_handle) {
+            my_handle.destroy();
+        }
+    }
+
+    bool await_ready() const noexcept { return false; }
+
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept {
+        __TBB_ASSERT(my_handle, "Attempt to await an empty coro_task");
+        my_handle.promise().my_continuation = awaiting;
+        return my_handle;
+    }
+
+    T await_resume() {
+        return my_handle.promise().result();
+    }
+
+private:
+    friend class coro_promise<T>;
+    friend class task_group;
+
+    explicit coro_task(std::coroutine_handle<promise_type> handle) noexcept : my_handle(handle) {}
+
+    void run_in(task_group& group) {
+        __TBB_ASSERT(my_handle, "Attempt to run an empty coro_task");
+        promise_type& promise = my_handle.promise();
+        promise.my_group = &group;
+        // The deferred task is never run: it only holds the group until the coroutine completes
+        promise.my_reservation = group.defer([] {});
+        group.run(coro_starter{std::exchange(my_handle, nullptr)});
+    }
+
+    std::coroutine_handle<promise_type> my_handle;
+};
+
+template <typename T>
+class coro_promise : public coro_promise_base {
+public:
+    coro_task<T> get_return_object() noexcept {
+        return coro_task<T>{std::coroutine_handle<coro_promise>::from_promise(*this)};
+    }
+
+    template <typename U>
+    void return_value(U&& value) {
+        my_value.emplace(std::forward<U>(value));
+    }
+
+    T result() {
+        rethrow_if_failed();
+        return std::move(*my_value);
+    }
+
+private:
+    std::optional<T> my_value{};
+};
+
+template <>
+class coro_promise<void> : public coro_promise_base {
+public:
+    coro_task<void> get_return_object() noexcept {
+        return coro_task<void>{std::coroutine_handle<coro_promise>::from_promise(*this)};
+    }
+
+    void return_void() const noexcept {}
+
+    void result() {
+        rethrow_if_failed();
+    }
+};
+
+//! Resumes the awaiting coroutine on a thread of the arena
+class arena_awaiter {
+public:
+    explicit arena_awaiter(d1::task_arena& arena) : my_arena(arena) {}
+
+    bool await_ready() const noexcept { return false; }
+
+    void await_suspend(std::coroutine_handle<> awaiting) {
+        my_arena.enqueue([awaiting] { awaiting.resume(); });
+    }
+
+    void await_resume() const noexcept {}
+
+private:
+    d1::task_arena& my_arena;
+};
+
+//! Resumes the awaiting coroutine when the work of a task group or a flow graph is complete
+/** No thread waits for the work: the thread that completes it enqueues the resumption of the
+    coroutine into its arena. The wait after the resumption returns at once and reports the status
+    or the exception of the work. **/
+template <typename Wait>
+class wait_awaiter {
+    class resume_task : public d1::task {
+    public:
+        resume_task(d1::wait_context_vertex& vertex, std::coroutine_handle<> awaiting, d1::small_object_allocator& alloc)
+            : my_vertex(vertex), my_awaiting(awaiting), my_allocator(alloc) {}
+
+    private:
+        d1::task* execute(d1::execution_data& ed) override {
+            std::coroutine_handle<> awaiting = my_awaiting;
+            my_vertex.release_continuation();
+            my_allocator.delete_object(this, ed);
+            awaiting.resume();
+            return nullptr;
+        }
+
+        d1::task* cancel(d1::execution_data& ed) override {
+            return execute(ed);
+        }
+
+        d1::wait_context_vertex& my_vertex;
+        std::coroutine_handle<> my_awaiting;
+        d1::small_object_allocator my_allocator;
+    };
+
+public:
+    wait_awaiter(d1::wait_context_vertex& vertex, Wait wait) : my_vertex(vertex), my_wait(wait) {}
+
+    bool await_ready() const noexcept { return false; }
+
+    bool await_suspend(std::coroutine_handle<> awaiting) {
+        d1::small_object_allocator alloc{};
+        resume_task* resumption = alloc.new_object<resume_task>(my_vertex, awaiting, alloc);
+        if (my_vertex.set_continuation(*resumption)) {
+            return true;
+        }
+        // The work is complete already, so the coroutine continues on this thread
+        my_vertex.release_continuation();
+        alloc.delete_object(resumption);
+        return false;
+    }
+
+    task_group_status await_resume() {
+        return my_wait();
+    }
+
+private:
+    d1::wait_context_vertex& my_vertex;
+    Wait my_wait;
+};
+
+//! Provides the awaiters with the wait contexts of the task groups and the flow graphs
+struct wait_vertex_accessor {
+    static d1::wait_context_vertex& vertex(task_group_base& group) {
+        return group.m_wait_vertex;
+    }
+
+    //! The graph is not defined yet; the overload is not viable for the task groups
+    template <typename Graph>
+    static auto vertex(Graph& g) -> decltype((g.my_wait_context_vertex)) {
+        return g.my_wait_context_vertex;
+    }
+};
+
+//! Returns the awaitable that continues the coroutine on a thread of the arena
+inline arena_awaiter resume_in(d1::task_arena& arena) {
+    return arena_awaiter{arena};
+}
+
+//! Returns the awaitable that continues the coroutine after the tasks of the group complete
+/** A coroutine run by the group must not await it, because the group waits for the coroutine.
+    Only one coroutine can await the group at a time. **/
+inline auto operator co_await(task_group& group) {
+    auto wait = [&group] { return group.wait(); };
+    return wait_awaiter<decltype(wait)>{wait_vertex_accessor::vertex(group), wait};
+}
+
+} // namespace d2
+} // namespace detail
+
+inline namespace v1 {
+using detail::d2::coro_task;
+using detail::d2::resume_in;
+} // namespace v1
+
+} // namespace tbb
+
+#endif /* __TBB_coro_task_H */
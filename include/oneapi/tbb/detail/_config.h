@@ -274,6 +274,12 @@
     #define __TBB_CPP20_COMPARISONS_PRESENT 0
 #endif
 
+#if defined(__cpp_impl_coroutine)
+    #define __TBB_CPP20_COROUTINES_PRESENT (__TBB_CPP20_PRESENT && __cpp_impl_coroutine >= 201902L)
+#else
+    #define __TBB_CPP20_COROUTINES_PRESENT 0
+#endif
+
 #define __TBB_RESUMABLE_TASKS                           (!__TBB_WIN8UI_SUPPORT && !__ANDROID__ && !__QNXNTO__ && (!__linux__ || __GLIBC__))
 
 /* This macro marks incomplete code or comments describing ideas which are considered for the future.
@@ -534,4 +540,56 @@
 #define __TBB_PREVIEW_TASK_GROUP_EXTENSIONS 1
 #endif
 
+#if TBB_PREVIEW_PARALLEL_SORT_STRATEGIES
+#define __TBB_PREVIEW_PARALLEL_SORT_STRATEGIES 1
+#endif
+
+#if TBB_PREVIEW_PARALLEL_PARTIAL_SORT
+#define __TBB_PREVIEW_PARALLEL_PARTIAL_SORT 1
+#endif
+
+#if TBB_PREVIEW_PARALLEL_PREFIX_SCAN
+#define __TBB_PREVIEW_PARALLEL_PREFIX_SCAN 1
+#endif
+
+#if TBB_PREVIEW_LEARNING_PARTITIONER
+#define __TBB_PREVIEW_LEARNING_PARTITIONER 1
+#endif
+
+#if TBB_PREVIEW_SCHEDULER_STATISTICS || __TBB_BUILD
+#define __TBB_PREVIEW_SCHEDULER_STATISTICS 1
+#endif
+
+#if TBB_PREVIEW_SCHEDULER_TRACING || __TBB_BUILD
+#define __TBB_PREVIEW_SCHEDULER_TRACING 1
+#endif
+
+#if TBB_PREVIEW_WORKER_WAIT_POLICY || __TBB_BUILD
+#define __TBB_PREVIEW_WORKER_WAIT_POLICY 1
+#endif
+
+#if TBB_PREVIEW_TASK_ARENA_RESIZING || __TBB_BUILD
+#define __TBB_PREVIEW_TASK_ARENA_RESIZING 1
+#endif
+
+#if TBB_PREVIEW_TASK_ARENA_WEIGHTS || __TBB_BUILD
+#define __TBB_PREVIEW_TASK_ARENA_WEIGHTS 1
+#endif
+
+#if TBB_PREVIEW_TASK_DEADLINES || __TBB_BUILD
+#define __TBB_PREVIEW_TASK_DEADLINES 1
+#endif
+
+#if TBB_PREVIEW_COROUTINES || __TBB_BUILD
+#define __TBB_PREVIEW_COROUTINES 1
+#endif
+
+#if TBB_PREVIEW_TASK_DEPENDENCIES || __TBB_BUILD
+#define __TBB_PREVIEW_TASK_DEPENDENCIES 1
+#endif
+
+#if TBB_PREVIEW_SCRATCH_ALLOCATOR || __TBB_BUILD
+#define __TBB_PREVIEW_SCRATCH_ALLOCATOR 1
+#endif
+
 #endif // __TBB_detail__config_H
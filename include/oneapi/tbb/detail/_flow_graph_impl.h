@@ -430,6 +430,9 @@ private:
 
     template <typename T>
     friend class receiver;
+#if __TBB_PREVIEW_COROUTINES && __TBB_CPP20_COROUTINES_PRESENT
+    friend struct wait_vertex_accessor;
+#endif
 };  // class graph
 
 template<typename DerivedType>
@@ -71,6 +71,9 @@ TBB_EXPORT void __TBB_EXPORTED_FUNC suspend(suspend_callback_type suspend_callba
 TBB_EXPORT void __TBB_EXPORTED_FUNC resume(suspend_point_type* tag);
 TBB_EXPORT suspend_point_type* __TBB_EXPORTED_FUNC current_suspend_point();
 TBB_EXPORT void __TBB_EXPORTED_FUNC notify_waiters(std::uintptr_t wait_ctx_addr);
+#if __TBB_PREVIEW_COROUTINES
+TBB_EXPORT void __TBB_EXPORTED_FUNC enqueue(d1::task&, d1::task_arena_base*);
+#endif
 
 class thread_data;
 class task_dispatcher;
@@ -105,12 +108,19 @@ inline void resume(suspend_point tag) {
 
 // TODO align wait_context on cache lane
 class wait_context {
+#if __TBB_PREVIEW_COROUTINES
+    //! The reference held by the continuation of the work, see wait_context_vertex::set_continuation
+    static constexpr std::uint64_t continuation_reference = 1LLU << 62;
+    static constexpr std::uint64_t overflow_mask = ~((1LLU << 32) - 1) & ~continuation_reference;
+#else
     static constexpr std::uint64_t overflow_mask = ~((1LLU << 32) - 1);
+#endif
 
     std::uint64_t m_version_and_traits{1};
     std::atomic<std::uint64_t> m_ref_count{};
 
-    void add_reference(std::int64_t delta) {
+    //! Returns the reference count after the change
+    std::uint64_t add_reference(std::int64_t delta) {
         call_itt_task_notify(releasing, this);
         std::uint64_t r = m_ref_count.fetch_add(static_cast<std::uint64_t>(delta)) + static_cast<std::uint64_t>(delta);
 
@@ -122,6 +132,7 @@ class wait_context {
             std::uintptr_t wait_ctx_addr = std::uintptr_t(this);
             r1::notify_waiters(wait_ctx_addr);
         }
+        return r;
     }
 
     bool continue_execution() const {
@@ -173,12 +184,42 @@ public:
     }
 
     void release(std::uint32_t delta = 1) override {
+#if __TBB_PREVIEW_COROUTINES
+        // The vertex is not accessed after the release unless only the reference of the continuation
+        // remains, which keeps the vertex alive
+        if (m_wait.add_reference(-std::int64_t(delta)) == wait_context::continuation_reference) {
+            if (task* continuation = m_continuation.exchange(nullptr)) {
+                r1::enqueue(*continuation, nullptr);
+            }
+        }
+#else
         m_wait.release(delta);
+#endif
     }
 
     wait_context& get_context() {
         return m_wait;
     }
+
+#if __TBB_PREVIEW_COROUTINES
+    //! Makes the thread that completes the work enqueue the continuation into its arena
+    /** The continuation holds a reference until it calls release_continuation, so the waiters
+        are not notified before that. Only one continuation can be set at a time.
+        Returns false if the work is complete already; the continuation is not enqueued then. **/
+    bool set_continuation(task& continuation) {
+        __TBB_ASSERT(!m_continuation.load(std::memory_order_relaxed), "Only one continuation can await the work");
+        m_continuation.store(&continuation, std::memory_order_relaxed);
+        if (m_wait.add_reference(std::int64_t(wait_context::continuation_reference)) == wait_context::continuation_reference) {
+            // Another thread takes the continuation only if new work is complete in the meantime
+            return m_continuation.exchange(nullptr) == nullptr;
+        }
+        return true;
+    }
+
+    void release_continuation() {
+        m_wait.add_reference(-std::int64_t(wait_context::continuation_reference));
+    }
+#endif
 private:
     friend class d2::task_group;
     friend class d2::task_group_base;
@@ -188,6 +229,9 @@ private:
     }
 
     wait_context m_wait;
+#if __TBB_PREVIEW_COROUTINES
+    std::atomic<task*> m_continuation{nullptr};
+#endif
 };
 
 class reference_vertex : public wait_tree_vertex_interface {
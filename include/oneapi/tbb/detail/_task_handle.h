@@ -22,6 +22,8 @@
 #include "_task.h"
 #include "_small_object_pool.h"
 #include "_utils.h"
+#include <atomic>
+#include <cstdint>
 #include <memory>
 
 namespace tbb {
@@ -31,12 +33,58 @@ namespace d1 { class task_group_context; class wait_context; struct execution_da
 namespace d2 {
 
 class task_handle;
+class task_handle_task;
+
+#if __TBB_PREVIEW_TASK_DEPENDENCIES
+//! The successors of a task that do not fit into the task itself
+/** The chunk fills a block of the small object pool. **/
+struct successor_chunk {
+    static constexpr std::size_t capacity = 29;
+
+    successor_chunk(d1::small_object_allocator& alloc, successor_chunk* next_chunk)
+        : allocator(alloc), next(next_chunk) {}
+
+    d1::small_object_allocator allocator;
+    successor_chunk* next;
+    std::size_t size{0};
+    task_handle_task* successors[capacity];
+};
+#endif
 
 class task_handle_task : public d1::task {
     std::uint64_t m_version_and_traits{};
     d1::wait_tree_vertex_interface* m_wait_tree_vertex;
     d1::task_group_context& m_ctx;
     d1::small_object_allocator m_allocator;
+#if __TBB_PREVIEW_TASK_DEPENDENCIES
+    //! The number of the predecessors that are not complete, plus one until the task is submitted
+    std::atomic<std::uint32_t> m_num_dependencies{1};
+    //! Whether the handle was destroyed without submitting the task, which is never executed then
+    bool m_is_discarded{false};
+    //! Whether the task was made a successor of another task; such a task cannot be enqueued
+    bool m_has_predecessors{false};
+    task_handle_task* m_successor{nullptr};
+    successor_chunk* m_successor_chunks{nullptr};
+
+    //! Returns true if the last dependency of the task is released
+    bool release_dependency() {
+        return m_num_dependencies.fetch_sub(1, std::memory_order_acq_rel) == 1;
+    }
+
+    //! Makes the successor ready if this task was its last dependency
+    /** The first ready successor of the same context is executed next by the current thread,
+        the others are spawned. **/
+    static d1::task* release_successor(task_handle_task& successor, const d1::execution_data* ed, d1::task* bypass) {
+        if (successor.release_dependency()) {
+            if (!bypass && ed && ed->context == &successor.ctx()) {
+                return &successor;
+            }
+            d1::spawn(successor, successor.ctx());
+        }
+        return bypass;
+    }
+#endif
+
 public:
     void finalize(const d1::execution_data* ed = nullptr) {
         if (ed) {
@@ -46,6 +94,86 @@ public:
         }
     }
 
+    //! Destroys the completed task and releases its successors
+    /** Returns the task to execute next: the given one or a successor that became ready. **/
+    d1::task* complete(const d1::execution_data* ed, d1::task* bypass) {
+#if __TBB_PREVIEW_TASK_DEPENDENCIES
+        task_handle_task* successor = m_successor;
+        successor_chunk* chunks = m_successor_chunks;
+        finalize(ed);
+
+        if (successor) {
+            bypass = release_successor(*successor, ed, bypass);
+        }
+        while (chunks) {
+            for (std::size_t i = 0; i < chunks->size; ++i) {
+                bypass = release_successor(*chunks->successors[i], ed, bypass);
+            }
+            successor_chunk* next = chunks->next;
+            if (ed) {
+                chunks->allocator.delete_object(chunks, *ed);
+            } else {
+                chunks->allocator.delete_object(chunks);
+            }
+            chunks = next;
+        }
+#else
+        finalize(ed);
+#endif
+        return bypass;
+    }
+
+#if __TBB_PREVIEW_TASK_DEPENDENCIES
+    //! Adds the successor that is executed after this task completes
+    /** Neither task is submitted yet, so the successors of this task are not accessed concurrently.
+        The counter of the successor is modified concurrently by its submitted predecessors. **/
+    void add_successor(task_handle_task& successor) {
+        __TBB_ASSERT(&successor != this, "A task cannot be its own predecessor");
+        __TBB_ASSERT(successor.m_num_dependencies.load(std::memory_order_relaxed) < ~std::uint32_t(0), "Too many predecessors");
+        successor.m_num_dependencies.fetch_add(1, std::memory_order_relaxed);
+        successor.m_has_predecessors = true;
+        if (!m_successor) {
+            m_successor = &successor;
+            return;
+        }
+        if (!m_successor_chunks || m_successor_chunks->size == successor_chunk::capacity) {
+            d1::small_object_allocator alloc{};
+            m_successor_chunks = alloc.new_object<successor_chunk>(alloc, m_successor_chunks);
+        }
+        m_successor_chunks->successors[m_successor_chunks->size++] = &successor;
+    }
+#endif
+
+    //! Drops the reference of the handle; returns true if the task can be executed now
+    bool submit() {
+#if __TBB_PREVIEW_TASK_DEPENDENCIES
+        // Without pending predecessors, the counter is not modified by other threads
+        return m_num_dependencies.load(std::memory_order_acquire) == 1 || release_dependency();
+#else
+        return true;
+#endif
+    }
+
+    //! Destroys the task of a handle that was not submitted
+    /** The successors are released as soon as the task would be complete. If the task waits
+        for its predecessors, it completes without execution when they are complete.
+        The successors released here are spawned into the arena of the calling thread. **/
+    void discard() {
+#if __TBB_PREVIEW_TASK_DEPENDENCIES
+        m_is_discarded = true;
+        if (submit()) {
+            complete(nullptr, nullptr);
+        }
+#else
+        finalize();
+#endif
+    }
+
+#if __TBB_PREVIEW_TASK_DEPENDENCIES
+    bool is_discarded() const { return m_is_discarded; }
+    bool has_predecessors() const { return m_has_predecessors; }
+#endif
+
     task_handle_task(d1::wait_tree_vertex_interface* vertex, d1::task_group_context& ctx, d1::small_object_allocator& alloc)
         : m_wait_tree_vertex(vertex)
         , m_ctx(ctx)
@@ -64,7 +192,7 @@ public:
 
 class task_handle {
     struct task_handle_task_finalizer_t{
-        void operator()(task_handle_task* p){ p->finalize(); }
+        void operator()(task_handle_task* p){ p->discard(); }
     };
     using handle_impl_t = std::unique_ptr<task_handle_task, task_handle_task_finalizer_t>;
 
@@ -95,6 +223,22 @@ private:
 struct task_handle_accessor {
 static task_handle              construct(task_handle_task* t)  { return {t}; }
 static d1::task*                release(task_handle& th)        { return th.release(); }
+//! Releases the task if it can be executed now; otherwise, its last predecessor spawns it
+static d1::task*                submit(task_handle& th)         {
+    task_handle_task* t = th.m_handle.release();
+    return t && t->submit() ? t : nullptr;
+}
+#if __TBB_PREVIEW_TASK_DEPENDENCIES
+static void                     add_edge(task_handle& pred, task_handle& succ) {
+    __TBB_ASSERT(pred.m_handle && succ.m_handle, "The dependencies can be set only for the tasks that are not submitted");
+    __TBB_ASSERT(&pred.m_handle->ctx() == &succ.m_handle->ctx(), "The dependencies can be set only for the tasks of the same task_group");
+    pred.m_handle->add_successor(*succ.m_handle);
+}
+static bool                     has_predecessors(task_handle& th) {
+    __TBB_ASSERT(th.m_handle, "has_predecessors does not expect empty task_handle.");
+    return th.m_handle->has_predecessors();
+}
+#endif
 static d1::task_group_context&  ctx_of(task_handle& th)         {
     __TBB_ASSERT(th.m_handle, "ctx_of does not expect empty task_handle.");
     return th.m_handle->ctx();
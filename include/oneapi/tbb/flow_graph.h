@@ -58,6 +58,10 @@
 #include <concepts>
 #endif
 
+#if __TBB_PREVIEW_COROUTINES && __TBB_CPP20_COROUTINES_PRESENT
+#include "coro_task.h"
+#endif
+
 /** @file
   \brief The graph related classes and functions
 
@@ -3635,6 +3639,18 @@ inline void set_name(const async_node<Input, Output, Policy>& node, const char *
 {
     fgt_multioutput_node_desc(&node, name);
 }
+
+#if __TBB_PREVIEW_COROUTINES && __TBB_CPP20_COROUTINES_PRESENT
+//! Returns the awaitable that continues the coroutine after the graph completes its work
+/** Only one coroutine can await the graph at a time. **/
+inline auto operator co_await(graph& g) {
+    auto wait = [&g] {
+        g.wait_for_all();
+        return g.is_cancelled() ? canceled : complete;
+    };
+    return wait_awaiter<decltype(wait)>{wait_vertex_accessor::vertex(g), wait};
+}
+#endif
 } // d2
 } // detail
 } // tbb
@@ -57,9 +57,25 @@ public:
         thread_stack_size,
         terminate_on_exception,
         scheduler_handle, // not a public parameter
+        scheduler_tracing, // preview parameter, see scheduler_tracing.h
+        worker_wait_policy, // preview parameter, see wait_policy below
+        coroutine_stack_size, // preview parameter
         parameter_max // insert new parameters above this point
     };
 
+#if __TBB_PREVIEW_WORKER_WAIT_POLICY
+    //! Values of the worker_wait_policy parameter
+    /** If several objects set the parameter, the policy that spends less processor time is used. **/
+    enum wait_policy {
+        //! The threads block almost as soon as they run out of work
+        power_saving_wait_policy,
+        //! The default trade-off between the latency and the spent processor time
+        balanced_wait_policy,
+        //! The threads spin longer before they block
+        low_latency_wait_policy
+    };
+#endif
+
     global_control(parameter p, std::size_t value) :
         my_value(value), my_reserved(), my_param(p) {
         suppress_unused_warning(my_reserved);
@@ -301,6 +301,24 @@ void parallel_for( const Range& range, const Body& body, affinity_partitioner& p
     start_for<Range,Body,affinity_partitioner>::run(range,body,partitioner, context);
 }
 
+#if __TBB_PREVIEW_LEARNING_PARTITIONER
+//! Parallel iteration over range with learning_partitioner.
+/** @ingroup algorithms **/
+template<typename Range, typename Body>
+    __TBB_requires(tbb_range<Range> && parallel_for_body<Body, Range>)
+void parallel_for( const Range& range, const Body& body, learning_partitioner& partitioner ) {
+    start_for<Range,Body,learning_partitioner>::run(range,body,partitioner);
+}
+
+//! Parallel iteration over range with learning_partitioner and user-supplied context.
+/** @ingroup algorithms **/
+template<typename Range, typename Body>
+    __TBB_requires(tbb_range<Range> && parallel_for_body<Body, Range>)
+void parallel_for( const Range& range, const Body& body, learning_partitioner& partitioner, task_group_context& context ) {
+    start_for<Range,Body,learning_partitioner>::run(range,body,partitioner, context);
+}
+#endif
+
 //! Implementation of parallel iteration over stepped range of integers with explicit step and partitioner
 template <typename Index, typename Function, typename Partitioner>
 void parallel_for_impl(Index first, Index last, Index step, const Function& f, Partitioner& partitioner) {
@@ -376,6 +394,20 @@ template <typename Index, typename Function>
 void parallel_for(Index first, Index last, const Function& f, affinity_partitioner& partitioner) {
     parallel_for_impl(first, last, static_cast<Index>(1), f, partitioner);
 }
+#if __TBB_PREVIEW_LEARNING_PARTITIONER
+//! Parallel iteration over a range of integers with a step provided and learning partitioner
+template <typename Index, typename Function>
+    __TBB_requires(parallel_for_index<Index> && parallel_for_function<Function, Index>)
+void parallel_for(Index first, Index last, Index step, const Function& f, learning_partitioner& partitioner) {
+    parallel_for_impl(first, last, step, f, partitioner);
+}
+//! Parallel iteration over a range of integers with a default step value and learning partitioner
+template <typename Index, typename Function>
+    __TBB_requires(parallel_for_index<Index> && parallel_for_function<Function, Index>)
+void parallel_for(Index first, Index last, const Function& f, learning_partitioner& partitioner) {
+    parallel_for_impl(first, last, static_cast<Index>(1), f, partitioner);
+}
+#endif
 
 //! Implementation of parallel iteration over stepped range of integers with explicit step, task group context, and partitioner
 template <typename Index, typename Function, typename Partitioner>
@@ -452,6 +484,20 @@ template <typename Index, typename Function>
 void parallel_for(Index first, Index last, const Function& f, affinity_partitioner& partitioner, task_group_context &context) {
     parallel_for_impl(first, last, static_cast<Index>(1), f, partitioner, context);
 }
+#if __TBB_PREVIEW_LEARNING_PARTITIONER
+//! Parallel iteration over a range of integers with explicit step, task group context, and learning partitioner
+template <typename Index, typename Function>
+    __TBB_requires(parallel_for_index<Index> && parallel_for_function<Function, Index>)
+void parallel_for(Index first, Index last, Index step, const Function& f, learning_partitioner& partitioner, task_group_context &context) {
+    parallel_for_impl(first, last, step, f, partitioner, context);
+}
+//! Parallel iteration over a range of integers with a default step value, explicit task group context, and learning_partitioner
+template <typename Index, typename Function>
+    __TBB_requires(parallel_for_index<Index> && parallel_for_function<Function, Index>)
+void parallel_for(Index first, Index last, const Function& f, learning_partitioner& partitioner, task_group_context &context) {
+    parallel_for_impl(first, last, static_cast<Index>(1), f, partitioner, context);
+}
+#endif
 // @}
 
 } // namespace d1
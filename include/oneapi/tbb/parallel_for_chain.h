@@ -0,0 +1,202 @@
+/*
+    Copyright (c) 2024 Intel Corporation
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#ifndef __TBB_parallel_for_chain_H
+#define __TBB_parallel_for_chain_H
+
+#if ! TBB_PREVIEW_PARALLEL_FOR_CHAIN
+    #error Set TBB_PREVIEW_PARALLEL_FOR_CHAIN to include parallel_for_chain.h
+#endif
+
+#include "detail/_namespace_injection.h"
+#include "detail/_range_common.h"
+#include "detail/_template_helpers.h"
+#include "detail/_utils.h"
+
+#include "blocked_range.h"
+#include "cache_aligned_allocator.h"
+#include "parallel_for.h"
+#include "partitioner.h"
+#include "task_arena.h"
+#include "task_group.h" // task_group_context
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+namespace tbb {
+namespace detail {
+namespace d1 {
+
+//! Runs the phases of parallel_for_chain over a fixed set of chunks of the range.
+/** The range is split once into chunks_per_slot chunks per arena slot, and consecutive chunks
+    are owned by the same slot. In every phase, the thread occupying a slot processes the chunks
+    of this slot first and then helps with the chunks of other slots that are not taken yet,
+    starting from their end. So, as long as the threads keep their slots, each chunk is processed
+    by the same thread in all phases, and its data stays in the cache of this thread.
+    To keep the mapping when some threads start a phase later than others, the chunks of a slot
+    whose thread has not started the phase yet are taken only after a short wait.
+    Each chunk and each slot keep the number of the last phase in which it was taken, so the chunks
+    do not need to be reset between phases.
+    @ingroup algorithms */
+template <typename Range>
+class phase_chain : no_copy {
+    static constexpr std::size_t chunks_per_slot = 4;
+
+    //! The phase counters are updated by different threads, so each one takes its own cache line
+    using padded_counter = padded<std::atomic<std::size_t>>;
+
+    std::size_t my_slots;
+    std::vector<Range> my_chunks;
+    std::vector<padded_counter, cache_aligned_allocator<padded_counter>> my_phases;
+    std::vector<padded_counter, cache_aligned_allocator<padded_counter>> my_started;
+
+    static std::vector<Range> make_chunks( const Range& range, std::size_t count ) {
+        std::vector<Range> chunks;
+        chunks.reserve(count);
+        Range whole(range);
+        split_into(chunks, whole, count);
+        return chunks;
+    }
+
+    static void split_into( std::vector<Range>& chunks, Range& range, std::size_t count ) {
+        if (count > 1 && range.is_divisible()) {
+            proportional_split proportion(count / 2, count - count / 2);
+            Range right(range, get_range_split_object<Range>(proportion));
+            split_into(chunks, range, count / 2);
+            split_into(chunks, right, count - count / 2);
+        } else {
+            chunks.push_back(range);
+        }
+    }
+
+    //! The first chunk owned by the slot
+    std::size_t first_chunk( std::size_t slot ) const {
+        return (slot * my_chunks.size() + my_slots - 1) / my_slots;
+    }
+
+    template <typename Body>
+    void try_execute( std::size_t chunk, std::size_t phase, const Body& body ) {
+        std::size_t expected = phase;
+        if (my_phases[chunk].load(std::memory_order_relaxed) == phase &&
+            my_phases[chunk].compare_exchange_strong(expected, phase + 1))
+        {
+            tbb::detail::invoke(body, my_chunks[chunk], phase);
+        }
+    }
+
+    //! Executes the remaining chunks of other slots; returns true if the chunks of a slot that was not started are skipped
+    template <typename Body>
+    bool help_others( std::size_t slot, std::size_t phase, const Body& body, bool started_only ) {
+        bool skipped = false;
+        for (std::size_t k = 1; k < my_slots; ++k) {
+            const std::size_t victim = (slot + k) % my_slots;
+            if (started_only && my_started[victim].load(std::memory_order_relaxed) != phase + 1) {
+                const std::size_t last = first_chunk(victim + 1);
+                skipped = skipped || (first_chunk(victim) < last &&
+                                      my_phases[last - 1].load(std::memory_order_relaxed) == phase);
+                continue;
+            }
+            for (std::size_t chunk = first_chunk(victim + 1); chunk > first_chunk(victim); --chunk) {
+                try_execute(chunk - 1, phase, body);
+            }
+        }
+        return skipped;
+    }
+
+    template <typename Body>
+    void execute_slot( std::size_t phase, const Body& body ) {
+        const std::size_t slot = std::size_t(this_task_arena::current_thread_index()) % my_slots;
+        my_started[slot].store(phase + 1, std::memory_order_relaxed);
+        for (std::size_t chunk = first_chunk(slot); chunk < first_chunk(slot + 1); ++chunk) {
+            try_execute(chunk, phase, body);
+        }
+        if (help_others(slot, phase, body, /*started_only*/ true)) {
+            // Give the threads of the other slots a chance to take their own chunks
+            for (atomic_backoff backoff; backoff.bounded_pause();) {}
+            help_others(slot, phase, body, /*started_only*/ false);
+        }
+    }
+
+public:
+    phase_chain( const Range& range, std::size_t slots )
+        : my_slots(slots)
+        , my_chunks(make_chunks(range, slots * chunks_per_slot))
+        , my_phases(my_chunks.size())
+        , my_started(my_slots)
+    {}
+
+    template <typename Body>
+    void run( std::size_t phase_count, const Body& body, task_group_context& context ) {
+        for (std::size_t phase = 0; phase < phase_count && !context.is_group_execution_cancelled(); ++phase) {
+            // The threads of the arena get one token per slot; the end of parallel_for separates the phases
+            parallel_for(blocked_range<std::size_t>(0, my_slots), [this, phase, &body] (const blocked_range<std::size_t>&) {
+                execute_slot(phase, body);
+            }, static_partitioner(), context);
+        }
+    }
+};
+
+template <typename Range, typename Body>
+void run_parallel_for_chain( const Range& range, std::size_t phase_count, const Body& body, task_group_context& context ) {
+    if (range.empty() || phase_count == 0) {
+        return;
+    }
+    const int slots = this_task_arena::max_concurrency();
+    if (slots <= 1 || !range.is_divisible()) {
+        for (std::size_t phase = 0; phase < phase_count && !context.is_group_execution_cancelled(); ++phase) {
+            tbb::detail::invoke(body, range, phase);
+        }
+        return;
+    }
+    phase_chain<Range> chain(range, std::size_t(slots));
+    chain.run(phase_count, body, context);
+}
+
+/** \name parallel_for_chain
+    Runs phase_count dependent phases of a loop over the range. The body is called as
+    body(subrange, phase); all calls of a phase complete before the next phase starts.
+    The range is split into the same subranges in all phases, and each subrange is
+    processed by the same thread as long as the thread takes part in the phase. **/
+//@{
+
+//! Runs phase_count phases of the loop over the range
+/** @ingroup algorithms **/
+template <typename Range, typename Body>
+    __TBB_requires(tbb_range<Range>)
+void parallel_for_chain( const Range& range, std::size_t phase_count, const Body& body ) {
+    task_group_context context(PARALLEL_FOR);
+    run_parallel_for_chain(range, phase_count, body, context);
+}
+
+//! Runs phase_count phases of the loop over the range using the user-supplied context
+/** @ingroup algorithms **/
+template <typename Range, typename Body>
+    __TBB_requires(tbb_range<Range>)
+void parallel_for_chain( const Range& range, std::size_t phase_count, const Body& body, task_group_context& context ) {
+    run_parallel_for_chain(range, phase_count, body, context);
+}
+//@}
+
+} // namespace d1
+} // namespace detail
+
+inline namespace v1 {
+    using detail::d1::parallel_for_chain;
+} // namespace v1
+} // namespace tbb
+
+#endif /* __TBB_parallel_for_chain_H */
@@ -464,6 +464,16 @@ void parallel_reduce( const Range& range, Body& body, affinity_partitioner& part
     start_reduce<Range,Body,affinity_partitioner>::run( range, body, partitioner );
 }
 
+#if __TBB_PREVIEW_LEARNING_PARTITIONER
+//! Parallel iteration with reduction and learning_partitioner
+/** @ingroup algorithms **/
+template<typename Range, typename Body>
+    __TBB_requires(tbb_range<Range> && parallel_reduce_body<Body, Range>)
+void parallel_reduce( const Range& range, Body& body, learning_partitioner& partitioner ) {
+    start_reduce<Range,Body,learning_partitioner>::run( range, body, partitioner );
+}
+#endif
+
 //! Parallel iteration with reduction, default partitioner and user-supplied context.
 /** @ingroup algorithms **/
 template<typename Range, typename Body>
@@ -503,6 +513,16 @@ template<typename Range, typename Body>
 void parallel_reduce( const Range& range, Body& body, affinity_partitioner& partitioner, task_group_context& context ) {
     start_reduce<Range,Body,affinity_partitioner>::run( range, body, partitioner, context );
 }
+
+#if __TBB_PREVIEW_LEARNING_PARTITIONER
+//! Parallel iteration with reduction, learning_partitioner and user-supplied context
+/** @ingroup algorithms **/
+template<typename Range, typename Body>
+    __TBB_requires(tbb_range<Range> && parallel_reduce_body<Body, Range>)
+void parallel_reduce( const Range& range, Body& body, learning_partitioner& partitioner, task_group_context& context ) {
+    start_reduce<Range,Body,learning_partitioner>::run( range, body, partitioner, context );
+}
+#endif
 /** parallel_reduce overloads that work with anonymous function objects
     (see also \ref parallel_reduce_lambda_req "requirements on parallel_reduce anonymous function objects"). **/
 
@@ -570,6 +590,21 @@ Value parallel_reduce( const Range& range, const Value& identity, const RealBody
     return std::move(body).result();
 }
 
+#if __TBB_PREVIEW_LEARNING_PARTITIONER
+//! Parallel iteration with reduction and learning_partitioner
+/** @ingroup algorithms **/
+template<typename Range, typename Value, typename RealBody, typename Reduction>
+    __TBB_requires(tbb_range<Range> && parallel_reduce_function<RealBody, Range, Value> &&
+                   parallel_reduce_combine<Reduction, Value>)
+Value parallel_reduce( const Range& range, const Value& identity, const RealBody& real_body, const Reduction& reduction,
+                       learning_partitioner& partitioner ) {
+    lambda_reduce_body<Range,Value,RealBody,Reduction> body(identity, real_body, reduction);
+    start_reduce<Range,lambda_reduce_body<Range,Value,RealBody,Reduction>,learning_partitioner>
+                                        ::run( range, body, partitioner );
+    return std::move(body).result();
+}
+#endif
+
 //! Parallel iteration with reduction, default partitioner and user-supplied context.
 /** @ingroup algorithms **/
 template<typename Range, typename Value, typename RealBody, typename Reduction>
@@ -635,6 +670,21 @@ Value parallel_reduce( const Range& range, const Value& identity, const RealBody
     return std::move(body).result();
 }
 
+#if __TBB_PREVIEW_LEARNING_PARTITIONER
+//! Parallel iteration with reduction, learning_partitioner and user-supplied context
+/** @ingroup algorithms **/
+template<typename Range, typename Value, typename RealBody, typename Reduction>
+    __TBB_requires(tbb_range<Range> && parallel_reduce_function<RealBody, Range, Value> &&
+                   parallel_reduce_combine<Reduction, Value>)
+Value parallel_reduce( const Range& range, const Value& identity, const RealBody& real_body, const Reduction& reduction,
+                       learning_partitioner& partitioner, task_group_context& context ) {
+    lambda_reduce_body<Range,Value,RealBody,Reduction> body(identity, real_body, reduction);
+    start_reduce<Range,lambda_reduce_body<Range,Value,RealBody,Reduction>,learning_partitioner>
+                                        ::run( range, body, partitioner, context );
+    return std::move(body).result();
+}
+#endif
+
 //! Parallel iteration with deterministic reduction and default simple partitioner.
 /** @ingroup algorithms **/
 template<typename Range, typename Body>
@@ -29,6 +29,16 @@
 #include "blocked_range.h"
 #include "task_group.h"
 
+#if __TBB_PREVIEW_PARALLEL_PREFIX_SCAN
+#include "parallel_for.h"
+#include "cache_aligned_allocator.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <vector>
+#endif
+
 namespace tbb {
 namespace detail {
 namespace d1 {
@@ -616,6 +626,172 @@ Value parallel_scan( const Range& range, const Value& identity, const Scan& scan
     return body.result();
 }
 
+#if __TBB_PREVIEW_PARALLEL_PREFIX_SCAN
+struct inclusive_scan_tag {};
+struct exclusive_scan_tag {};
+
+//! Cache-blocked reduce-then-scan over random access sequences.
+/** The sequence is processed in tiles of one block per thread. For every tile the sums of the
+    blocks are computed in parallel, combined serially and then every block is scanned starting
+    from its offset. Both passes over a tile use static_partitioner, so a block is usually scanned
+    by the thread that has just reduced it and is still in its cache. Unlike parallel_scan,
+    no element is visited more than twice and the inner loops are plain sequential loops.
+    @ingroup algorithms */
+template <typename InputIterator, typename OutputIterator, typename Value, typename BinaryOperation>
+class prefix_scanner {
+    using input_type = typename std::iterator_traits<InputIterator>::value_type;
+    using offsets_type = std::vector<Value, cache_aligned_allocator<Value>>;
+
+    //! Bytes of input per block, chosen so that the input and the output of a block fit the L2 cache.
+    static constexpr std::size_t block_bytes = 64 * 1024;
+    static constexpr std::size_t min_block_size = 1024;
+
+    InputIterator my_first;
+    OutputIterator my_result;
+    const BinaryOperation& my_op;
+
+    Value reduce_block( std::size_t begin, std::size_t end ) const {
+        Value sum = my_first[begin];
+        for (std::size_t i = begin + 1; i != end; ++i) {
+            sum = my_op(sum, my_first[i]);
+        }
+        return sum;
+    }
+
+    Value scan_block( std::size_t begin, std::size_t end, Value sum, inclusive_scan_tag ) const {
+        for (std::size_t i = begin; i != end; ++i) {
+            sum = my_op(sum, my_first[i]);
+            my_result[i] = sum;
+        }
+        return sum;
+    }
+
+    Value scan_block( std::size_t begin, std::size_t end, Value sum, exclusive_scan_tag ) const {
+        for (std::size_t i = begin; i != end; ++i) {
+            // Read the element before writing the output, which may be the same element
+            Value next = my_op(sum, my_first[i]);
+            my_result[i] = sum;
+            sum = next;
+        }
+        return sum;
+    }
+
+public:
+    prefix_scanner( InputIterator first, OutputIterator result, const BinaryOperation& op )
+        : my_first(first), my_result(result), my_op(op) {}
+
+    //! Scans n elements starting from init and returns the sum of init and all elements.
+    template <typename Tag>
+    Value operator()( std::size_t n, Value init, Tag tag ) const {
+        const std::size_t block_size = std::max(min_block_size, block_bytes / sizeof(input_type));
+        const std::size_t num_threads = static_cast<std::size_t>(max_concurrency());
+        if (num_threads == 1 || n < 2 * block_size) {
+            return scan_block(0, n, init, tag);
+        }
+
+        offsets_type offsets(num_threads, init);
+        Value sum = init;
+        for (std::size_t tile_begin = 0; tile_begin < n; tile_begin += num_threads * block_size) {
+            const std::size_t tile_size = std::min(n - tile_begin, num_threads * block_size);
+            const std::size_t num_blocks = (tile_size + block_size - 1) / block_size;
+            if (num_blocks == 1) {
+                sum = scan_block(tile_begin, n, sum, tag);
+                break;
+            }
+            auto block_begin = [=] (std::size_t b) { return tile_begin + b * block_size; };
+            auto block_end = [=] (std::size_t b) { return std::min(tile_begin + (b + 1) * block_size, n); };
+
+            // The sum of the last block is not needed to compute the offsets
+            parallel_for(blocked_range<std::size_t>(0, num_blocks), [&] (const blocked_range<std::size_t>& r) {
+                for (std::size_t b = r.begin(); b != r.end(); ++b) {
+                    if (b + 1 != num_blocks) {
+                        offsets[b + 1] = reduce_block(block_begin(b), block_end(b));
+                    }
+                }
+            }, static_partitioner());
+
+            offsets[0] = sum;
+            for (std::size_t b = 1; b != num_blocks; ++b) {
+                offsets[b] = my_op(offsets[b - 1], offsets[b]);
+            }
+
+            parallel_for(blocked_range<std::size_t>(0, num_blocks), [&] (const blocked_range<std::size_t>& r) {
+                for (std::size_t b = r.begin(); b != r.end(); ++b) {
+                    Value block_sum = scan_block(block_begin(b), block_end(b), offsets[b], tag);
+                    if (b + 1 == num_blocks) {
+                        sum = block_sum;
+                    }
+                }
+            }, static_partitioner());
+        }
+        return sum;
+    }
+};
+
+/** \name parallel_inclusive_scan, parallel_exclusive_scan
+    The binary operation must be associative; it is not required to be commutative.
+    The output sequence may be the same as the input one. **/
+//@{
+
+//! Writes the inclusive prefix sums of [first,last) started from init to the sequence beginning at result
+/** @ingroup algorithms **/
+template <typename InputIterator, typename OutputIterator, typename BinaryOperation, typename Value>
+    __TBB_requires(std::random_access_iterator<InputIterator> && std::random_access_iterator<OutputIterator>)
+OutputIterator parallel_inclusive_scan( InputIterator first, InputIterator last, OutputIterator result,
+                                        const BinaryOperation& op, Value init ) {
+    if (first < last) {
+        prefix_scanner<InputIterator, OutputIterator, Value, BinaryOperation> scanner(first, result, op);
+        scanner(std::size_t(last - first), init, inclusive_scan_tag());
+    }
+    return result + (last - first);
+}
+
+//! Writes the inclusive prefix sums of [first,last) computed by op to the sequence beginning at result
+/** @ingroup algorithms **/
+template <typename InputIterator, typename OutputIterator, typename BinaryOperation>
+    __TBB_requires(std::random_access_iterator<InputIterator> && std::random_access_iterator<OutputIterator>)
+OutputIterator parallel_inclusive_scan( InputIterator first, InputIterator last, OutputIterator result,
+                                        const BinaryOperation& op ) {
+    using value_type = typename std::iterator_traits<InputIterator>::value_type;
+    if (first < last) {
+        value_type init = *first;
+        *result = init;
+        return parallel_inclusive_scan(first + 1, last, result + 1, op, init);
+    }
+    return result;
+}
+
+//! Writes the inclusive prefix sums of [first,last) to the sequence beginning at result
+/** @ingroup algorithms **/
+template <typename InputIterator, typename OutputIterator>
+    __TBB_requires(std::random_access_iterator<InputIterator> && std::random_access_iterator<OutputIterator>)
+OutputIterator parallel_inclusive_scan( InputIterator first, InputIterator last, OutputIterator result ) {
+    return parallel_inclusive_scan(first, last, result, std::plus<typename std::iterator_traits<InputIterator>::value_type>());
+}
+
+//! Writes the exclusive prefix sums of [first,last) started from init and computed by op to the sequence beginning at result
+/** @ingroup algorithms **/
+template <typename InputIterator, typename OutputIterator, typename Value, typename BinaryOperation>
+    __TBB_requires(std::random_access_iterator<InputIterator> && std::random_access_iterator<OutputIterator>)
+OutputIterator parallel_exclusive_scan( InputIterator first, InputIterator last, OutputIterator result,
+                                        Value init, const BinaryOperation& op ) {
+    if (first < last) {
+        prefix_scanner<InputIterator, OutputIterator, Value, BinaryOperation> scanner(first, result, op);
+        scanner(std::size_t(last - first), init, exclusive_scan_tag());
+    }
+    return result + (last - first);
+}
+
+//! Writes the exclusive prefix sums of [first,last) started from init to the sequence beginning at result
+/** @ingroup algorithms **/
+template <typename InputIterator, typename OutputIterator, typename Value>
+    __TBB_requires(std::random_access_iterator<InputIterator> && std::random_access_iterator<OutputIterator>)
+OutputIterator parallel_exclusive_scan( InputIterator first, InputIterator last, OutputIterator result, Value init ) {
+    return parallel_exclusive_scan(first, last, result, init, std::plus<Value>());
+}
+//@}
+#endif // __TBB_PREVIEW_PARALLEL_PREFIX_SCAN
+
 } // namespace d1
 } // namespace detail
 
@@ -623,6 +799,10 @@ inline namespace v1 {
     using detail::d1::parallel_scan;
     using detail::d1::pre_scan_tag;
     using detail::d1::final_scan_tag;
+#if __TBB_PREVIEW_PARALLEL_PREFIX_SCAN
+    using detail::d1::parallel_inclusive_scan;
+    using detail::d1::parallel_exclusive_scan;
+#endif
 } // namespace v1
 
 } // namespace tbb
@@ -1,5 +1,5 @@
 /*
-    Copyright (c) 2005-2021 Intel Corporation
+    Copyright (c) 2005-2024 Intel Corporation
 
     Licensed under the Apache License, Version 2.0 (the "License");
     you may not use this file except in compliance with the License.
@@ -18,14 +18,23 @@
 #define __TBB_parallel_sort_H
 
 #include "detail/_namespace_injection.h"
+#include "detail/_template_helpers.h"
 #include "parallel_for.h"
 #include "blocked_range.h"
+#include "cache_aligned_allocator.h"
 #include "profiling.h"
 
 #include <algorithm>
 #include <iterator>
 #include <functional>
 #include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <vector>
 
 namespace tbb {
 namespace detail {
@@ -180,10 +189,534 @@ void do_parallel_quick_sort( RandomAccessIterator begin, RandomAccessIterator en
                  auto_partitioner());
 }
 
-//! Wrapper method to initiate the sort by calling parallel_for.
+#if __TBB_PREVIEW_PARALLEL_PARTIAL_SORT
+//! Range that splits like quick_sort_range but only while it overlaps the target subsequence.
+/** Every split partitions the elements around the pivot, so a subrange that does not overlap
+    [target_begin, target_end) already holds exactly the elements that belong there and is
+    neither split nor processed further.
+    @ingroup algorithms */
+template<typename RandomAccessIterator, typename Compare>
+class quick_select_range : public quick_sort_range<RandomAccessIterator, Compare> {
+    using base_type = quick_sort_range<RandomAccessIterator, Compare>;
+public:
+    RandomAccessIterator target_begin;
+    RandomAccessIterator target_end;
+
+    quick_select_range( RandomAccessIterator begin_, std::size_t size_, const Compare& comp_,
+                        RandomAccessIterator target_begin_, RandomAccessIterator target_end_ )
+        : base_type(begin_, size_, comp_), target_begin(target_begin_), target_end(target_end_) {}
+
+    quick_select_range( quick_select_range& range, split )
+        : base_type(range, split())
+        , target_begin(range.target_begin)
+        , target_end(range.target_end) {}
+
+    bool overlaps_target() const {
+        return this->begin < target_end && target_begin < this->begin + this->size;
+    }
+
+    bool is_divisible() const { return overlaps_target() && base_type::is_divisible(); }
+};
+
+//! Body class used to place the nth element into the range that contains it.
+/** @ingroup algorithms */
+template<typename RandomAccessIterator, typename Compare>
+struct quick_select_body {
+    void operator()( const quick_select_range<RandomAccessIterator,Compare>& range ) const {
+        if( range.overlaps_target() ) {
+            std::nth_element(range.begin, range.target_begin, range.begin + range.size, range.comp);
+        }
+    }
+};
+
+//! Body class used to sort the part of a range that lies in the target prefix.
 /** @ingroup algorithms */
 template<typename RandomAccessIterator, typename Compare>
-void parallel_quick_sort( RandomAccessIterator begin, RandomAccessIterator end, const Compare& comp ) {
+struct quick_partial_sort_body {
+    void operator()( const quick_select_range<RandomAccessIterator,Compare>& range ) const {
+        if( range.overlaps_target() ) {
+            RandomAccessIterator end = range.begin + range.size;
+            if( range.target_end < end ) {
+                std::partial_sort(range.begin, range.target_end, end, range.comp);
+            } else {
+                std::sort(range.begin, end, range.comp);
+            }
+        }
+    }
+};
+
+//! Method to perform parallel_for based quick select.
+/** Only the subranges containing nth are partitioned further, so the expected work is linear.
+    @ingroup algorithms */
+template<typename RandomAccessIterator, typename Compare>
+void do_parallel_nth_element( RandomAccessIterator begin, RandomAccessIterator nth, RandomAccessIterator end,
+                              const Compare& comp ) {
+    parallel_for(quick_select_range<RandomAccessIterator,Compare>(begin, end - begin, comp, nth, nth + 1),
+                 quick_select_body<RandomAccessIterator,Compare>(),
+                 auto_partitioner());
+}
+
+//! Method to perform parallel_for based partial sort.
+/** Subranges beyond middle are left unsorted, subranges before it are sorted in parallel.
+    @ingroup algorithms */
+template<typename RandomAccessIterator, typename Compare>
+void do_parallel_partial_sort( RandomAccessIterator begin, RandomAccessIterator middle, RandomAccessIterator end,
+                               const Compare& comp ) {
+    parallel_for(quick_select_range<RandomAccessIterator,Compare>(begin, end - begin, comp, begin, middle),
+                 quick_partial_sort_body<RandomAccessIterator,Compare>(),
+                 auto_partitioner());
+}
+#endif // __TBB_PREVIEW_PARALLEL_PARTIAL_SORT
+
+//! Tag types that select the algorithm used by parallel_sort.
+/** quick_sort_tag forces the in-place parallel quicksort, radix_sort_tag and sample_sort_tag
+    request the corresponding out-of-place algorithms. Without a tag the algorithm is selected
+    automatically based on the value type, the comparator and the size of the sequence.
+    @ingroup algorithms */
+struct quick_sort_tag {};
+struct radix_sort_tag {};
+struct sample_sort_tag {};
+struct auto_sort_tag {};
+
+template <typename Strategy>
+struct is_sort_strategy : std::integral_constant<bool,
+    std::is_same<Strategy, quick_sort_tag>::value || std::is_same<Strategy, radix_sort_tag>::value ||
+    std::is_same<Strategy, sample_sort_tag>::value> {};
+
+//! Uninitialized storage used as the scratch space by the out-of-place sorting algorithms.
+template <typename T>
+class sort_buffer : no_copy {
+    T* my_begin{nullptr};
+    std::size_t my_size{0};
+public:
+    explicit sort_buffer( std::size_t size ) : my_begin(cache_aligned_allocator<T>().allocate(size)), my_size(size) {}
+
+    //! Leaves the buffer empty instead of throwing if the memory cannot be allocated.
+    sort_buffer( std::size_t size, const std::nothrow_t& ) {
+#if TBB_USE_EXCEPTIONS
+        try {
+            my_begin = cache_aligned_allocator<T>().allocate(size);
+            my_size = size;
+        } catch (const std::bad_alloc&) {
+            my_begin = nullptr;
+        }
+#else
+        my_begin = cache_aligned_allocator<T>().allocate(size);
+        my_size = size;
+#endif
+    }
+
+    ~sort_buffer() {
+        if (my_begin) {
+            cache_aligned_allocator<T>().deallocate(my_begin, my_size);
+        }
+    }
+
+    T* get() const { return my_begin; }
+};
+
+//! Splits [0, size) into blocks processed by the distribution passes of radix and sample sorts.
+class sort_blocks {
+    std::size_t my_size;
+    std::size_t my_block_size;
+    std::size_t my_num_blocks;
+public:
+    sort_blocks( std::size_t size, std::size_t min_block_size ) : my_size(size) {
+        std::size_t max_blocks = get_initial_auto_partitioner_divisor();
+        my_num_blocks = (size + min_block_size - 1) / min_block_size;
+        my_num_blocks = my_num_blocks < max_blocks ? my_num_blocks : max_blocks;
+        my_num_blocks = my_num_blocks ? my_num_blocks : 1;
+        my_block_size = (size + my_num_blocks - 1) / my_num_blocks;
+        my_num_blocks = (size + my_block_size - 1) / my_block_size;
+    }
+
+    std::size_t size() const { return my_num_blocks; }
+    std::size_t begin( std::size_t block ) const { return block * my_block_size; }
+    std::size_t end( std::size_t block ) const {
+        return (block + 1) * my_block_size < my_size ? (block + 1) * my_block_size : my_size;
+    }
+};
+
+//! Turns per-block bucket histograms into per-block output positions.
+/** Histograms are stored block-major in counts; on return counts[block * num_buckets + bucket] is the
+    position where the block writes its first element of the bucket, and bucket_begin[b] is the first
+    position of bucket b (bucket_begin[num_buckets] is the total size). **/
+inline void sort_blocks_exclusive_scan( std::size_t* counts, std::size_t num_blocks, std::size_t num_buckets,
+                                        std::size_t* bucket_begin ) {
+    std::size_t sum = 0;
+    for (std::size_t bucket = 0; bucket < num_buckets; ++bucket) {
+        bucket_begin[bucket] = sum;
+        for (std::size_t block = 0; block < num_blocks; ++block) {
+            std::size_t count = counts[block * num_buckets + bucket];
+            counts[block * num_buckets + bucket] = sum;
+            sum += count;
+        }
+    }
+    bucket_begin[num_buckets] = sum;
+}
+
+template <std::size_t Size> struct radix_unsigned;
+template <> struct radix_unsigned<1> { using type = std::uint8_t; };
+template <> struct radix_unsigned<2> { using type = std::uint16_t; };
+template <> struct radix_unsigned<4> { using type = std::uint32_t; };
+template <> struct radix_unsigned<8> { using type = std::uint64_t; };
+
+//! Arithmetic types whose order under operator< is the order of their radix keys.
+template <typename T>
+struct is_radix_sortable_value : std::integral_constant<bool,
+    !std::is_same<typename std::remove_cv<T>::type, bool>::value &&
+    ((std::is_integral<T>::value && sizeof(T) <= 8) ||
+     (std::is_floating_point<T>::value && std::numeric_limits<T>::is_iec559 && (sizeof(T) == 4 || sizeof(T) == 8)))> {};
+
+//! Sort direction implied by the comparator: 1 for ascending, -1 for descending, 0 if unknown.
+template <typename Compare, typename T> struct radix_sort_order : std::integral_constant<int, 0> {};
+template <typename T> struct radix_sort_order<std::less<T>, T> : std::integral_constant<int, 1> {};
+template <typename T> struct radix_sort_order<std::greater<T>, T> : std::integral_constant<int, -1> {};
+#if __cpp_lib_transparent_operators
+template <typename T> struct radix_sort_order<std::less<void>, T> : std::integral_constant<int, 1> {};
+template <typename T> struct radix_sort_order<std::greater<void>, T> : std::integral_constant<int, -1> {};
+#endif
+
+template <typename Iterator>
+struct is_contiguous_sort_iterator : std::integral_constant<bool,
+    std::is_pointer<Iterator>::value ||
+    std::is_same<Iterator, typename std::vector<typename std::iterator_traits<Iterator>::value_type>::iterator>::value
+#if __TBB_CPP20_PRESENT && __cpp_lib_concepts
+    || std::contiguous_iterator<Iterator>
+#endif
+    > {};
+
+template <typename Iterator, typename Compare>
+struct is_radix_sortable : std::integral_constant<bool,
+    is_radix_sortable_value<typename std::iterator_traits<Iterator>::value_type>::value &&
+    radix_sort_order<Compare, typename std::iterator_traits<Iterator>::value_type>::value != 0 &&
+    is_contiguous_sort_iterator<Iterator>::value> {};
+
+template <typename Iterator>
+struct is_sample_sortable : std::integral_constant<bool,
+    std::is_same<typename std::iterator_traits<Iterator>::reference,
+                 typename std::iterator_traits<Iterator>::value_type&>::value &&
+    std::is_nothrow_move_constructible<typename std::iterator_traits<Iterator>::value_type>::value &&
+    std::is_nothrow_move_assignable<typename std::iterator_traits<Iterator>::value_type>::value> {};
+
+//! Maps arithmetic values to unsigned keys that compare in the same order as the values.
+template <typename T, bool Descending>
+struct radix_key_traits {
+    using key_type = typename radix_unsigned<sizeof(T)>::type;
+    static constexpr int num_digits = sizeof(T);
+    static constexpr int digit_bits = 8;
+    static constexpr std::size_t num_buckets = std::size_t(1) << digit_bits;
+
+    static key_type sign_bit() { return key_type(key_type(1) << (sizeof(T) * 8 - 1)); }
+
+    static key_type to_unsigned( T value, /*is_floating_point*/ std::false_type ) {
+        key_type key = static_cast<key_type>(value);
+        return std::is_signed<T>::value ? key_type(key ^ sign_bit()) : key;
+    }
+
+    static key_type to_unsigned( T value, /*is_floating_point*/ std::true_type ) {
+        key_type key;
+        std::memcpy(&key, &value, sizeof(T));
+        // Negative values are ordered in reverse, so flip all bits for them
+        return (key & sign_bit()) ? key_type(~key) : key_type(key | sign_bit());
+    }
+
+    static key_type key( T value ) {
+        key_type k = to_unsigned(value, std::is_floating_point<T>());
+        return Descending ? key_type(~k) : k;
+    }
+
+    static std::size_t digit( key_type k, int d ) {
+        return std::size_t(k >> (d * digit_bits)) & (num_buckets - 1);
+    }
+};
+
+//! Most significant digit radix sort with the parallel distribution of large buckets.
+/** Buckets smaller than parallel_cutoff are finished by a serial least significant digit pass
+    and buckets smaller than serial_cutoff by the comparison sort. **/
+template <typename T, typename Compare>
+class radix_sorter {
+    using traits = radix_key_traits<T, (radix_sort_order<Compare, T>::value < 0)>;
+    static constexpr std::size_t num_buckets = traits::num_buckets;
+    static constexpr std::size_t serial_cutoff = 256;
+    static constexpr std::size_t parallel_cutoff = std::size_t(1) << 16;
+    static constexpr std::size_t min_block_size = std::size_t(1) << 14;
+
+    const Compare& my_comp;
+
+    void serial_lsd_sort( T* data, T* scratch, std::size_t n, int digit, bool to_scratch ) const {
+        std::size_t counts[traits::num_digits][num_buckets] = {};
+        for (std::size_t i = 0; i < n; ++i) {
+            typename traits::key_type k = traits::key(data[i]);
+            for (int d = 0; d <= digit; ++d) {
+                ++counts[d][traits::digit(k, d)];
+            }
+        }
+
+        T* src = data;
+        T* dst = scratch;
+        for (int d = 0; d <= digit; ++d) {
+            std::size_t* pos = counts[d];
+            // Skip the digit if all elements share it
+            if (pos[traits::digit(traits::key(src[0]), d)] == n) continue;
+
+            std::size_t sum = 0;
+            for (std::size_t b = 0; b < num_buckets; ++b) {
+                std::size_t count = pos[b];
+                pos[b] = sum;
+                sum += count;
+            }
+            for (std::size_t i = 0; i < n; ++i) {
+                dst[pos[traits::digit(traits::key(src[i]), d)]++] = src[i];
+            }
+            std::swap(src, dst);
+        }
+
+        T* result = to_scratch ? scratch : data;
+        if (src != result) {
+            std::copy(src, src + n, result);
+        }
+    }
+
+    void parallel_msd_sort( T* data, T* scratch, std::size_t n, int digit, bool to_scratch ) const {
+        sort_blocks blocks(n, min_block_size);
+        std::vector<std::size_t> counts(blocks.size() * num_buckets);
+        std::size_t bucket_begin[num_buckets + 1];
+
+        parallel_for(blocked_range<std::size_t>(0, blocks.size(), 1), [&] (const blocked_range<std::size_t>& r) {
+            for (std::size_t b = r.begin(); b != r.end(); ++b) {
+                std::size_t* hist = counts.data() + b * num_buckets;
+                for (std::size_t i = blocks.begin(b); i != blocks.end(b); ++i) {
+                    ++hist[traits::digit(traits::key(data[i]), digit)];
+                }
+            }
+        });
+        sort_blocks_exclusive_scan(counts.data(), blocks.size(), num_buckets, bucket_begin);
+
+        if (bucket_begin[traits::digit(traits::key(data[0]), digit) + 1] -
+            bucket_begin[traits::digit(traits::key(data[0]), digit)] == n) {
+            // All elements share the digit, go to the next one without moving them
+            sort(data, scratch, n, digit - 1, to_scratch);
+            return;
+        }
+
+        parallel_for(blocked_range<std::size_t>(0, blocks.size(), 1), [&] (const blocked_range<std::size_t>& r) {
+            for (std::size_t b = r.begin(); b != r.end(); ++b) {
+                std::size_t* pos = counts.data() + b * num_buckets;
+                for (std::size_t i = blocks.begin(b); i != blocks.end(b); ++i) {
+                    scratch[pos[traits::digit(traits::key(data[i]), digit)]++] = data[i];
+                }
+            }
+        });
+
+        // The elements are in scratch now, so the buckets are sorted into the opposite buffer
+        parallel_for(blocked_range<std::size_t>(0, num_buckets, 1), [&] (const blocked_range<std::size_t>& r) {
+            for (std::size_t b = r.begin(); b != r.end(); ++b) {
+                sort(scratch + bucket_begin[b], data + bucket_begin[b], bucket_begin[b + 1] - bucket_begin[b],
+                     digit - 1, !to_scratch);
+            }
+        });
+    }
+
+public:
+    radix_sorter( const Compare& comp ) : my_comp(comp) {}
+
+    //! Sorts [data, data + n) by the digits [0, digit].
+    /** The result is placed into scratch if to_scratch is set and into data otherwise. **/
+    void sort( T* data, T* scratch, std::size_t n, int digit, bool to_scratch ) const {
+        if (digit < 0 || n <= serial_cutoff) {
+            if (digit >= 0) {
+                std::sort(data, data + n, my_comp);
+            }
+            if (to_scratch) {
+                std::copy(data, data + n, scratch);
+            }
+        } else if (n < parallel_cutoff) {
+            serial_lsd_sort(data, scratch, n, digit, to_scratch);
+        } else {
+            parallel_msd_sort(data, scratch, n, digit, to_scratch);
+        }
+    }
+};
+
+//! Method to perform the radix sort of arithmetic values stored contiguously.
+/** @ingroup algorithms */
+template<typename RandomAccessIterator, typename Compare>
+void do_parallel_radix_sort( RandomAccessIterator begin, RandomAccessIterator end, const Compare& comp,
+                             const sort_buffer<typename std::iterator_traits<RandomAccessIterator>::value_type>& buffer ) {
+    using value_type = typename std::iterator_traits<RandomAccessIterator>::value_type;
+    radix_sorter<value_type, Compare>(comp).sort(std::addressof(*begin), buffer.get(), std::size_t(end - begin),
+                                                 radix_key_traits<value_type, false>::num_digits - 1,
+                                                 /*to_scratch*/ false);
+}
+
+//! Method to perform the sample sort.
+/** The elements are classified into buckets between splitters picked from a random sample,
+    moved into the buffer bucket by bucket, sorted there and moved back.
+    @ingroup algorithms */
+template<typename RandomAccessIterator, typename Compare>
+void do_parallel_sample_sort( RandomAccessIterator begin, RandomAccessIterator end, const Compare& comp,
+                              const sort_buffer<typename std::iterator_traits<RandomAccessIterator>::value_type>& buffer ) {
+    using value_type = typename std::iterator_traits<RandomAccessIterator>::value_type;
+    constexpr std::size_t max_buckets = 256;
+    constexpr std::size_t min_bucket_size = 1024;
+    constexpr std::size_t oversampling = 16;
+    constexpr std::size_t min_block_size = std::size_t(1) << 14;
+    constexpr std::size_t min_parallel_bucket_size = 500;
+
+    const std::size_t n = std::size_t(end - begin);
+    std::size_t num_buckets = n / min_bucket_size;
+    num_buckets = num_buckets < 2 ? 2 : (num_buckets > max_buckets ? max_buckets : num_buckets);
+
+    // Pick the splitters from a stratified pseudo-random sample
+    const std::size_t num_samples = num_buckets * oversampling;
+    const std::size_t stride = n / num_samples;
+    __TBB_ASSERT(stride > 0, "Too small sequence for the sample sort");
+    std::vector<RandomAccessIterator> samples(num_samples);
+    std::uint64_t state = n;
+    for (std::size_t i = 0; i < num_samples; ++i) {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        samples[i] = begin + (i * stride + std::size_t(state >> 33) % stride);
+    }
+    auto iterator_comp = [&comp] (const RandomAccessIterator& lhs, const RandomAccessIterator& rhs) {
+        return comp(*lhs, *rhs);
+    };
+    std::sort(samples.begin(), samples.end(), iterator_comp);
+    std::vector<RandomAccessIterator> splitters(num_buckets - 1);
+    for (std::size_t i = 0; i + 1 < num_buckets; ++i) {
+        splitters[i] = samples[(i + 1) * oversampling];
+    }
+
+    // Classify the elements, nothing is moved yet so the comparator may safely throw
+    sort_blocks blocks(n, min_block_size);
+    std::vector<std::size_t> counts(blocks.size() * num_buckets);
+    std::vector<std::size_t> bucket_begin(num_buckets + 1);
+    std::vector<unsigned char> bucket_of(n);
+    parallel_for(blocked_range<std::size_t>(0, blocks.size(), 1), [&] (const blocked_range<std::size_t>& r) {
+        for (std::size_t b = r.begin(); b != r.end(); ++b) {
+            std::size_t* hist = counts.data() + b * num_buckets;
+            for (std::size_t i = blocks.begin(b); i != blocks.end(b); ++i) {
+                std::size_t bucket = std::upper_bound(splitters.begin(), splitters.end(), begin + i, iterator_comp) - splitters.begin();
+                bucket_of[i] = static_cast<unsigned char>(bucket);
+                ++hist[bucket];
+            }
+        }
+    });
+    sort_blocks_exclusive_scan(counts.data(), blocks.size(), num_buckets, bucket_begin.data());
+
+    value_type* scratch = buffer.get();
+    parallel_for(blocked_range<std::size_t>(0, blocks.size(), 1), [&] (const blocked_range<std::size_t>& r) {
+        for (std::size_t b = r.begin(); b != r.end(); ++b) {
+            std::size_t* pos = counts.data() + b * num_buckets;
+            for (std::size_t i = blocks.begin(b); i != blocks.end(b); ++i) {
+                new (scratch + pos[bucket_of[i]]++) value_type(std::move(begin[i]));
+            }
+        }
+    });
+
+    auto move_back = [begin, scratch] (std::size_t first, std::size_t last) {
+        for (std::size_t i = first; i != last; ++i) {
+            begin[i] = std::move(scratch[i]);
+            scratch[i].~value_type();
+        }
+    };
+    // Return the elements to the sequence even if the comparator throws
+    try_call([&] {
+        parallel_for(blocked_range<std::size_t>(0, num_buckets, 1), [&] (const blocked_range<std::size_t>& r) {
+            for (std::size_t b = r.begin(); b != r.end(); ++b) {
+                value_type* first = scratch + bucket_begin[b];
+                value_type* last = scratch + bucket_begin[b + 1];
+                if (std::size_t(last - first) < min_parallel_bucket_size) {
+                    std::sort(first, last, comp);
+                } else {
+                    // Buckets of equal keys may be large, so sort them in parallel
+                    do_parallel_quick_sort(first, last, comp);
+                }
+            }
+        });
+    }).on_exception([&] {
+        move_back(0, n);
+    });
+    parallel_for(blocked_range<std::size_t>(0, n, min_block_size), [&] (const blocked_range<std::size_t>& r) {
+        move_back(r.begin(), r.end());
+    });
+}
+
+//! Sizes starting from which parallel_sort selects radix and sample sorts if not told otherwise.
+constexpr std::size_t radix_sort_min_size = std::size_t(1) << 16;
+constexpr std::size_t sample_sort_min_size = std::size_t(1) << 18;
+
+template<typename RandomAccessIterator, typename Compare>
+bool try_parallel_radix_sort( RandomAccessIterator, RandomAccessIterator, const Compare&, /*is_radix_sortable*/ std::false_type ) {
+    return false;
+}
+
+template<typename RandomAccessIterator, typename Compare>
+bool try_parallel_radix_sort( RandomAccessIterator begin, RandomAccessIterator end, const Compare& comp, /*is_radix_sortable*/ std::true_type ) {
+    sort_buffer<typename std::iterator_traits<RandomAccessIterator>::value_type> buffer(std::size_t(end - begin), std::nothrow);
+    if (!buffer.get()) {
+        return false;
+    }
+    do_parallel_radix_sort(begin, end, comp, buffer);
+    return true;
+}
+
+template<typename RandomAccessIterator, typename Compare>
+bool try_parallel_sample_sort( RandomAccessIterator, RandomAccessIterator, const Compare&, /*is_sample_sortable*/ std::false_type ) {
+    return false;
+}
+
+template<typename RandomAccessIterator, typename Compare>
+bool try_parallel_sample_sort( RandomAccessIterator begin, RandomAccessIterator end, const Compare& comp, /*is_sample_sortable*/ std::true_type ) {
+    sort_buffer<typename std::iterator_traits<RandomAccessIterator>::value_type> buffer(std::size_t(end - begin), std::nothrow);
+    if (!buffer.get()) {
+        return false;
+    }
+    do_parallel_sample_sort(begin, end, comp, buffer);
+    return true;
+}
+
+template<typename RandomAccessIterator, typename Compare>
+void do_parallel_sort( RandomAccessIterator begin, RandomAccessIterator end, const Compare& comp, quick_sort_tag ) {
+    do_parallel_quick_sort(begin, end, comp);
+}
+
+template<typename RandomAccessIterator, typename Compare>
+void do_parallel_sort( RandomAccessIterator begin, RandomAccessIterator end, const Compare& comp, radix_sort_tag ) {
+    static_assert(is_radix_sortable<RandomAccessIterator, Compare>::value,
+        "radix_sort_tag requires contiguously stored arithmetic values compared with std::less or std::greater");
+    sort_buffer<typename std::iterator_traits<RandomAccessIterator>::value_type> buffer(std::size_t(end - begin));
+    do_parallel_radix_sort(begin, end, comp, buffer);
+}
+
+template<typename RandomAccessIterator, typename Compare>
+void do_parallel_sort( RandomAccessIterator begin, RandomAccessIterator end, const Compare& comp, sample_sort_tag ) {
+    static_assert(is_sample_sortable<RandomAccessIterator>::value,
+        "sample_sort_tag requires values with non-throwing move construction and assignment");
+    sort_buffer<typename std::iterator_traits<RandomAccessIterator>::value_type> buffer(std::size_t(end - begin));
+    do_parallel_sample_sort(begin, end, comp, buffer);
+}
+
+//! Selects the algorithm: radix sort for arithmetic keys, sample sort for large sequences
+//! if more than one thread is available, and quicksort otherwise or if the buffer cannot be allocated.
+template<typename RandomAccessIterator, typename Compare>
+void do_parallel_sort( RandomAccessIterator begin, RandomAccessIterator end, const Compare& comp, auto_sort_tag ) {
+    std::size_t size = std::size_t(end - begin);
+    if (size >= radix_sort_min_size &&
+        try_parallel_radix_sort(begin, end, comp, is_radix_sortable<RandomAccessIterator, Compare>())) {
+        return;
+    }
+    if (size >= sample_sort_min_size && max_concurrency() > 1 &&
+        try_parallel_sample_sort(begin, end, comp, is_sample_sortable<RandomAccessIterator>())) {
+        return;
+    }
+    do_parallel_quick_sort(begin, end, comp);
+}
+
+//! Wrapper method to initiate the sort after checking if the input is already sorted.
+/** @ingroup algorithms */
+template<typename RandomAccessIterator, typename Compare, typename Strategy>
+void parallel_sort_impl( RandomAccessIterator begin, RandomAccessIterator end, const Compare& comp, Strategy strategy ) {
     task_group_context my_context(PARALLEL_SORT);
     constexpr int serial_cutoff = 9;
 
@@ -191,7 +724,7 @@ void parallel_quick_sort( RandomAccessIterator begin, RandomAccessIterator end,
     RandomAccessIterator k = begin;
     for( ; k != begin + serial_cutoff; ++k ) {
         if( comp(*(k + 1), *k) ) {
-            do_parallel_quick_sort(begin, end, comp);
+            do_parallel_sort(begin, end, comp, strategy);
             return;
         }
     }
@@ -203,7 +736,20 @@ void parallel_quick_sort( RandomAccessIterator begin, RandomAccessIterator end,
                  my_context);
 
     if( my_context.is_group_execution_cancelled() )
-        do_parallel_quick_sort(begin, end, comp);
+        do_parallel_sort(begin, end, comp, strategy);
+}
+
+//! Sorts small sequences serially and passes larger ones to parallel_sort_impl.
+template<typename RandomAccessIterator, typename Compare, typename Strategy>
+void parallel_sort_dispatch( RandomAccessIterator begin, RandomAccessIterator end, const Compare& comp, Strategy strategy ) {
+    constexpr int min_parallel_size = 500;
+    if( end > begin ) {
+        if( end - begin < min_parallel_size ) {
+            std::sort(begin, end, comp);
+        } else {
+            parallel_sort_impl(begin, end, comp, strategy);
+        }
+    }
 }
 
 /** \page parallel_sort_iter_req Requirements on iterators for parallel_sort
@@ -236,14 +782,7 @@ template<typename RandomAccessIterator, typename Compare>
                    compare<Compare, RandomAccessIterator> &&
                    std::movable<iter_value_type<RandomAccessIterator>>)
 void parallel_sort( RandomAccessIterator begin, RandomAccessIterator end, const Compare& comp ) {
-    constexpr int min_parallel_size = 500;
-    if( end > begin ) {
-        if( end - begin < min_parallel_size ) {
-            std::sort(begin, end, comp);
-        } else {
-            parallel_quick_sort(begin, end, comp);
-        }
-    }
+    parallel_sort_dispatch(begin, end, comp, auto_sort_tag());
 }
 
 //! Sorts the data in [begin,end) with a default comparator \c std::less
@@ -275,13 +814,113 @@ template<typename Range>
 void parallel_sort( Range&& rng ) {
     parallel_sort(std::begin(rng), std::end(rng));
 }
+
+#if __TBB_PREVIEW_PARALLEL_SORT_STRATEGIES
+//! Sorts the data in [begin,end) using the given comparator and the algorithm selected by the strategy tag
+/** @ingroup algorithms **/
+template<typename RandomAccessIterator, typename Compare, typename Strategy,
+         typename = typename std::enable_if<is_sort_strategy<Strategy>::value>::type>
+    __TBB_requires(std::random_access_iterator<RandomAccessIterator> &&
+                   compare<Compare, RandomAccessIterator> &&
+                   std::movable<iter_value_type<RandomAccessIterator>>)
+void parallel_sort( RandomAccessIterator begin, RandomAccessIterator end, const Compare& comp, Strategy strategy ) {
+    parallel_sort_dispatch(begin, end, comp, strategy);
+}
+
+//! Sorts the data in rng using the given comparator and the algorithm selected by the strategy tag
+/** @ingroup algorithms **/
+template<typename Range, typename Compare, typename Strategy,
+         typename = typename std::enable_if<is_sort_strategy<Strategy>::value>::type>
+    __TBB_requires(container_based_sequence<Range, std::random_access_iterator_tag> &&
+                   compare<Compare, range_iterator_type<Range>> &&
+                   std::movable<range_value_type<Range>>)
+void parallel_sort( Range&& rng, const Compare& comp, Strategy strategy ) {
+    parallel_sort_dispatch(std::begin(rng), std::end(rng), comp, strategy);
+}
+#endif // __TBB_PREVIEW_PARALLEL_SORT_STRATEGIES
+//@}
+
+#if __TBB_PREVIEW_PARALLEL_PARTIAL_SORT
+/** \name parallel_nth_element, parallel_partial_sort
+    See also requirements on \ref parallel_sort_iter_req "iterators for parallel_sort". **/
+//@{
+
+//! Rearranges [begin,end) so that nth holds the element that would be there if the sequence were sorted
+/** No element of [begin,nth) is greater than *nth and no element of [nth,end) is less than it.
+    Subranges that cannot contain nth are not partitioned any further.
+    @ingroup algorithms **/
+template<typename RandomAccessIterator, typename Compare>
+    __TBB_requires(std::random_access_iterator<RandomAccessIterator> &&
+                   compare<Compare, RandomAccessIterator> &&
+                   std::movable<iter_value_type<RandomAccessIterator>>)
+void parallel_nth_element( RandomAccessIterator begin, RandomAccessIterator nth, RandomAccessIterator end,
+                           const Compare& comp ) {
+    constexpr int min_parallel_size = 500;
+    if( nth < end && begin < end ) {
+        if( end - begin < min_parallel_size ) {
+            std::nth_element(begin, nth, end, comp);
+        } else {
+            do_parallel_nth_element(begin, nth, end, comp);
+        }
+    }
+}
+
+//! Rearranges [begin,end) with a default comparator \c std::less so that nth holds the element of sorted position
+/** @ingroup algorithms **/
+template<typename RandomAccessIterator>
+    __TBB_requires(std::random_access_iterator<RandomAccessIterator> &&
+                   less_than_comparable<iter_value_type<RandomAccessIterator>> &&
+                   std::movable<iter_value_type<RandomAccessIterator>>)
+void parallel_nth_element( RandomAccessIterator begin, RandomAccessIterator nth, RandomAccessIterator end ) {
+    parallel_nth_element(begin, nth, end, std::less<typename std::iterator_traits<RandomAccessIterator>::value_type>());
+}
+
+//! Places the (middle - begin) smallest elements of [begin,end) sorted into [begin,middle)
+/** The order of the elements in [middle,end) is unspecified.
+    Subranges that lie entirely in [middle,end) are neither partitioned nor sorted.
+    @ingroup algorithms **/
+template<typename RandomAccessIterator, typename Compare>
+    __TBB_requires(std::random_access_iterator<RandomAccessIterator> &&
+                   compare<Compare, RandomAccessIterator> &&
+                   std::movable<iter_value_type<RandomAccessIterator>>)
+void parallel_partial_sort( RandomAccessIterator begin, RandomAccessIterator middle, RandomAccessIterator end,
+                            const Compare& comp ) {
+    constexpr int min_parallel_size = 500;
+    if( begin < middle && begin < end ) {
+        if( end - begin < min_parallel_size ) {
+            std::partial_sort(begin, middle, end, comp);
+        } else {
+            do_parallel_partial_sort(begin, middle, end, comp);
+        }
+    }
+}
+
+//! Places the (middle - begin) smallest elements of [begin,end) sorted into [begin,middle) with a default comparator \c std::less
+/** @ingroup algorithms **/
+template<typename RandomAccessIterator>
+    __TBB_requires(std::random_access_iterator<RandomAccessIterator> &&
+                   less_than_comparable<iter_value_type<RandomAccessIterator>> &&
+                   std::movable<iter_value_type<RandomAccessIterator>>)
+void parallel_partial_sort( RandomAccessIterator begin, RandomAccessIterator middle, RandomAccessIterator end ) {
+    parallel_partial_sort(begin, middle, end, std::less<typename std::iterator_traits<RandomAccessIterator>::value_type>());
+}
 //@}
+#endif // __TBB_PREVIEW_PARALLEL_PARTIAL_SORT
 
 } // namespace d1
 } // namespace detail
 
 inline namespace v1 {
     using detail::d1::parallel_sort;
+#if __TBB_PREVIEW_PARALLEL_SORT_STRATEGIES
+    using detail::d1::quick_sort_tag;
+    using detail::d1::radix_sort_tag;
+    using detail::d1::sample_sort_tag;
+#endif
+#if __TBB_PREVIEW_PARALLEL_PARTIAL_SORT
+    using detail::d1::parallel_nth_element;
+    using detail::d1::parallel_partial_sort;
+#endif
 } // namespace v1
 } // namespace tbb
 
@@ -0,0 +1,226 @@
+/*
+    Copyright (c) 2024 Intel Corporation
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#ifndef __TBB_parallel_stable_sort_H
+#define __TBB_parallel_stable_sort_H
+
+#if ! TBB_PREVIEW_PARALLEL_STABLE_SORT
+    #error Set TBB_PREVIEW_PARALLEL_STABLE_SORT to include parallel_stable_sort.h
+#endif
+
+#include "detail/_namespace_injection.h"
+#include "detail/_template_helpers.h"
+#include "parallel_sort.h"
+#include "parallel_invoke.h"
+
+#include <algorithm>
+#include <iterator>
+#include <functional>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace tbb {
+namespace detail {
+namespace d1 {
+
+//! Merge sort that keeps the order of equivalent elements.
+/** The scratch buffer of the sequence size is allocated once per call and both halves of
+    every recursion level alternate between the sequence and the buffer, so each level moves
+    the elements exactly once. The buffer is initialized from the sequence before sorting,
+    so all elements stay valid objects if the comparator throws.
+    @ingroup algorithms */
+template <typename RandomAccessIterator, typename Compare>
+class stable_sorter {
+    using value_type = typename std::iterator_traits<RandomAccessIterator>::value_type;
+
+    static constexpr std::size_t sort_cutoff = 500;
+    static constexpr std::size_t merge_cutoff = 2000;
+    static constexpr std::size_t init_grainsize = 4096;
+
+    const Compare& my_comp;
+
+    //! Merges sorted [xs, xe) and [ys, ye) into out; elements of x go first among equivalent ones.
+    template <typename InputIterator, typename OutputIterator>
+    void serial_merge( InputIterator xs, InputIterator xe, InputIterator ys, InputIterator ye, OutputIterator out ) const {
+        while (xs != xe && ys != ye) {
+            if (my_comp(*ys, *xs)) {
+                *out = std::move(*ys);
+                ++ys;
+            } else {
+                *out = std::move(*xs);
+                ++xs;
+            }
+            ++out;
+        }
+        out = std::move(xs, xe, out);
+        std::move(ys, ye, out);
+    }
+
+    template <typename InputIterator, typename OutputIterator>
+    void parallel_merge( InputIterator xs, InputIterator xe, InputIterator ys, InputIterator ye, OutputIterator out ) const {
+        if (std::size_t((xe - xs) + (ye - ys)) <= merge_cutoff) {
+            serial_merge(xs, xe, ys, ye, out);
+            return;
+        }
+        // Split the larger sequence in half and find the matching position in the other one.
+        // Equivalent elements of x must stay to the left of the ones of y.
+        InputIterator xm;
+        InputIterator ym;
+        if (xe - xs < ye - ys) {
+            ym = ys + (ye - ys) / 2;
+            xm = std::upper_bound(xs, xe, *ym, my_comp);
+        } else {
+            xm = xs + (xe - xs) / 2;
+            ym = std::lower_bound(ys, ye, *xm, my_comp);
+        }
+        OutputIterator out_m = out + ((xm - xs) + (ym - ys));
+        parallel_invoke([this, xs, xm, ys, ym, out] { parallel_merge(xs, xm, ys, ym, out); },
+                        [this, xm, xe, ym, ye, out_m] { parallel_merge(xm, xe, ym, ye, out_m); });
+    }
+
+    //! Sorts n elements of data; the result is placed into buffer if to_buffer is set.
+    template <typename DataIterator, typename BufferIterator>
+    void sort( DataIterator data, BufferIterator buffer, std::size_t n, bool to_buffer ) const {
+        if (n <= sort_cutoff) {
+            std::stable_sort(data, data + n, my_comp);
+            if (to_buffer) {
+                std::move(data, data + n, buffer);
+            }
+            return;
+        }
+        std::size_t m = n / 2;
+        parallel_invoke([this, data, buffer, m, to_buffer] { sort(data, buffer, m, !to_buffer); },
+                        [this, data, buffer, m, n, to_buffer] { sort(data + m, buffer + m, n - m, !to_buffer); });
+        if (to_buffer) {
+            parallel_merge(data, data + m, data + m, data + n, buffer);
+        } else {
+            parallel_merge(buffer, buffer + m, buffer + m, buffer + n, data);
+        }
+    }
+
+    //! Move-constructs the buffer from the sequence, leaving it with moved-from objects.
+    void initialize( RandomAccessIterator data, value_type* buffer, std::size_t n,
+                     /*is_nothrow_move_constructible*/ std::true_type ) const {
+        parallel_for(blocked_range<std::size_t>(0, n, init_grainsize), [data, buffer] (const blocked_range<std::size_t>& r) {
+            for (std::size_t i = r.begin(); i != r.end(); ++i) {
+                new (buffer + i) value_type(std::move(data[i]));
+            }
+        });
+    }
+
+    void initialize( RandomAccessIterator data, value_type* buffer, std::size_t n,
+                     /*is_nothrow_move_constructible*/ std::false_type ) const {
+        std::size_t constructed = 0;
+        try_call([&] {
+            for (; constructed != n; ++constructed) {
+                new (buffer + constructed) value_type(std::move(data[constructed]));
+            }
+        }).on_exception([&] {
+            // Return the elements that were already moved
+            for (std::size_t i = 0; i != constructed; ++i) {
+                data[i] = std::move(buffer[i]);
+            }
+            destroy(buffer, constructed);
+        });
+    }
+
+    static void destroy( value_type* buffer, std::size_t n ) {
+        for (std::size_t i = 0; i != n; ++i) {
+            buffer[i].~value_type();
+        }
+    }
+
+public:
+    stable_sorter( const Compare& comp ) : my_comp(comp) {}
+
+    void operator()( RandomAccessIterator data, std::size_t n ) const {
+        sort_buffer<value_type> buffer(n);
+        value_type* scratch = buffer.get();
+        initialize(data, scratch, n, std::is_nothrow_move_constructible<value_type>());
+        // The elements are in the buffer now and the sorted result goes back to the sequence
+        try_call([&] {
+            sort(scratch, data, n, /*to_buffer*/ true);
+        }).on_completion([&] {
+            destroy(scratch, n);
+        });
+    }
+};
+
+/** \name parallel_stable_sort
+    See also requirements on \ref parallel_sort_iter_req "iterators for parallel_sort". **/
+//@{
+
+//! Sorts the data in [begin,end) using the given comparator, preserving the order of equivalent elements
+/** The compare function object is used for all comparisons between elements during sorting.
+    The compare object must define a bool operator() function.
+    @ingroup algorithms **/
+template<typename RandomAccessIterator, typename Compare>
+    __TBB_requires(std::random_access_iterator<RandomAccessIterator> &&
+                   compare<Compare, RandomAccessIterator> &&
+                   std::movable<iter_value_type<RandomAccessIterator>>)
+void parallel_stable_sort( RandomAccessIterator begin, RandomAccessIterator end, const Compare& comp ) {
+    constexpr int min_parallel_size = 500;
+    if( end > begin ) {
+        if( end - begin < min_parallel_size ) {
+            std::stable_sort(begin, end, comp);
+        } else {
+            stable_sorter<RandomAccessIterator, Compare> sorter(comp);
+            sorter(begin, std::size_t(end - begin));
+        }
+    }
+}
+
+//! Sorts the data in [begin,end) with a default comparator \c std::less, preserving the order of equivalent elements
+/** @ingroup algorithms **/
+template<typename RandomAccessIterator>
+    __TBB_requires(std::random_access_iterator<RandomAccessIterator> &&
+                   less_than_comparable<iter_value_type<RandomAccessIterator>> &&
+                   std::movable<iter_value_type<RandomAccessIterator>>)
+void parallel_stable_sort( RandomAccessIterator begin, RandomAccessIterator end ) {
+    parallel_stable_sort(begin, end, std::less<typename std::iterator_traits<RandomAccessIterator>::value_type>());
+}
+
+//! Sorts the data in rng using the given comparator, preserving the order of equivalent elements
+/** @ingroup algorithms **/
+template<typename Range, typename Compare>
+    __TBB_requires(container_based_sequence<Range, std::random_access_iterator_tag> &&
+                   compare<Compare, range_iterator_type<Range>> &&
+                   std::movable<range_value_type<Range>>)
+void parallel_stable_sort( Range&& rng, const Compare& comp ) {
+    parallel_stable_sort(std::begin(rng), std::end(rng), comp);
+}
+
+//! Sorts the data in rng with a default comparator \c std::less, preserving the order of equivalent elements
+/** @ingroup algorithms **/
+template<typename Range>
+    __TBB_requires(container_based_sequence<Range, std::random_access_iterator_tag> &&
+                   less_than_comparable<range_value_type<Range>> &&
+                   std::movable<range_value_type<Range>>)
+void parallel_stable_sort( Range&& rng ) {
+    parallel_stable_sort(std::begin(rng), std::end(rng));
+}
+//@}
+
+} // namespace d1
+} // namespace detail
+
+inline namespace v1 {
+    using detail::d1::parallel_stable_sort;
+} // namespace v1
+} // namespace tbb
+
+#endif /*__TBB_parallel_stable_sort_H*/
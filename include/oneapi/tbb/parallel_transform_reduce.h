@@ -0,0 +1,286 @@
+/*
+    Copyright (c) 2024 Intel Corporation
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#ifndef __TBB_parallel_transform_reduce_H
+#define __TBB_parallel_transform_reduce_H
+
+#if ! TBB_PREVIEW_PARALLEL_TRANSFORM_REDUCE
+    #error Set TBB_PREVIEW_PARALLEL_TRANSFORM_REDUCE to include parallel_transform_reduce.h
+#endif
+
+#include "detail/_namespace_injection.h"
+#include "detail/_aligned_space.h"
+#include "detail/_template_helpers.h"
+
+#include "blocked_range.h"
+#include "parallel_for.h"
+#include "parallel_reduce.h"
+#include "task_group.h" // task_group_context
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <new>
+#include <utility>
+
+namespace tbb {
+namespace detail {
+namespace d1 {
+
+//! Applies a unary transformation to the element with the given index.
+template <typename Iterator, typename Transform>
+class unary_element_transform {
+    Iterator my_first;
+    const Transform& my_transform;
+public:
+    unary_element_transform( Iterator first, const Transform& transform ) : my_first(first), my_transform(transform) {}
+
+    auto operator()( std::size_t i ) const -> decltype(tbb::detail::invoke(my_transform, *my_first)) {
+        return tbb::detail::invoke(my_transform, my_first[i]);
+    }
+};
+
+//! Applies a binary transformation to the elements of two sequences with the given index.
+template <typename Iterator1, typename Iterator2, typename Transform>
+class binary_element_transform {
+    Iterator1 my_first1;
+    Iterator2 my_first2;
+    const Transform& my_transform;
+public:
+    binary_element_transform( Iterator1 first1, Iterator2 first2, const Transform& transform )
+        : my_first1(first1), my_first2(first2), my_transform(transform) {}
+
+    auto operator()( std::size_t i ) const -> decltype(tbb::detail::invoke(my_transform, *my_first1, *my_first2)) {
+        return tbb::detail::invoke(my_transform, my_first1[i], my_first2[i]);
+    }
+};
+
+//! Body of parallel_reduce that accumulates transformed elements without an identity value.
+/** A body created by the splitting constructor holds no value until it processes its first element,
+    which is moved into it, so Value is never copied when the work is split. The partial results
+    are moved into the reduction as well.
+    @ingroup algorithms */
+template <typename Value, typename ElementTransform, typename Reduction>
+class transform_reduce_body : no_copy {
+    const ElementTransform& my_element;
+    const Reduction& my_reduction;
+    aligned_space<Value> my_value;
+    bool my_has_value{false};
+
+    Value& value() { return *my_value.begin(); }
+
+public:
+    transform_reduce_body( const ElementTransform& element, const Reduction& reduction )
+        : my_element(element), my_reduction(reduction) {}
+
+    transform_reduce_body( transform_reduce_body& other, split )
+        : my_element(other.my_element), my_reduction(other.my_reduction) {}
+
+    ~transform_reduce_body() {
+        if (my_has_value) {
+            value().~Value();
+        }
+    }
+
+    void operator()( const blocked_range<std::size_t>& r ) {
+        std::size_t i = r.begin();
+        if (!my_has_value) {
+            new (my_value.begin()) Value(my_element(i));
+            my_has_value = true;
+            ++i;
+        }
+        Value& sum = value();
+        for (; i != r.end(); ++i) {
+            sum = tbb::detail::invoke(my_reduction, std::move(sum), my_element(i));
+        }
+    }
+
+    void join( transform_reduce_body& rhs ) {
+        if (!rhs.my_has_value) {
+            return;
+        }
+        if (my_has_value) {
+            value() = tbb::detail::invoke(my_reduction, std::move(value()), std::move(rhs.value()));
+        } else {
+            new (my_value.begin()) Value(std::move(rhs.value()));
+            my_has_value = true;
+        }
+    }
+
+    //! Returns the reduction of init and the accumulated value.
+    Value result( Value init ) {
+        if (my_has_value) {
+            return tbb::detail::invoke(my_reduction, std::move(init), std::move(value()));
+        }
+        return init;
+    }
+};
+
+template <typename Value, typename ElementTransform, typename Reduction>
+Value transform_reduce_impl( std::size_t n, Value init, const ElementTransform& element, const Reduction& reduction ) {
+    if (n == 0) {
+        return init;
+    }
+    transform_reduce_body<Value, ElementTransform, Reduction> body(element, reduction);
+    parallel_reduce(blocked_range<std::size_t>(0, n), body);
+    return body.result(std::move(init));
+}
+
+//! Returns the index of the first element satisfying the predicate, or n if there is none.
+/** Subranges that start after the leftmost match found so far are skipped, and the search
+    stops inside a subrange as soon as a match to the left of it is found.
+    @ingroup algorithms */
+template <typename Iterator, typename Predicate>
+std::size_t find_first_index( Iterator first, std::size_t n, const Predicate& pred ) {
+    std::atomic<std::size_t> found{n};
+    parallel_for(blocked_range<std::size_t>(0, n), [&] (const blocked_range<std::size_t>& r) {
+        for (std::size_t i = r.begin(); i != r.end(); ++i) {
+            if (found.load(std::memory_order_relaxed) <= i) {
+                return;
+            }
+            if (tbb::detail::invoke(pred, first[i])) {
+                std::size_t current = found.load(std::memory_order_relaxed);
+                while (i < current && !found.compare_exchange_weak(current, i)) {}
+                return;
+            }
+        }
+    });
+    return found.load(std::memory_order_relaxed);
+}
+
+/** \name parallel_transform_reduce, parallel_transform, parallel_count_if, parallel_find_if, parallel_any_of
+    The reduction must be associative; it is not required to be commutative. **/
+//@{
+
+//! Returns the reduction of init and the transformed elements of [first,last)
+/** @ingroup algorithms **/
+template <typename RandomAccessIterator, typename Value, typename Reduction, typename Transform>
+    __TBB_requires(std::random_access_iterator<RandomAccessIterator>)
+Value parallel_transform_reduce( RandomAccessIterator first, RandomAccessIterator last, Value init,
+                                 const Reduction& reduction, const Transform& transform ) {
+    using element_type = unary_element_transform<RandomAccessIterator, Transform>;
+    return transform_reduce_impl(std::size_t(last - first), std::move(init), element_type(first, transform), reduction);
+}
+
+//! Returns the reduction of init and the results of transform applied to the pairs of elements of two sequences
+/** @ingroup algorithms **/
+template <typename RandomAccessIterator1, typename RandomAccessIterator2, typename Value, typename Reduction, typename Transform>
+    __TBB_requires(std::random_access_iterator<RandomAccessIterator1> && std::random_access_iterator<RandomAccessIterator2>)
+Value parallel_transform_reduce( RandomAccessIterator1 first1, RandomAccessIterator1 last1, RandomAccessIterator2 first2,
+                                 Value init, const Reduction& reduction, const Transform& transform ) {
+    using element_type = binary_element_transform<RandomAccessIterator1, RandomAccessIterator2, Transform>;
+    return transform_reduce_impl(std::size_t(last1 - first1), std::move(init), element_type(first1, first2, transform), reduction);
+}
+
+//! Writes the transformed elements of [first,last) to the sequence beginning at result
+/** @ingroup algorithms **/
+template <typename RandomAccessIterator, typename OutputIterator, typename Transform>
+    __TBB_requires(std::random_access_iterator<RandomAccessIterator> && std::random_access_iterator<OutputIterator>)
+OutputIterator parallel_transform( RandomAccessIterator first, RandomAccessIterator last, OutputIterator result,
+                                   const Transform& transform ) {
+    if (first < last) {
+        parallel_for(blocked_range<std::size_t>(0, std::size_t(last - first)), [&] (const blocked_range<std::size_t>& r) {
+            for (std::size_t i = r.begin(); i != r.end(); ++i) {
+                result[i] = tbb::detail::invoke(transform, first[i]);
+            }
+        });
+    }
+    return result + (last - first);
+}
+
+//! Writes the results of transform applied to the pairs of elements of two sequences to the sequence beginning at result
+/** @ingroup algorithms **/
+template <typename RandomAccessIterator1, typename RandomAccessIterator2, typename OutputIterator, typename Transform>
+    __TBB_requires(std::random_access_iterator<RandomAccessIterator1> && std::random_access_iterator<RandomAccessIterator2> &&
+                   std::random_access_iterator<OutputIterator>)
+OutputIterator parallel_transform( RandomAccessIterator1 first1, RandomAccessIterator1 last1, RandomAccessIterator2 first2,
+                                   OutputIterator result, const Transform& transform ) {
+    if (first1 < last1) {
+        parallel_for(blocked_range<std::size_t>(0, std::size_t(last1 - first1)), [&] (const blocked_range<std::size_t>& r) {
+            for (std::size_t i = r.begin(); i != r.end(); ++i) {
+                result[i] = tbb::detail::invoke(transform, first1[i], first2[i]);
+            }
+        });
+    }
+    return result + (last1 - first1);
+}
+
+//! Returns the number of elements of [first,last) satisfying the predicate
+/** @ingroup algorithms **/
+template <typename RandomAccessIterator, typename Predicate>
+    __TBB_requires(std::random_access_iterator<RandomAccessIterator>)
+typename std::iterator_traits<RandomAccessIterator>::difference_type
+parallel_count_if( RandomAccessIterator first, RandomAccessIterator last, const Predicate& pred ) {
+    using difference_type = typename std::iterator_traits<RandomAccessIterator>::difference_type;
+    return parallel_transform_reduce(first, last, difference_type(0), std::plus<difference_type>(),
+        [&pred] (const typename std::iterator_traits<RandomAccessIterator>::reference x) -> difference_type {
+            return tbb::detail::invoke(pred, x) ? 1 : 0;
+        });
+}
+
+//! Returns the first element of [first,last) satisfying the predicate, or last if there is none
+/** The elements after the leftmost match found so far are not checked.
+    @ingroup algorithms **/
+template <typename RandomAccessIterator, typename Predicate>
+    __TBB_requires(std::random_access_iterator<RandomAccessIterator>)
+RandomAccessIterator parallel_find_if( RandomAccessIterator first, RandomAccessIterator last, const Predicate& pred ) {
+    if (first < last) {
+        return first + find_first_index(first, std::size_t(last - first), pred);
+    }
+    return last;
+}
+
+//! Checks whether any element of [first,last) satisfies the predicate
+/** The search is cancelled as soon as a matching element is found.
+    @ingroup algorithms **/
+template <typename RandomAccessIterator, typename Predicate>
+    __TBB_requires(std::random_access_iterator<RandomAccessIterator>)
+bool parallel_any_of( RandomAccessIterator first, RandomAccessIterator last, const Predicate& pred ) {
+    if (!(first < last)) {
+        return false;
+    }
+    std::atomic<bool> found{false};
+    task_group_context context(PARALLEL_FOR);
+    parallel_for(blocked_range<std::size_t>(0, std::size_t(last - first)), [&] (const blocked_range<std::size_t>& r) {
+        for (std::size_t i = r.begin(); i != r.end(); ++i) {
+            if (tbb::detail::invoke(pred, first[i])) {
+                found.store(true, std::memory_order_relaxed);
+                context.cancel_group_execution();
+                return;
+            }
+            if ((i & 63) == 0 && context.is_group_execution_cancelled()) {
+                return;
+            }
+        }
+    }, auto_partitioner(), context);
+    return found.load(std::memory_order_relaxed);
+}
+//@}
+
+} // namespace d1
+} // namespace detail
+
+inline namespace v1 {
+    using detail::d1::parallel_transform_reduce;
+    using detail::d1::parallel_transform;
+    using detail::d1::parallel_count_if;
+    using detail::d1::parallel_find_if;
+    using detail::d1::parallel_any_of;
+} // namespace v1
+} // namespace tbb
+
+#endif /* __TBB_parallel_transform_reduce_H */
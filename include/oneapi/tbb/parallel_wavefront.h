@@ -0,0 +1,195 @@
+/*
+    Copyright (c) 2024 Intel Corporation
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#ifndef __TBB_parallel_wavefront_H
+#define __TBB_parallel_wavefront_H
+
+#if ! TBB_PREVIEW_PARALLEL_WAVEFRONT
+    #error Set TBB_PREVIEW_PARALLEL_WAVEFRONT to include parallel_wavefront.h
+#endif
+
+#include "detail/_config.h"
+#include "detail/_namespace_injection.h"
+#include "detail/_exception.h"
+#include "detail/_task.h"
+#include "detail/_utils.h"
+
+#include "blocked_range.h"
+#include "blocked_range2d.h"
+#include "cache_aligned_allocator.h"
+#include "task_group.h" // task_group_context
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+namespace tbb {
+namespace detail {
+namespace d1 {
+
+template <typename Grid>
+class wavefront_block_task : public task {
+    Grid& my_grid;
+public:
+    //! Number of the neighbors above and to the left that are not processed yet
+    std::atomic<int> my_predecessors;
+    const std::size_t my_row;
+    const std::size_t my_col;
+
+    wavefront_block_task( Grid& grid, std::size_t row, std::size_t col )
+        : my_grid(grid), my_predecessors(int(row > 0) + int(col > 0)), my_row(row), my_col(col) {}
+
+    task* execute( execution_data& ed ) override {
+        my_grid.run_body(*this);
+        return my_grid.complete(*this, ed);
+    }
+
+    //! Called instead of execute when the computation is cancelled or the body has thrown
+    task* cancel( execution_data& ed ) override {
+        return my_grid.complete(*this, ed);
+    }
+};
+
+//! Blocks of a 2D range processed in the wavefront order.
+/** Block (i, j) can be processed when blocks (i - 1, j) and (i, j - 1) are processed.
+    The tasks of all blocks are preallocated in one array together with their dependency counters.
+    A completed block bypasses the spawn for one of the blocks it makes ready, preferring the block
+    to the right, which shares the rows with it; the other one is spawned and can be stolen.
+    When the computation is cancelled, the blocks still go through the dependencies without
+    calling the body, so every block is released exactly once.
+    @ingroup algorithms */
+template <typename RowValue, typename ColValue, typename Body>
+class wavefront_grid : no_copy {
+    using range_type = blocked_range2d<RowValue, ColValue>;
+    using block_type = wavefront_block_task<wavefront_grid>;
+    using allocator_type = cache_aligned_allocator<block_type>;
+
+    const range_type& my_range;
+    const Body& my_body;
+    const std::size_t my_rows;
+    const std::size_t my_cols;
+    allocator_type my_allocator;
+    block_type* my_blocks;
+    wait_context my_wait;
+
+    template <typename Value>
+    static std::size_t block_count( const blocked_range<Value>& d ) {
+        return (d.size() + d.grainsize() - 1) / d.grainsize();
+    }
+
+    template <typename Value>
+    static blocked_range<Value> block_of( const blocked_range<Value>& d, std::size_t index ) {
+        const std::size_t first = index * d.grainsize();
+        const std::size_t last = first + d.grainsize() < d.size() ? first + d.grainsize() : d.size();
+        return blocked_range<Value>(d.begin() + first, d.begin() + last, d.grainsize());
+    }
+
+    block_type& block( std::size_t row, std::size_t col ) {
+        return my_blocks[row * my_cols + col];
+    }
+
+    static bool make_ready( block_type& b ) {
+        return b.my_predecessors.fetch_sub(1, std::memory_order_acq_rel) == 1;
+    }
+
+public:
+    wavefront_grid( const range_type& range, const Body& body )
+        : my_range(range)
+        , my_body(body)
+        , my_rows(block_count(range.rows()))
+        , my_cols(block_count(range.cols()))
+        , my_blocks(my_allocator.allocate(my_rows * my_cols))
+        , my_wait(std::uint32_t(my_rows * my_cols))
+    {
+        __TBB_ASSERT(my_rows * my_cols <= UINT32_MAX, "Too many blocks in parallel_wavefront");
+        for (std::size_t i = 0; i < my_rows; ++i) {
+            for (std::size_t j = 0; j < my_cols; ++j) {
+                new (&block(i, j)) block_type(*this, i, j);
+            }
+        }
+    }
+
+    ~wavefront_grid() {
+        for (std::size_t k = 0; k < my_rows * my_cols; ++k) {
+            my_blocks[k].~block_type();
+        }
+        my_allocator.deallocate(my_blocks, my_rows * my_cols);
+    }
+
+    void run( task_group_context& context ) {
+        execute_and_wait(block(0, 0), context, my_wait, context);
+    }
+
+    void run_body( const block_type& b ) {
+        blocked_range<RowValue> rows = block_of(my_range.rows(), b.my_row);
+        blocked_range<ColValue> cols = block_of(my_range.cols(), b.my_col);
+        tbb::detail::invoke(my_body, range_type(rows.begin(), rows.end(), rows.grainsize(),
+                                                cols.begin(), cols.end(), cols.grainsize()));
+    }
+
+    //! Releases the successors of the block and returns the one to be executed next by this thread
+    task* complete( block_type& b, execution_data& ed ) {
+        task* bypass = nullptr;
+        if (b.my_col + 1 < my_cols && make_ready(block(b.my_row, b.my_col + 1))) {
+            bypass = &block(b.my_row, b.my_col + 1);
+        }
+        if (b.my_row + 1 < my_rows && make_ready(block(b.my_row + 1, b.my_col))) {
+            if (bypass) {
+                spawn(block(b.my_row + 1, b.my_col), *context(ed));
+            } else {
+                bypass = &block(b.my_row + 1, b.my_col);
+            }
+        }
+        // The grid can be destroyed after the last block is released
+        my_wait.release();
+        return bypass;
+    }
+};
+
+/** \name parallel_wavefront
+    Calls the body for the blocks of a 2D range so that a block is processed after the blocks
+    above and to the left of it. The blocks have the grain size of the range in each dimension. **/
+//@{
+
+//! Processes the blocks of the range in the wavefront order
+/** @ingroup algorithms **/
+template <typename RowValue, typename ColValue, typename Body>
+void parallel_wavefront( const blocked_range2d<RowValue, ColValue>& range, const Body& body ) {
+    task_group_context context(PARALLEL_FOR);
+    parallel_wavefront(range, body, context);
+}
+
+//! Processes the blocks of the range in the wavefront order using the user-supplied context
+/** @ingroup algorithms **/
+template <typename RowValue, typename ColValue, typename Body>
+void parallel_wavefront( const blocked_range2d<RowValue, ColValue>& range, const Body& body, task_group_context& context ) {
+    if (!range.empty()) {
+        wavefront_grid<RowValue, ColValue, Body> grid(range, body);
+        grid.run(context);
+    }
+}
+//@}
+
+} // namespace d1
+} // namespace detail
+
+inline namespace v1 {
+    using detail::d1::parallel_wavefront;
+} // namespace v1
+} // namespace tbb
+
+#endif /* __TBB_parallel_wavefront_H */
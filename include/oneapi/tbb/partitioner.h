@@ -51,6 +51,12 @@
 #include <atomic>
 #include <type_traits>
 
+#if __TBB_PREVIEW_LEARNING_PARTITIONER
+#include <chrono>
+#include <cstdint>
+#include <new>
+#endif
+
 #if defined(_MSC_VER) && !defined(__INTEL_COMPILER)
     // Workaround for overzealous compiler warnings
     #pragma warning (push)
@@ -67,6 +73,10 @@ class static_partitioner;
 class affinity_partitioner;
 class affinity_partition_type;
 class affinity_partitioner_base;
+#if __TBB_PREVIEW_LEARNING_PARTITIONER
+class learning_partitioner;
+class learning_partition_type;
+#endif
 
 inline std::size_t get_initial_auto_partitioner_divisor() {
     const std::size_t factor = 4;
@@ -562,6 +572,221 @@ public:
     }
 };
 
+#if __TBB_PREVIEW_LEARNING_PARTITIONER
+//! Execution history of learning_partitioner.
+/** For every position of the initial range decomposition, which is the same as the one of
+    affinity_partitioner, remembers the slot that executed it and the time spent in it during
+    the last invocation. At the start of the next invocation the history is used to choose how
+    many positions a leaf task covers and how many pieces of an expensive leaf are offered
+    to other threads right away. */
+class learning_partitioner_base: no_copy {
+    friend class learning_partitioner;
+    friend class learning_partition_type;
+public:
+    static constexpr unsigned factor_power = 4;
+    //! Number of positions in the history per thread
+    static constexpr unsigned factor = 1 << factor_power;
+private:
+    //! Leaf tasks are merged if they take less time on average
+    static constexpr std::uint64_t min_leaf_time_ns = 20000;
+    //! Leaf tasks that take this many times longer than the average are presplit
+    static constexpr std::uint64_t skew_ratio = 2;
+    static constexpr unsigned char max_presplit = 8;
+
+    struct position {
+        std::atomic<std::uint64_t> time_ns{0};
+        slot_id affinity{no_slot};
+        unsigned char presplit{0};
+    };
+
+    position* my_array{nullptr};
+    std::size_t my_size{0};
+    //! Number of positions covered by a leaf task
+    std::size_t my_leaf_size{1};
+    //! Initial depth of the range pool of a leaf task
+    depth_t my_pool_depth{factor_power + 1};
+    //! True if the positions store the times of the previous invocation
+    bool my_has_history{false};
+
+    learning_partitioner_base() = default;
+    ~learning_partitioner_base() { resize(0); }
+
+    //! Resize my_array; the history is dropped if the size changes.
+    void resize(unsigned factor_) {
+        std::size_t new_size = factor_ ? factor_ * static_cast<std::size_t>(max_concurrency()) : 0;
+        if (new_size != my_size) {
+            if (my_array) {
+                for (std::size_t i = 0; i < my_size; ++i) {
+                    my_array[i].~position();
+                }
+                r1::cache_aligned_deallocate(my_array);
+                my_array = nullptr;
+                my_size = 0;
+            }
+            if (new_size) {
+                my_array = static_cast<position*>(r1::cache_aligned_allocate(new_size * sizeof(position)));
+                for (std::size_t i = 0; i < new_size; ++i) {
+                    new (my_array + i) position();
+                }
+                my_size = new_size;
+            }
+            my_leaf_size = 1;
+            my_pool_depth = factor_power + 1;
+            my_has_history = false;
+        }
+    }
+
+    //! Derives the leaf size and the presplit counts from the times of the previous invocation.
+    void learn() {
+        std::uint64_t total = 0;
+        for (std::size_t i = 0; i < my_size; ++i) {
+            total += my_array[i].time_ns.load(std::memory_order_relaxed);
+        }
+        if (total == 0) {
+            return;
+        }
+        // Cheap leaves are merged first and then split into fewer pieces of the range pool,
+        // expensive ones are split back in the reverse order
+        std::uint64_t mean = total / (my_size / my_leaf_size);
+        if (mean < min_leaf_time_ns) {
+            if (my_leaf_size < factor) {
+                my_leaf_size *= 2;
+            } else if (my_pool_depth > 1) {
+                --my_pool_depth;
+            }
+        } else if (mean > 4 * min_leaf_time_ns) {
+            if (my_pool_depth < factor_power + 1) {
+                ++my_pool_depth;
+            } else if (my_leaf_size > 1) {
+                my_leaf_size /= 2;
+            }
+        }
+        mean = std::max<std::uint64_t>(total / (my_size / my_leaf_size), 1);
+        for (std::size_t leaf = 0; leaf < my_size; leaf += my_leaf_size) {
+            std::uint64_t leaf_time = 0;
+            for (std::size_t i = leaf; i < leaf + my_leaf_size; ++i) {
+                leaf_time += my_array[i].time_ns.load(std::memory_order_relaxed);
+                my_array[i].presplit = 0;
+            }
+            // Presplitting is useless without other threads and too expensive for cheap leaves
+            std::uint64_t ratio = leaf_time / mean;
+            if (my_size > factor && leaf_time >= 2 * min_leaf_time_ns && ratio >= skew_ratio) {
+                my_array[leaf].presplit = static_cast<unsigned char>(std::min<std::uint64_t>(ratio, max_presplit));
+            }
+        }
+    }
+
+    //! Prepares the history for the next invocation of an algorithm.
+    void prepare() {
+        resize(factor);
+        if (my_has_history) {
+            learn();
+        }
+        for (std::size_t i = 0; i < my_size; ++i) {
+            my_array[i].time_ns.store(0, std::memory_order_relaxed);
+        }
+        my_has_history = true;
+    }
+
+    void reset() {
+        resize(0);
+    }
+};
+#endif // __TBB_PREVIEW_LEARNING_PARTITIONER
+
+#if __TBB_PREVIEW_LEARNING_PARTITIONER
+class learning_partition_type : public dynamic_grainsize_mode<linear_affinity_mode<learning_partition_type> > {
+    using base_type = dynamic_grainsize_mode<linear_affinity_mode<learning_partition_type> >;
+    using position = learning_partitioner_base::position;
+
+    position* my_array;
+    std::size_t my_leaf_size;
+    //! Number of pieces to offer to other threads before checking for demand
+    unsigned my_presplit{0};
+    bool my_presplit_loaded{false};
+
+    //! Takes the presplit count once the task owns a leaf position.
+    void load_presplit() {
+        if (!my_presplit_loaded && my_divisor && my_divisor <= my_leaf_size) {
+            my_presplit_loaded = true;
+            my_presplit = my_array[my_head].presplit;
+            my_max_depth += depth_t(my_presplit);
+        }
+    }
+public:
+    static const unsigned factor = learning_partitioner_base::factor;
+    typedef detail::proportional_split split_type;
+    learning_partition_type( learning_partitioner_base& lp ) {
+        lp.prepare();
+        my_array = lp.my_array;
+        my_leaf_size = lp.my_leaf_size;
+        my_max_depth = lp.my_pool_depth;
+        __TBB_ASSERT( my_max_depth < __TBB_RANGE_POOL_CAPACITY, nullptr );
+        load_presplit();
+    }
+    learning_partition_type(learning_partition_type& p, split)
+        : base_type(p, split())
+        , my_array(p.my_array)
+        , my_leaf_size(p.my_leaf_size)
+    {
+        load_presplit();
+        p.load_presplit();
+    }
+    learning_partition_type(learning_partition_type& p, const proportional_split& split_obj)
+        : base_type(p, split_obj)
+        , my_array(p.my_array)
+        , my_leaf_size(p.my_leaf_size)
+    {
+        load_presplit();
+        p.load_presplit();
+    }
+    template <typename Task>
+    bool check_for_demand(Task& t) {
+        if (my_presplit) {
+            --my_presplit;
+            return true;
+        }
+        if (pass == my_delay) {
+            if (my_divisor > my_leaf_size) // produce tasks down to the learned leaf size
+                return true;
+            else if (my_divisor && my_max_depth) { // make balancing task
+                my_divisor = 0;
+                return true;
+            }
+            else if (tree_node::is_peer_stolen(t)) {
+                my_max_depth += __TBB_DEMAND_DEPTH_ADD;
+                return true;
+            }
+        } else if (begin == my_delay) {
+            my_delay = pass;
+        }
+        return false;
+    }
+    //! Measures the time the task spends in its part of the range.
+    template<typename StartType, typename Range>
+    void work_balance(StartType &start, Range &range, execution_data& ed) {
+        std::size_t head = my_head;
+        std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+        base_type::work_balance(start, range, ed);
+        std::chrono::steady_clock::duration elapsed = std::chrono::steady_clock::now() - t0;
+        my_array[head].time_ns.fetch_add(
+            std::uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()), std::memory_order_relaxed);
+    }
+    void note_affinity(slot_id id) {
+        if( my_divisor )
+            my_array[my_head].affinity = id;
+    }
+    void spawn_task(task& t, task_group_context& ctx) {
+        if (my_divisor) {
+            slot_id id = my_array[my_head].affinity;
+            spawn(t, ctx, id == no_slot ? slot_id(my_head / factor) : id);
+        } else {
+            spawn(t, ctx);
+        }
+    }
+};
+#endif // __TBB_PREVIEW_LEARNING_PARTITIONER
+
 //! A simple partitioner
 /** Divides the range until the range is not divisible.
     @ingroup algorithms */
@@ -654,6 +879,29 @@ private:
     typedef affinity_partition_type::split_type split_type;
 };
 
+#if __TBB_PREVIEW_LEARNING_PARTITIONER
+//! A partitioner that learns from the previous invocations
+/** Like affinity_partitioner, it replays the mapping of the range parts to threads. In addition,
+    it records the time spent in every part and uses it in the next invocation to make the leaf
+    tasks of cheap loops larger and to offer the parts of expensive leaves to other threads
+    without waiting for the demand. The object must be reused across invocations over the same
+    range to be useful, and must not be used by several algorithms at the same time.
+    @ingroup algorithms */
+class learning_partitioner : learning_partitioner_base {
+public:
+    learning_partitioner() {}
+
+    //! Forgets the recorded history
+    void reset() { learning_partitioner_base::reset(); }
+
+private:
+    template<typename Range, typename Body, typename Partitioner> friend struct start_for;
+    template<typename Range, typename Body, typename Partitioner> friend struct start_reduce;
+    typedef learning_partition_type task_partition_type;
+    typedef learning_partition_type::split_type split_type;
+};
+#endif // __TBB_PREVIEW_LEARNING_PARTITIONER
+
 } // namespace d1
 } // namespace detail
 
@@ -663,6 +911,9 @@ using detail::d1::auto_partitioner;
 using detail::d1::simple_partitioner;
 using detail::d1::static_partitioner;
 using detail::d1::affinity_partitioner;
+#if __TBB_PREVIEW_LEARNING_PARTITIONER
+using detail::d1::learning_partitioner;
+#endif
 // Split types
 using detail::split;
 using detail::proportional_split;
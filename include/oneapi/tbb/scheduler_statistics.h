@@ -0,0 +1,190 @@
+/*
+    Copyright (c) 2024 Intel Corporation
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#ifndef __TBB_scheduler_statistics_H
+#define __TBB_scheduler_statistics_H
+
+#include "detail/_config.h"
+#include "detail/_namespace_injection.h"
+
+#if !__TBB_PREVIEW_SCHEDULER_STATISTICS
+    #error Set TBB_PREVIEW_SCHEDULER_STATISTICS to include scheduler_statistics.h
+#endif
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace tbb {
+namespace detail {
+
+namespace d1 {
+
+//! Work stealing counters of a thread
+/** The counters are accumulated over the lifetime of the thread in all arenas. **/
+struct steal_statistics {
+    //! Number of the attempts to take a task from another thread
+    std::uint64_t attempts = 0;
+    //! Number of the attempts that have taken at least one task
+    std::uint64_t successes = 0;
+    //! Number of the attempts that have found no task to take
+    std::uint64_t failures = 0;
+    //! Number of the taken tasks; exceeds successes if a thief can take several tasks at once
+    std::uint64_t tasks_stolen = 0;
+    //! Number of the successful attempts whose victim shared the L2 or the last level cache with the thief
+    std::uint64_t cache_local_steals = 0;
+};
+
+//! Counters of the small object pool that allocates the tasks of a thread
+/** The counters are accumulated over the lifetime of the thread. **/
+struct small_object_pool_statistics {
+    //! Number of the allocations that have reused an object freed by the thread
+    std::uint64_t local_allocations = 0;
+    //! Number of the allocations that have taken the objects returned by other threads
+    std::uint64_t remote_allocations = 0;
+    //! Number of the allocations that have requested the memory from the memory allocator
+    std::uint64_t new_allocations = 0;
+    //! Number of the objects allocated and deallocated by the thread
+    std::uint64_t local_deallocations = 0;
+    //! Number of the objects allocated by other threads and deallocated by the thread
+    std::uint64_t remote_deallocations = 0;
+    //! Number of the batches in which the thread has returned the objects to the other threads
+    std::uint64_t remote_batches = 0;
+    //! Approximate number of the objects returned by other threads and not reused yet
+    std::uint64_t public_list_length = 0;
+};
+
+//! Activity counters of the task scheduler or of an arena
+/** The counters of the tasks and the time only grow. The global counters include the destroyed arenas. **/
+struct scheduler_metrics {
+    //! Number of the worker threads that work in the arenas now
+    std::size_t active_workers = 0;
+    //! Number of the worker threads that are not needed by any arena; always zero for an arena
+    std::size_t sleeping_workers = 0;
+    //! Number of the worker threads that the arenas request now
+    std::size_t requested_workers = 0;
+    //! Number of the worker threads that the arenas are given now according to their priorities and weights
+    std::size_t allotted_workers = 0;
+    //! Number of the spawned tasks
+    std::uint64_t tasks_spawned = 0;
+    //! Number of the tasks taken from the other threads
+    std::uint64_t tasks_stolen = 0;
+    //! Number of the tasks with affinity taken from the mailboxes of the threads they were mailed to
+    std::uint64_t mailbox_tasks_executed = 0;
+    //! Time in nanoseconds that the worker threads have spent spinning in search of work
+    std::uint64_t worker_spin_time = 0;
+    //! Number of the times a thread blocked in an arena has been woken up
+    std::uint64_t monitor_wakeups = 0;
+    //! Number of the times a worker thread has joined an arena on request and taken a task
+    std::uint64_t worker_wakeups = 0;
+    //! Number of the times a worker thread has joined an arena and left it without taking a task
+    std::uint64_t empty_worker_wakeups = 0;
+    //! Total time in nanoseconds from the requests for workers to the first tasks taken by the joined workers
+    std::uint64_t worker_wakeup_latency = 0;
+    //! Maximal time in nanoseconds from a request for workers to the first task taken by a joined worker
+    std::uint64_t max_worker_wakeup_latency = 0;
+    //! Number of the coroutine stacks of the resumable tasks taken from the global cache; always zero for an arena
+    std::uint64_t coroutine_stack_hits = 0;
+    //! Number of the coroutine stacks allocated because the global cache had none of the size; always zero for an arena
+    std::uint64_t coroutine_stack_misses = 0;
+    //! Number of the times the memory of an idle cached coroutine stack was returned to the system; always zero for an arena
+    std::uint64_t trimmed_coroutine_stacks = 0;
+    //! Number of the coroutine stacks in the global cache now; always zero for an arena
+    std::size_t cached_coroutine_stacks = 0;
+};
+
+class task_arena_base;
+
+} // namespace d1
+
+namespace r1 {
+TBB_EXPORT void __TBB_EXPORTED_FUNC get_thread_steal_statistics(d1::steal_statistics& stats);
+TBB_EXPORT std::size_t __TBB_EXPORTED_FUNC fill_steal_statistics(d1::steal_statistics* buffer, std::size_t size);
+TBB_EXPORT void __TBB_EXPORTED_FUNC get_thread_small_object_pool_statistics(d1::small_object_pool_statistics& stats);
+TBB_EXPORT std::size_t __TBB_EXPORTED_FUNC fill_small_object_pool_statistics(d1::small_object_pool_statistics* buffer, std::size_t size);
+TBB_EXPORT void __TBB_EXPORTED_FUNC get_scheduler_metrics(d1::scheduler_metrics& metrics);
+TBB_EXPORT void __TBB_EXPORTED_FUNC get_arena_metrics(const d1::task_arena_base& ta, d1::scheduler_metrics& metrics);
+} // namespace r1
+
+namespace d1 {
+
+//! Returns the work stealing counters of the calling thread
+inline steal_statistics this_thread_steal_statistics() {
+    steal_statistics stats;
+    r1::get_thread_steal_statistics(stats);
+    return stats;
+}
+
+//! Returns the work stealing counters of every thread known to the library, including the worker threads
+inline std::vector<steal_statistics> threads_steal_statistics() {
+    std::vector<steal_statistics> stats;
+    std::size_t num_threads = r1::fill_steal_statistics(nullptr, 0);
+    // Threads can join the library while the statistics are being collected
+    do {
+        stats.resize(num_threads);
+        num_threads = r1::fill_steal_statistics(stats.data(), stats.size());
+    } while (num_threads > stats.size());
+    stats.resize(num_threads);
+    return stats;
+}
+
+//! Returns the counters of the small object pool of the calling thread
+inline small_object_pool_statistics this_thread_small_object_pool_statistics() {
+    small_object_pool_statistics stats;
+    r1::get_thread_small_object_pool_statistics(stats);
+    return stats;
+}
+
+//! Returns the counters of the small object pools of every thread known to the library, including the worker threads
+inline std::vector<small_object_pool_statistics> threads_small_object_pool_statistics() {
+    std::vector<small_object_pool_statistics> stats;
+    std::size_t num_threads = r1::fill_small_object_pool_statistics(nullptr, 0);
+    // Threads can join the library while the statistics are being collected
+    do {
+        stats.resize(num_threads);
+        num_threads = r1::fill_small_object_pool_statistics(stats.data(), stats.size());
+    } while (num_threads > stats.size());
+    stats.resize(num_threads);
+    return stats;
+}
+
+//! Returns the activity counters of all arenas and the state of the worker threads
+inline scheduler_metrics global_scheduler_metrics() {
+    scheduler_metrics metrics;
+    r1::get_scheduler_metrics(metrics);
+    return metrics;
+}
+
+} // namespace d1
+} // namespace detail
+
+inline namespace v1 {
+using detail::d1::steal_statistics;
+using detail::d1::small_object_pool_statistics;
+using detail::d1::scheduler_metrics;
+
+namespace info {
+using detail::d1::this_thread_steal_statistics;
+using detail::d1::threads_steal_statistics;
+using detail::d1::this_thread_small_object_pool_statistics;
+using detail::d1::threads_small_object_pool_statistics;
+using detail::d1::global_scheduler_metrics;
+} // namespace info
+} // namespace v1
+
+} // namespace tbb
+
+#endif /* __TBB_scheduler_statistics_H */
@@ -0,0 +1,55 @@
+/*
+    Copyright (c) 2024 Intel Corporation
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#ifndef __TBB_scheduler_tracing_H
+#define __TBB_scheduler_tracing_H
+
+#include "detail/_config.h"
+#include "detail/_namespace_injection.h"
+
+#if !__TBB_PREVIEW_SCHEDULER_TRACING
+    #error Set TBB_PREVIEW_SCHEDULER_TRACING to include scheduler_tracing.h
+#endif
+
+#include "global_control.h"
+
+namespace tbb {
+namespace detail {
+
+namespace r1 {
+TBB_EXPORT bool __TBB_EXPORTED_FUNC dump_scheduler_trace(const char* file_name);
+} // namespace r1
+
+namespace d1 {
+
+//! Writes the scheduler events recorded by all threads to the file in the Chrome trace event format
+/** The events are recorded while global_control::scheduler_tracing is set to a non-zero value
+    or, if there is no such control, while the TBB_SCHEDULER_TRACING environment variable is set to 1.
+    Each thread keeps only its latest events. Returns false if the file cannot be written. **/
+inline bool dump_scheduler_trace(const char* file_name) {
+    return r1::dump_scheduler_trace(file_name);
+}
+
+} // namespace d1
+} // namespace detail
+
+inline namespace v1 {
+using detail::d1::dump_scheduler_trace;
+} // namespace v1
+
+} // namespace tbb
+
+#endif /* __TBB_scheduler_tracing_H */
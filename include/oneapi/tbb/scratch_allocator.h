@@ -0,0 +1,98 @@
+/*
+    Copyright (c) 2024 Intel Corporation
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#ifndef __TBB_scratch_allocator_H
+#define __TBB_scratch_allocator_H
+
+#include "detail/_config.h"
+#include "detail/_namespace_injection.h"
+
+#if !__TBB_PREVIEW_SCRATCH_ALLOCATOR
+    #error Set TBB_PREVIEW_SCRATCH_ALLOCATOR to include scratch_allocator.h
+#endif
+
+#include "detail/_task.h"
+
+#include <cstddef>
+#include <type_traits>
+
+namespace tbb {
+namespace detail {
+
+namespace r1 {
+TBB_EXPORT void* __TBB_EXPORTED_FUNC scratch_allocate(std::size_t size, std::size_t alignment);
+TBB_EXPORT void* __TBB_EXPORTED_FUNC scratch_allocate(const d1::execution_data& ed, std::size_t size, std::size_t alignment);
+} // namespace r1
+
+namespace d1 {
+
+//! Allocates the memory that is released when the execution of the current task completes
+/** The memory is taken by bumping a pointer in the chunks of the current thread and is never freed
+    separately. Inside task_arena::execute, it is released when the functor returns. **/
+inline void* scratch_allocate(std::size_t size, std::size_t alignment = alignof(std::max_align_t)) {
+    return r1::scratch_allocate(size, alignment);
+}
+
+//! Allocates the scratch memory of the task that is executed with the execution data
+inline void* scratch_allocate(const execution_data& ed, std::size_t size, std::size_t alignment = alignof(std::max_align_t)) {
+    return r1::scratch_allocate(ed, size, alignment);
+}
+
+//! The allocator of the scratch memory of the current task
+/** The deallocation does nothing, so the containers that use the allocator shall not outlive
+    the execution of the task that creates them. **/
+template<typename T>
+class scratch_allocator {
+public:
+    using value_type = T;
+    using propagate_on_container_move_assignment = std::true_type;
+
+    //! Always defined for TBB containers (supported since C++17 for std containers)
+    using is_always_equal = std::true_type;
+
+    scratch_allocator() = default;
+    template<typename U> scratch_allocator(const scratch_allocator<U>&) noexcept {}
+
+    //! Allocate space for n objects.
+    __TBB_nodiscard T* allocate(std::size_t n) {
+        return static_cast<T*>(r1::scratch_allocate(n * sizeof(value_type), alignof(value_type)));
+    }
+
+    //! The memory is released with the other scratch memory of the task.
+    void deallocate(T*, std::size_t) {}
+};
+
+template<typename T, typename U>
+inline bool operator==(const scratch_allocator<T>&, const scratch_allocator<U>&) noexcept { return true; }
+
+#if !__TBB_CPP20_COMPARISONS_PRESENT
+template<typename T, typename U>
+inline bool operator!=(const scratch_allocator<T>&, const scratch_allocator<U>&) noexcept { return false; }
+#endif
+
+} // namespace d1
+} // namespace detail
+
+inline namespace v1 {
+using detail::d1::scratch_allocator;
+
+namespace this_task_arena {
+using detail::d1::scratch_allocate;
+} // namespace this_task_arena
+} // namespace v1
+} // namespace tbb
+
+#endif /* __TBB_scratch_allocator_H */
@@ -32,6 +32,14 @@
 #include "info.h"
 #endif /*__TBB_ARENA_BINDING*/
 
+#if __TBB_PREVIEW_SCHEDULER_STATISTICS
+#include "scheduler_statistics.h"
+#endif
+
+#if __TBB_PREVIEW_TASK_DEADLINES
+#include <chrono>
+#endif
+
 namespace tbb {
 namespace detail {
 
@@ -95,12 +103,28 @@ TBB_EXPORT void __TBB_EXPORTED_FUNC isolate_within_arena(d1::delegate_base& d, s
 TBB_EXPORT void __TBB_EXPORTED_FUNC enqueue(d1::task&, d1::task_arena_base*);
 TBB_EXPORT void __TBB_EXPORTED_FUNC enqueue(d1::task&, d1::task_group_context&, d1::task_arena_base*);
 TBB_EXPORT void __TBB_EXPORTED_FUNC submit(d1::task&, d1::task_group_context&, arena*, std::uintptr_t);
+
+#if __TBB_PREVIEW_TASK_ARENA_RESIZING
+TBB_EXPORT void __TBB_EXPORTED_FUNC set_max_concurrency(d1::task_arena_base&, int, unsigned);
+#endif
+#if __TBB_PREVIEW_TASK_ARENA_WEIGHTS
+TBB_EXPORT void __TBB_EXPORTED_FUNC set_arena_weight(d1::task_arena_base&, unsigned);
+TBB_EXPORT unsigned __TBB_EXPORTED_FUNC arena_weight(const d1::task_arena_base&);
+#endif
+#if __TBB_PREVIEW_TASK_DEADLINES
+TBB_EXPORT void __TBB_EXPORTED_FUNC enqueue_with_deadline(d1::task&, d1::task_arena_base*, std::uint64_t);
+#endif
 } // namespace r1
 
 namespace d2 {
 inline void enqueue_impl(task_handle&& th, d1::task_arena_base* ta) {
     __TBB_ASSERT(th != nullptr, "Attempt to schedule empty task_handle");
 
+#if __TBB_PREVIEW_TASK_DEPENDENCIES
+    // The last predecessor would spawn the task into its own arena rather than enqueue it into the given one
+    __TBB_ASSERT(!task_handle_accessor::has_predecessors(th), "A task with predecessors cannot be enqueued");
+#endif
+
     auto& ctx = task_handle_accessor::ctx_of(th);
 
     // Do not access th after release
@@ -112,6 +136,9 @@ namespace d1 {
 
 static constexpr unsigned num_priority_levels = 3;
 static constexpr int priority_stride = INT_MAX / (num_priority_levels + 1);
+//! The weight of an arena unless it is changed, see task_arena::set_weight
+static constexpr unsigned default_arena_weight = 1;
+static constexpr unsigned max_arena_weight = 1 << 16;
 
 class task_arena_base {
     friend struct r1::task_arena_impl;
@@ -165,10 +192,12 @@ protected:
     enum {
         default_flags = 0
         , core_type_support_flag = 1
+        , resizable_flag = 2
+        , initial_flags = default_flags | core_type_support_flag
     };
 
     task_arena_base(int max_concurrency, unsigned reserved_for_masters, priority a_priority)
-        : my_version_and_traits(default_flags | core_type_support_flag)
+        : my_version_and_traits(initial_flags)
         , my_initialization_state(do_once_state::uninitialized)
         , my_arena(nullptr)
         , my_max_concurrency(max_concurrency)
@@ -181,7 +210,7 @@ protected:
 
 #if __TBB_ARENA_BINDING
     task_arena_base(const constraints& constraints_, unsigned reserved_for_masters, priority a_priority)
-        : my_version_and_traits(default_flags | core_type_support_flag)
+        : my_version_and_traits(initial_flags)
         , my_initialization_state(do_once_state::uninitialized)
         , my_arena(nullptr)
         , my_max_concurrency(constraints_.max_concurrency)
@@ -196,6 +225,12 @@ public:
     //! Typedef for number of threads that is automatic.
     static const int automatic = -1;
     static const int not_initialized = -2;
+#if __TBB_PREVIEW_TASK_ARENA_WEIGHTS
+    //! The weight of an arena unless it is changed
+    static const unsigned default_weight = default_arena_weight;
+    //! The greatest weight of an arena
+    static const unsigned max_weight = max_arena_weight;
+#endif
 };
 
 template<typename R, typename F>
@@ -232,6 +267,27 @@ void enqueue_impl(F&& f, task_arena_base* ta) {
     small_object_allocator alloc{};
     r1::enqueue(*alloc.new_object<enqueue_task<typename std::decay<F>::type>>(std::forward<F>(f), alloc), ta);
 }
+
+#if __TBB_PREVIEW_TASK_DEADLINES
+//! Converts the deadline into nanoseconds since the epoch of the steady clock
+inline std::uint64_t deadline_to_nanoseconds(std::chrono::steady_clock::time_point deadline) {
+    auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(deadline.time_since_epoch()).count();
+    return ns > 0 ? std::uint64_t(ns) : 0;
+}
+
+//! Converts the latency into the deadline counted from now
+template<typename Rep, typename Period>
+std::chrono::steady_clock::time_point latency_to_deadline(const std::chrono::duration<Rep, Period>& latency) {
+    return std::chrono::steady_clock::now() + std::chrono::duration_cast<std::chrono::steady_clock::duration>(latency);
+}
+
+template<typename F>
+void enqueue_impl(F&& f, task_arena_base* ta, std::chrono::steady_clock::time_point deadline) {
+    small_object_allocator alloc{};
+    r1::enqueue_with_deadline(*alloc.new_object<enqueue_task<typename std::decay<F>::type>>(std::forward<F>(f), alloc), ta,
+                              deadline_to_nanoseconds(deadline));
+}
+#endif
 /** 1-to-1 proxy representation class of scheduler's arena
  * Constructors set up settings only, real construction is deferred till the first method invocation
  * Destructor only removes one of the references to the inner arena representation.
@@ -252,6 +308,28 @@ class task_arena : public task_arena_base {
         return func.consume_result();
     }
 public:
+#if __TBB_PREVIEW_TASK_ARENA_RESIZING
+    //! Specifies up to which concurrency an initialized arena can grow, see set_max_concurrency
+    enum class resizing_policy {
+        //! Up to the concurrency the arena was initialized with
+        fixed,
+        //! Up to the default concurrency of the constraints of the arena, for which the slots are preallocated
+        growable
+    };
+
+private:
+    void set_resizing_policy(resizing_policy a_resizing) {
+        if (a_resizing == resizing_policy::growable) {
+            my_version_and_traits |= resizable_flag;
+        }
+    }
+
+    void copy_resizing_policy(const task_arena& s) {
+        my_version_and_traits |= s.my_version_and_traits & resizable_flag;
+    }
+public:
+#endif
+
     //! Creates task_arena with certain concurrency limits
     /** Sets up settings only, real construction is deferred till the first method invocation
      *  @arg max_concurrency specifies total number of slots in arena where threads work
@@ -263,6 +341,16 @@ public:
         : task_arena_base(max_concurrency_, reserved_for_masters, a_priority)
     {}
 
+#if __TBB_PREVIEW_TASK_ARENA_RESIZING
+    //! Creates task_arena with certain concurrency limits and the resizing policy
+    task_arena(int max_concurrency_, unsigned reserved_for_masters, priority a_priority,
+               resizing_policy a_resizing)
+        : task_arena_base(max_concurrency_, reserved_for_masters, a_priority)
+    {
+        set_resizing_policy(a_resizing);
+    }
+#endif
+
 #if __TBB_ARENA_BINDING
     //! Creates task arena pinned to certain NUMA node
     task_arena(const constraints& constraints_, unsigned reserved_for_masters = 1,
@@ -270,6 +358,16 @@ public:
         : task_arena_base(constraints_, reserved_for_masters, a_priority)
     {}
 
+#if __TBB_PREVIEW_TASK_ARENA_RESIZING
+    //! Creates task arena pinned to certain NUMA node with the resizing policy
+    task_arena(const constraints& constraints_, unsigned reserved_for_masters, priority a_priority,
+               resizing_policy a_resizing)
+        : task_arena_base(constraints_, reserved_for_masters, a_priority)
+    {
+        set_resizing_policy(a_resizing);
+    }
+#endif
+
     //! Copies settings from another task_arena
     task_arena(const task_arena &s) // copy settings but not the reference or instance
         : task_arena_base(
@@ -279,12 +377,20 @@ public:
                 .set_core_type(s.my_core_type)
                 .set_max_threads_per_core(s.my_max_threads_per_core)
             , s.my_num_reserved_slots, s.my_priority)
-    {}
+    {
+#if __TBB_PREVIEW_TASK_ARENA_RESIZING
+        copy_resizing_policy(s);
+#endif
+    }
 #else
     //! Copies settings from another task_arena
     task_arena(const task_arena& a) // copy settings but not the reference or instance
         : task_arena_base(a.my_max_concurrency, a.my_num_reserved_slots, a.my_priority)
-    {}
+    {
+#if __TBB_PREVIEW_TASK_ARENA_RESIZING
+        copy_resizing_policy(a);
+#endif
+    }
 #endif /*__TBB_ARENA_BINDING*/
 
     //! Tag class used to indicate the "attaching" constructor
@@ -379,6 +485,47 @@ public:
         return my_initialization_state.load(std::memory_order_acquire) == do_once_state::initialized;
     }
 
+#if __TBB_PREVIEW_TASK_ARENA_RESIZING
+    //! Changes the concurrency level and the number of slots reserved for external threads
+    /** The initialized arena grows up to the limit of its resizing policy and shrinks without
+        waiting: the threads in excess leave the arena after finishing their current tasks.
+        Not thread safe wrt concurrent invocations of other methods. **/
+    void set_max_concurrency(int max_concurrency_, unsigned reserved_for_masters = 1) {
+        if (is_active()) {
+            r1::set_max_concurrency(*this, max_concurrency_, reserved_for_masters);
+        } else {
+            my_max_concurrency = max_concurrency_;
+            my_num_reserved_slots = reserved_for_masters;
+        }
+    }
+#endif
+
+#if __TBB_PREVIEW_TASK_ARENA_WEIGHTS
+    //! Sets the share of the arena in the worker threads, initializing the arena if needed
+    /** Under contention, the arenas of the same priority get the workers in proportion to their
+        weights multiplied by their demands. The weight is clamped to [1, max_weight]. **/
+    void set_weight(unsigned weight_) {
+        initialize();
+        r1::set_arena_weight(*this, weight_);
+    }
+
+    //! Returns the share of the arena in the worker threads
+    unsigned weight() const {
+        return is_active() ? r1::arena_weight(*this) : default_weight;
+    }
+#endif
+
+#if __TBB_PREVIEW_SCHEDULER_STATISTICS
+    //! Returns the activity counters of the arena; the counters are zero if the arena is not active
+    scheduler_metrics metrics() const {
+        scheduler_metrics result;
+        if (is_active()) {
+            r1::get_arena_metrics(*this, result);
+        }
+        return result;
+    }
+#endif
+
     //! Enqueues a task into the arena to process a functor, and immediately returns.
     //! Does not require the calling thread to join the arena
 
@@ -395,6 +542,22 @@ public:
         d2::enqueue_impl(std::move(th), this);
     }
 
+#if __TBB_PREVIEW_TASK_DEADLINES
+    //! Enqueues a task into the arena to process a functor before the deadline, and immediately returns.
+    //! The task goes ahead of the enqueued tasks without deadlines and of the tasks with later deadlines.
+    template<typename F>
+    void enqueue(F&& f, std::chrono::steady_clock::time_point deadline) {
+        initialize();
+        enqueue_impl(std::forward<F>(f), this, deadline);
+    }
+
+    //! Enqueues a task into the arena to process a functor within the latency, and immediately returns.
+    template<typename F, typename Rep, typename Period>
+    void enqueue(F&& f, const std::chrono::duration<Rep, Period>& latency) {
+        enqueue(std::forward<F>(f), latency_to_deadline(latency));
+    }
+#endif
+
     //! Joins the arena and executes a mutable functor, then returns
     //! If not possible to join, wraps the functor into a task, enqueues it and waits for task completion
     //! Can decrement the arena demand for workers, causing a worker to leave and free a slot to the calling thread
@@ -472,6 +635,18 @@ inline void enqueue(F&& f) {
     enqueue_impl(std::forward<F>(f), nullptr);
 }
 
+#if __TBB_PREVIEW_TASK_DEADLINES
+template<typename F>
+inline void enqueue(F&& f, std::chrono::steady_clock::time_point deadline) {
+    enqueue_impl(std::forward<F>(f), nullptr, deadline);
+}
+
+template<typename F, typename Rep, typename Period>
+inline void enqueue(F&& f, const std::chrono::duration<Rep, Period>& latency) {
+    enqueue_impl(std::forward<F>(f), nullptr, latency_to_deadline(latency));
+}
+#endif
+
 using r1::submit;
 
 } // namespace d1
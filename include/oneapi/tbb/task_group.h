@@ -86,13 +86,15 @@ class function_task : public task_handle_task  {
 private:
     d1::task* execute(d1::execution_data& ed) override {
         __TBB_ASSERT(ed.context == &this->ctx(), "The task group context should be used for all tasks");
+#if __TBB_PREVIEW_TASK_DEPENDENCIES
+        task* res = is_discarded() ? nullptr : task_ptr_or_nullptr(m_func);
+#else
         task* res = task_ptr_or_nullptr(m_func);
-        finalize(&ed);
-        return res;
+#endif
+        return complete(&ed, res);
     }
     d1::task* cancel(d1::execution_data& ed) override {
-        finalize(&ed);
-        return nullptr;
+        return complete(&ed, nullptr);
     }
 public:
     template<typename FF>
@@ -106,7 +108,7 @@ namespace {
     template<typename F>
     d1::task* task_ptr_or_nullptr_impl(std::false_type, F&& f){
         task_handle th = std::forward<F>(f)();
-        return task_handle_accessor::release(th);
+        return task_handle_accessor::submit(th);
     }
 
     template<typename F>
@@ -438,6 +440,11 @@ class structured_task_group;
 #if TBB_PREVIEW_ISOLATED_TASK_GROUP
 class isolated_task_group;
 #endif
+#if __TBB_PREVIEW_COROUTINES && __TBB_CPP20_COROUTINES_PRESENT
+template <typename T>
+class coro_task;
+struct wait_vertex_accessor;
+#endif
 
 template <typename F>
 class function_stack_task : public d1::task {
@@ -463,6 +470,9 @@ public:
 };
 
 class task_group_base : no_copy {
+#if __TBB_PREVIEW_COROUTINES && __TBB_CPP20_COROUTINES_PRESENT
+    friend struct wait_vertex_accessor;
+#endif
 protected:
     d1::wait_context_vertex m_wait_vertex;
     d1::task_group_context m_context;
@@ -488,9 +498,15 @@ protected:
         using acs = d2::task_handle_accessor;
         __TBB_ASSERT(&acs::ctx_of(h) == &context(), "Attempt to schedule task_handle into different task_group");
 
+        // The task that waits for its predecessors is spawned by the last of them
+        d1::task* t = acs::submit(h);
         bool cancellation_status = false;
         try_call([&] {
-            execute_and_wait(*acs::release(h), context(), m_wait_vertex.get_context(), context());
+            if (t) {
+                execute_and_wait(*t, context(), m_wait_vertex.get_context(), context());
+            } else {
+                d1::wait(m_wait_vertex.get_context(), context());
+            }
         }).on_completion([&] {
             // TODO: the reset method is not thread-safe. Ensure the correct behavior.
             cancellation_status = context().is_group_execution_cancelled();
@@ -581,15 +597,37 @@ public:
         using acs = d2::task_handle_accessor;
         __TBB_ASSERT(&acs::ctx_of(h) == &context(), "Attempt to schedule task_handle into different task_group");
 
-        d1::spawn(*acs::release(h), context());
+        if (d1::task* t = acs::submit(h)) {
+            d1::spawn(*t, context());
+        }
     }
 
+#if __TBB_PREVIEW_COROUTINES && __TBB_CPP20_COROUTINES_PRESENT
+    //! Spawns the coroutine as a task of the group; the group is complete when the coroutine is
+    template<typename T>
+    void run(coro_task<T>&& c) {
+        c.run_in(*this);
+    }
+#endif
+
     template<typename F>
     d2::task_handle defer(F&& f) {
         return prepare_task_handle(std::forward<F>(f));
 
     }
 
+#if __TBB_PREVIEW_TASK_DEPENDENCIES
+    //! Makes the successor wait for the completion of the predecessor
+    /** Neither task can be submitted yet, and both tasks must belong to the same task group.
+        The successor is executed after it is submitted and all its predecessors complete; the thread
+        that completes the last of them executes it next, in the arena of that thread, so the successor
+        cannot be submitted with task_arena::enqueue. If the handle of the predecessor is destroyed,
+        the thread that destroys it spawns the ready successors into its own arena. **/
+    static void set_task_order(d2::task_handle& predecessor, d2::task_handle& successor) {
+        d2::task_handle_accessor::add_edge(predecessor, successor);
+    }
+#endif
+
     template<typename F>
     task_group_status run_and_wait(const F& f) {
         return internal_run_and_wait(f);
@@ -660,8 +698,10 @@ public:
         using acs = d2::task_handle_accessor;
         __TBB_ASSERT(&acs::ctx_of(h) == &context(), "Attempt to schedule task_handle into different task_group");
 
-        spawn_delegate sd(acs::release(h), context());
-        r1::isolate_within_arena(sd, this_isolation());
+        if (d1::task* t = acs::submit(h)) {
+            spawn_delegate sd(t, context());
+            r1::isolate_within_arena(sd, this_isolation());
+        }
     }
 
     template<typename F>
@@ -0,0 +1,149 @@
+/*
+    Copyright (c) 2024 Intel Corporation
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#ifndef __TBB_weighted_blocked_range_H
+#define __TBB_weighted_blocked_range_H
+
+#if ! TBB_PREVIEW_WEIGHTED_BLOCKED_RANGE
+    #error Set TBB_PREVIEW_WEIGHTED_BLOCKED_RANGE to include weighted_blocked_range.h
+#endif
+
+#include "detail/_range_common.h"
+#include "detail/_namespace_injection.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
+namespace tbb {
+namespace detail {
+namespace d1 {
+
+//! A range of indices that is split by the total weight of the iterations instead of their number.
+/** The weights are given as a non-decreasing sequence of prefix sums: the weight of the index \c i
+    is <tt>prefix[i + 1] - prefix[i]</tt>, so the sequence must be valid for all indices of [begin,end].
+    The row pointers of a matrix in the CSR format are an example of such a sequence.
+    The grain size is measured in the units of weight.
+    @ingroup algorithms */
+template <typename Value, typename PrefixIterator>
+class weighted_blocked_range {
+public:
+    using const_iterator = Value;
+
+    //! Type for size of a range
+    using size_type = std::size_t;
+
+    //! Type of the weight of a range
+    using weight_type = typename std::iterator_traits<PrefixIterator>::value_type;
+
+    static_assert(std::is_integral<Value>::value, "weighted_blocked_range requires an integral index type");
+
+    //! Construct range over half-open interval [begin,end) with the weights given by prefix and the given grainsize.
+    weighted_blocked_range( Value begin_, Value end_, PrefixIterator prefix, weight_type grainsize_ = weight_type(1) ) :
+        my_end(end_), my_begin(begin_), my_prefix(prefix), my_grainsize(grainsize_)
+    {
+        __TBB_ASSERT( my_grainsize > weight_type(0), "grainsize must be positive" );
+    }
+
+    //! Beginning of range.
+    const_iterator begin() const { return my_begin; }
+
+    //! One past last value in range.
+    const_iterator end() const { return my_end; }
+
+    //! Number of indices in the range
+    size_type size() const {
+        __TBB_ASSERT( !(end() < begin()), "size() unspecified if end()<begin()" );
+        return size_type(my_end - my_begin);
+    }
+
+    //! Total weight of the indices in the range
+    weight_type weight() const { return my_prefix[my_end] - my_prefix[my_begin]; }
+
+    //! The grain size for this range, in the units of weight.
+    weight_type grainsize() const { return my_grainsize; }
+
+    //! The sequence of prefix sums of the weights.
+    PrefixIterator prefix() const { return my_prefix; }
+
+    //------------------------------------------------------------------------
+    // Methods that implement Range concept
+    //------------------------------------------------------------------------
+
+    //! True if range is empty.
+    bool empty() const { return !(my_begin < my_end); }
+
+    //! True if range contains more than one index and is heavier than the grain size.
+    bool is_divisible() const { return size() > 1 && my_grainsize < weight(); }
+
+    //! Split range into two parts of about the same weight.
+    /** The new Range *this has the second part, the old range r has the first part. */
+    weighted_blocked_range( weighted_blocked_range& r, split ) :
+        my_end(r.my_end),
+        my_begin(do_split(r, 1, 1)),
+        my_prefix(r.my_prefix),
+        my_grainsize(r.my_grainsize)
+    {}
+
+    //! Split range so that the weights of the parts follow the specified proportion.
+    /** The new Range *this has the second part, the old range r has the first part. */
+    weighted_blocked_range( weighted_blocked_range& r, proportional_split& proportion ) :
+        my_end(r.my_end),
+        my_begin(do_split(r, proportion.left(), proportion.right())),
+        my_prefix(r.my_prefix),
+        my_grainsize(r.my_grainsize)
+    {}
+
+private:
+    /** NOTE: my_end MUST be declared before my_begin, otherwise the splitting constructor will break. */
+    Value my_end;
+    Value my_begin;
+    PrefixIterator my_prefix;
+    weight_type my_grainsize;
+
+    //! Finds the index where the prefix sum is closest to the weight of the left part.
+    /** Both parts keep at least one index. */
+    static Value do_split( weighted_blocked_range& r, std::size_t left, std::size_t right ) {
+        __TBB_ASSERT( r.is_divisible(), "cannot split weighted_blocked_range that is not divisible" );
+        const weight_type first = r.my_prefix[r.my_begin];
+        // Floating point arithmetic is accurate enough to balance the work; the exact position is
+        // found in the prefix sums anyway
+        const weight_type target = first + weight_type(double(r.weight()) * double(left) / double(left + right));
+
+        PrefixIterator lo = r.my_prefix + (r.my_begin + 1);
+        PrefixIterator hi = r.my_prefix + r.my_end;
+        PrefixIterator it = std::lower_bound(lo, hi, target);
+        // Take the previous position if it is closer to the target
+        if (it == hi || (it != lo && target - *(it - 1) < *it - target)) {
+            --it;
+        }
+        Value middle = Value(it - r.my_prefix);
+        __TBB_ASSERT( r.my_begin < middle && middle < r.my_end, "weighted_blocked_range has been split incorrectly" );
+        return r.my_end = middle;
+    }
+};
+
+} // namespace d1
+} // namespace detail
+
+inline namespace v1 {
+using detail::d1::weighted_blocked_range;
+} // namespace v1
+
+} // namespace tbb
+
+#endif /* __TBB_weighted_blocked_range_H */
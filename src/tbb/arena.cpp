@@ -23,6 +23,7 @@
 #include "waiters.h"
 #include "oneapi/tbb/detail/_task.h"
 #include "oneapi/tbb/info.h"
+#include "oneapi/tbb/scheduler_statistics.h"
 #include "oneapi/tbb/tbb_allocator.h"
 
 #include <atomic>
@@ -166,24 +167,71 @@ std::size_t arena::occupy_free_slot_in_range( thread_data& tls, std::size_t lowe
 template <bool as_worker>
 std::size_t arena::occupy_free_slot(thread_data& tls) {
     // Firstly, external threads try to occupy reserved slots
-    std::size_t index = as_worker ? out_of_arena : occupy_free_slot_in_range( tls,  0, my_num_reserved_slots );
+    std::size_t num_reserved_slots = my_num_reserved_slots.load(std::memory_order_relaxed);
+    std::size_t index = as_worker ? out_of_arena : occupy_free_slot_in_range( tls,  0, num_reserved_slots );
     if ( index == out_of_arena ) {
         // Secondly, all threads try to occupy all non-reserved slots
-        index = occupy_free_slot_in_range(tls, my_num_reserved_slots, my_num_slots );
+        index = occupy_free_slot_in_range(tls, num_reserved_slots, my_num_active_slots.load(std::memory_order_relaxed) );
         // Likely this arena is already saturated
         if ( index == out_of_arena )
             return out_of_arena;
     }
 
     atomic_update( my_limit, (unsigned)(index + 1), std::less<unsigned>() );
+    // The thieves prefer the victims sharing a cache with them, so let them know where the thread runs
+    note_cache_domains(my_slots[index]);
     return index;
 }
 
+void arena::collect_victims(unsigned arena_index) {
+    arena_slot& own_slot = my_slots[arena_index];
+    // Read before the domains, so the domains changed during the collection cause another one
+    const unsigned epoch = my_cache_domains_epoch.load(std::memory_order_acquire);
+    if (own_slot.my_victims == nullptr) {
+        own_slot.my_victims = static_cast<unsigned*>(
+            cache_aligned_allocate(arena_slot::num_cache_levels * my_num_slots * sizeof(unsigned)));
+    }
+    for (unsigned level = 0; level < arena_slot::num_cache_levels; ++level) {
+        const int domain = own_slot.cache_domain(level);
+        unsigned* victims = own_slot.my_victims + level * my_num_slots;
+        unsigned num_victims = 0;
+        if (domain >= 0) {
+            for (unsigned k = 0; k < my_num_slots; ++k) {
+                if (k != arena_index && my_slots[k].cache_domain(level) == domain) {
+                    victims[num_victims++] = k;
+                }
+            }
+        }
+        own_slot.my_num_victims[level] = num_victims;
+    }
+    own_slot.my_victims_epoch = epoch;
+}
+
 std::uintptr_t arena::calculate_stealing_threshold() {
     stack_anchor_type anchor;
     return r1::calculate_stealing_threshold(reinterpret_cast<std::uintptr_t>(&anchor), my_threading_control->worker_stack_size());
 }
 
+void arena::collect_metrics(d1::scheduler_metrics& metrics) const {
+    metrics.active_workers += num_workers_active();
+    metrics.requested_workers += my_num_workers_requested.load(std::memory_order_relaxed);
+    metrics.allotted_workers += my_num_workers_allotted.load(std::memory_order_relaxed);
+    for (unsigned i = 0; i < my_num_slots; ++i) {
+        // The counters are modified concurrently by the threads occupying the slots
+        const slot_counters& counters = my_slots[i].my_counters;
+        metrics.tasks_spawned += counters.tasks_spawned.load(std::memory_order_relaxed);
+        metrics.tasks_stolen += counters.tasks_stolen.load(std::memory_order_relaxed);
+        metrics.mailbox_tasks_executed += counters.mailbox_tasks_executed.load(std::memory_order_relaxed);
+        metrics.worker_spin_time += counters.worker_spin_time.load(std::memory_order_relaxed);
+        metrics.monitor_wakeups += counters.monitor_wakeups.load(std::memory_order_relaxed);
+        metrics.worker_wakeups += counters.worker_wakeups.load(std::memory_order_relaxed);
+        metrics.empty_worker_wakeups += counters.empty_worker_wakeups.load(std::memory_order_relaxed);
+        metrics.worker_wakeup_latency += counters.worker_wakeup_latency.load(std::memory_order_relaxed);
+        metrics.max_worker_wakeup_latency = max(metrics.max_worker_wakeup_latency,
+            counters.max_worker_wakeup_latency.load(std::memory_order_relaxed));
+    }
+}
+
 void arena::process(thread_data& tls) {
     governor::set_thread_data(tls); // TODO: consider moving to create_one_job.
     __TBB_ASSERT( is_alive(my_guard), nullptr);
@@ -195,8 +243,9 @@ void arena::process(thread_data& tls) {
         return;
     }
 
-    __TBB_ASSERT( index >= my_num_reserved_slots, "Workers cannot occupy reserved slots" );
     tls.attach_arena(*this, index);
+    // The latency is measured from the latest request for workers to the first task taken in the arena
+    tls.my_worker_request_time = my_worker_request_time.load(std::memory_order_relaxed);
     // worker thread enters the dispatch loop to look for a work
     tls.my_inbox.set_is_idle(true);
     if (tls.my_arena_slot->is_task_pool_published()) {
@@ -213,6 +262,8 @@ void arena::process(thread_data& tls) {
     // Waiting on special object tied to this arena
     outermost_worker_waiter waiter(*this);
     d1::task* t = tls.my_task_dispatcher->local_wait_for_all(nullptr, waiter);
+    // The worker can sleep for a long time after leaving the arena
+    tls.my_small_object_pool->flush_remote_batches();
     // For purposes of affinity support, the slot's mailbox is considered idle while no thread is
     // attached to it.
     tls.my_inbox.set_is_idle(true);
@@ -220,6 +271,10 @@ void arena::process(thread_data& tls) {
     __TBB_ASSERT_EX(t == nullptr, "Outermost worker must not leave dispatch loop with a task");
     __TBB_ASSERT(governor::is_thread_data_set(&tls), nullptr);
     __TBB_ASSERT(tls.my_task_dispatcher == &task_disp, nullptr);
+    if (tls.my_worker_request_time != 0) {
+        increase_counter(tls.my_arena_slot->my_counters.empty_worker_wakeups, 1);
+        tls.my_worker_request_time = 0;
+    }
 
     my_observers.notify_exit_observers(tls.my_last_observer, tls.my_is_worker);
     tls.my_last_observer = nullptr;
@@ -241,21 +296,25 @@ void arena::process(thread_data& tls) {
     __TBB_ASSERT(tls.my_arena == this, "my_arena is used as a hint when searching the arena to join");
 }
 
-arena::arena(threading_control* control, unsigned num_slots, unsigned num_reserved_slots, unsigned priority_level) {
+arena::arena(threading_control* control, unsigned num_slots, unsigned num_reserved_slots, unsigned priority_level,
+             unsigned max_num_slots) {
     __TBB_ASSERT( !my_guard, "improperly allocated arena?" );
     __TBB_ASSERT( sizeof(my_slots[0]) % cache_line_size()==0, "arena::slot size not multiple of cache line size" );
     __TBB_ASSERT( is_aligned(this, cache_line_size()), "arena misaligned" );
     my_threading_control = control;
     my_limit = 1;
     // Two slots are mandatory: for the external thread, and for 1 worker (required to support starvation resistant tasks).
-    my_num_slots = num_arena_slots(num_slots, num_reserved_slots);
+    my_num_active_slots = num_arena_slots(num_slots, num_reserved_slots);
+    my_num_slots = max(my_num_active_slots.load(std::memory_order_relaxed), max_num_slots);
     my_num_reserved_slots = num_reserved_slots;
     my_max_num_workers = num_slots-num_reserved_slots;
     my_priority_level = priority_level;
+    my_weight = d1::default_arena_weight;
     my_references = ref_external; // accounts for the external thread
+    my_cache_domains_epoch.store(1, std::memory_order_relaxed);
     my_observers.my_arena = this;
     my_co_cache.init(4 * num_slots);
-    __TBB_ASSERT ( my_max_num_workers <= my_num_slots, nullptr);
+    __TBB_ASSERT ( my_max_num_workers.load(std::memory_order_relaxed) <= my_num_slots, nullptr);
     // Initialize the default context. It should be allocated before task_dispatch construction.
     my_default_ctx = new (cache_aligned_allocate(sizeof(d1::task_group_context)))
         d1::task_group_context{ d1::task_group_context::isolated, d1::task_group_context::fp_settings };
@@ -267,10 +326,12 @@ arena::arena(threading_control* control, unsigned num_slots, unsigned num_reserv
         __TBB_ASSERT( !my_slots[i].my_task_pool_size, nullptr);
         mailbox(i).construct();
         my_slots[i].init_task_streams(i);
+        my_slots[i].init_cache_domains();
         my_slots[i].my_default_task_dispatcher = new(base_td_pointer + i) task_dispatcher(this);
         my_slots[i].my_is_occupied.store(false, std::memory_order_relaxed);
     }
     my_fifo_task_stream.initialize(my_num_slots);
+    my_deadline_task_stream.initialize(my_num_slots);
     my_resume_task_stream.initialize(my_num_slots);
 #if __TBB_PREVIEW_CRITICAL_TASKS
     my_critical_task_stream.initialize(my_num_slots);
@@ -279,18 +340,19 @@ arena::arena(threading_control* control, unsigned num_slots, unsigned num_reserv
 }
 
 arena& arena::allocate_arena(threading_control* control, unsigned num_slots, unsigned num_reserved_slots,
-                              unsigned priority_level)
+                              unsigned priority_level, unsigned max_num_slots)
 {
     __TBB_ASSERT( sizeof(base_type) + sizeof(arena_slot) == sizeof(arena), "All arena data fields must go to arena_base" );
     __TBB_ASSERT( sizeof(base_type) % cache_line_size() == 0, "arena slots area misaligned: wrong padding" );
     __TBB_ASSERT( sizeof(mail_outbox) == max_nfs_size, "Mailbox padding is wrong" );
-    std::size_t n = allocation_size(num_arena_slots(num_slots, num_reserved_slots));
+    unsigned num_allocated_slots = max(num_arena_slots(num_slots, num_reserved_slots), max_num_slots);
+    std::size_t n = allocation_size(num_allocated_slots);
     unsigned char* storage = (unsigned char*)cache_aligned_allocate(n);
     // Zero all slots to indicate that they are empty
     std::memset( storage, 0, n );
 
-    return *new( storage + num_arena_slots(num_slots, num_reserved_slots) * sizeof(mail_outbox) )
-        arena(control, num_slots, num_reserved_slots, priority_level);
+    return *new( storage + num_allocated_slots * sizeof(mail_outbox) )
+        arena(control, num_slots, num_reserved_slots, priority_level, max_num_slots);
 }
 
 void arena::free_arena () {
@@ -311,10 +373,12 @@ void arena::free_arena () {
         // __TBB_ASSERT( my_slots[i].task_pool == EmptyTaskPool, nullptr);
         __TBB_ASSERT( my_slots[i].head == my_slots[i].tail, nullptr); // TODO: replace by is_quiescent_local_task_pool_empty
         my_slots[i].free_task_pool();
+        my_slots[i].free_victims();
         mailbox(i).drain();
         my_slots[i].my_default_task_dispatcher->~task_dispatcher();
     }
     __TBB_ASSERT(my_fifo_task_stream.empty(), "Not all enqueued tasks were executed");
+    __TBB_ASSERT(my_deadline_task_stream.empty(), "Not all enqueued tasks were executed");
     __TBB_ASSERT(my_resume_task_stream.empty(), "Not all enqueued tasks were executed");
     // Cleanup coroutines/schedulers cache
     my_co_cache.cleanup();
@@ -336,7 +400,50 @@ void arena::free_arena () {
 }
 
 bool arena::has_enqueued_tasks() {
-    return !my_fifo_task_stream.empty();
+    return !my_fifo_task_stream.empty() || !my_deadline_task_stream.empty();
+}
+
+void arena::ramp_up_workers() {
+    unsigned limit = my_worker_request_limit.load(std::memory_order_relaxed);
+    unsigned max_num_workers = my_max_num_workers.load(std::memory_order_relaxed);
+    // Of the threads finding tasks concurrently, only one requests each next group of workers.
+    // Doubling the limit takes the lock of the resource manager a logarithmic number of times.
+    if (limit < max_num_workers &&
+        my_worker_request_limit.compare_exchange_strong(limit, min(max(2 * limit, 1u), max_num_workers)))
+    {
+        my_worker_request_time.store(counters_time_stamp(), std::memory_order_relaxed);
+        // The request is not changed, but the resource manager applies the new limit to it
+        request_workers(/* mandatory_delta = */ 0, /* workers_delta = */ 0);
+    }
+}
+
+unsigned arena::set_concurrency(unsigned num_slots, unsigned num_reserved_slots) {
+    // The arena cannot grow beyond the allocated slots
+    num_slots = min(num_slots, my_num_slots);
+    num_reserved_slots = min(num_reserved_slots, num_slots);
+    if (num_arena_slots(num_slots, num_reserved_slots) > my_num_slots) {
+        // The single slot of the arena cannot be reserved, see num_arena_slots
+        num_reserved_slots = 0;
+    }
+    __TBB_ASSERT(num_arena_slots(num_slots, num_reserved_slots) <= my_num_slots, nullptr);
+
+    // The threads occupying the slots out of the new range leave them after finishing their tasks
+    my_num_active_slots.store(num_arena_slots(num_slots, num_reserved_slots), std::memory_order_relaxed);
+    my_num_reserved_slots.store(num_reserved_slots, std::memory_order_relaxed);
+    my_max_num_workers.store(num_slots - num_reserved_slots, std::memory_order_relaxed);
+    if (my_worker_request_limit.load(std::memory_order_relaxed) > num_slots - num_reserved_slots) {
+        my_worker_request_limit.store(num_slots - num_reserved_slots, std::memory_order_relaxed);
+    }
+    // Recalculate the request with the new number of workers. The market recalls the workers in
+    // excess, and they leave the arena at the next task boundary.
+    request_workers(/* mandatory_delta = */ 0, /* workers_delta = */ 0, /* wakeup_threads = */ true);
+    return num_slots;
+}
+
+void arena::set_weight(unsigned weight) {
+    my_weight.store(clamp(weight, 1u, d1::max_arena_weight), std::memory_order_relaxed);
+    // The resource manager shares the workers anew
+    request_workers(/* mandatory_delta = */ 0, /* workers_delta = */ 0);
 }
 
 void arena::request_workers(int mandatory_delta, int workers_delta, bool wakeup_threads) {
@@ -372,12 +479,7 @@ void arena::out_of_work() {
 
     if (disable_mandatory || release_workers) {
         int mandatory_delta = disable_mandatory ? -1 : 0;
-        int workers_delta = release_workers ? -(int)my_max_num_workers : 0;
-
-        if (disable_mandatory && is_arena_workerless()) {
-            // We had set workers_delta to 1 when enabled mandatory concurrency, so revert it now
-            workers_delta = -1;
-        }
+        int workers_delta = release_workers ? -(int)my_num_slots : 0;
         request_workers(mandatory_delta, workers_delta);
     }
 }
@@ -424,9 +526,22 @@ std::pair<int, int> arena::update_request(int mandatory_delta, int workers_delta
 
     // Calculate max request
     my_total_num_workers_requested += workers_delta;
-    // Clamp worker request into interval [0, my_max_num_workers]
-    max_workers_request = clamp(my_total_num_workers_requested, 0,
-        min_workers_request > 0 && is_arena_workerless() ? 1 : (int)my_max_num_workers);
+    // The request of the task pool is my_num_slots, and it is greater than the number of slots released
+    // by the external threads, see my_total_num_workers_requested
+    bool is_pool_requested = my_total_num_workers_requested > 0;
+    int released_slots = my_total_num_workers_requested - (is_pool_requested ? (int)my_num_slots : 0);
+    unsigned max_num_workers = my_max_num_workers.load(std::memory_order_relaxed);
+    if (min_workers_request > 0 && max_num_workers == 0) {
+        // The workerless arena needs a worker for the enqueued tasks if it has a free slot
+        max_workers_request = clamp(1 + released_slots, 0, 1);
+    } else {
+        // Request only as many workers as there are tasks for, see advertise_new_work
+        unsigned request_limit = max(my_worker_request_limit.load(std::memory_order_relaxed), unsigned(min_workers_request));
+        // Clamp worker request into interval [0, min(my_max_num_workers, request_limit)]
+        max_workers_request = clamp((is_pool_requested ? (int)max_num_workers : 0) + released_slots, 0,
+            (int)min(max_num_workers, request_limit));
+    }
+    my_num_workers_requested.store(max_workers_request, std::memory_order_relaxed);
 
     return { min_workers_request, max_workers_request };
 }
@@ -435,19 +550,27 @@ thread_control_monitor& arena::get_waiting_threads_monitor() {
     return my_threading_control->get_waiting_threads_monitor();
 }
 
-void arena::enqueue_task(d1::task& t, d1::task_group_context& ctx, thread_data& td) {
+void arena::enqueue_task(d1::task& t, d1::task_group_context& ctx, thread_data& td, std::uint64_t deadline) {
     task_group_context_impl::bind_to(ctx, &td);
     task_accessor::context(t) = &ctx;
     task_accessor::isolation(t) = no_isolation;
-    my_fifo_task_stream.push( &t, random_lane_selector(td.my_random) );
+    if (deadline != no_deadline) {
+        my_deadline_task_stream.push( &t, deadline, random_lane_selector(td.my_random) );
+    } else {
+        my_fifo_task_stream.push( &t, random_lane_selector(td.my_random) );
+    }
     advertise_new_work<work_enqueued>();
+    // The enqueued tasks can wait for the workers that are busy in other arenas, so they request more
+    // workers regardless of the threads finding them
+    try_ramp_up_workers();
 }
 
-arena& arena::create(threading_control* control, unsigned num_slots, unsigned num_reserved_slots, unsigned arena_priority_level, d1::constraints constraints) {
+arena& arena::create(threading_control* control, unsigned num_slots, unsigned num_reserved_slots, unsigned arena_priority_level,
+                     d1::constraints constraints, unsigned max_num_slots) {
     __TBB_ASSERT(num_slots > 0, NULL);
     __TBB_ASSERT(num_reserved_slots <= num_slots, NULL);
     // Add public market reference for an external thread/task_arena (that adds an internal reference in exchange).
-    arena& a = arena::allocate_arena(control, num_slots, num_reserved_slots, arena_priority_level);
+    arena& a = arena::allocate_arena(control, num_slots, num_reserved_slots, arena_priority_level, max_num_slots);
     a.my_tc_client = control->create_client(a);
     // We should not publish arena until all fields are initialized
     control->publish_client(a.my_tc_client, constraints);
@@ -498,8 +621,12 @@ struct task_arena_impl {
     static void execute(d1::task_arena_base&, d1::delegate_base&);
     static void wait(d1::task_arena_base&);
     static int max_concurrency(const d1::task_arena_base*);
-    static void enqueue(d1::task&, d1::task_group_context*, d1::task_arena_base*);
+    static void enqueue(d1::task&, d1::task_group_context*, d1::task_arena_base*, std::uint64_t deadline = no_deadline);
     static d1::slot_id execution_slot(const d1::task_arena_base&);
+    static void get_metrics(const d1::task_arena_base&, d1::scheduler_metrics&);
+    static void set_max_concurrency(d1::task_arena_base&, int, unsigned);
+    static void set_weight(d1::task_arena_base&, unsigned);
+    static unsigned weight(const d1::task_arena_base&);
 };
 
 void __TBB_EXPORTED_FUNC initialize(d1::task_arena_base& ta) {
@@ -530,10 +657,31 @@ void __TBB_EXPORTED_FUNC enqueue(d1::task& t, d1::task_group_context& ctx, d1::t
     task_arena_impl::enqueue(t, &ctx, ta);
 }
 
+void __TBB_EXPORTED_FUNC enqueue_with_deadline(d1::task& t, d1::task_arena_base* ta, std::uint64_t deadline) {
+    // The greatest value is reserved for the tasks without deadlines
+    task_arena_impl::enqueue(t, nullptr, ta, deadline == no_deadline ? deadline - 1 : deadline);
+}
+
 d1::slot_id __TBB_EXPORTED_FUNC execution_slot(const d1::task_arena_base& arena) {
     return task_arena_impl::execution_slot(arena);
 }
 
+void __TBB_EXPORTED_FUNC get_arena_metrics(const d1::task_arena_base& ta, d1::scheduler_metrics& metrics) {
+    task_arena_impl::get_metrics(ta, metrics);
+}
+
+void __TBB_EXPORTED_FUNC set_max_concurrency(d1::task_arena_base& ta, int max_concurrency, unsigned reserved_for_masters) {
+    task_arena_impl::set_max_concurrency(ta, max_concurrency, reserved_for_masters);
+}
+
+void __TBB_EXPORTED_FUNC set_arena_weight(d1::task_arena_base& ta, unsigned weight) {
+    task_arena_impl::set_weight(ta, weight);
+}
+
+unsigned __TBB_EXPORTED_FUNC arena_weight(const d1::task_arena_base& ta) {
+    return task_arena_impl::weight(ta);
+}
+
 void task_arena_impl::initialize(d1::task_arena_base& ta) {
     // Enforce global market initialization to properly initialize soft limit
     (void)governor::get_thread_data();
@@ -546,17 +694,26 @@ void task_arena_impl::initialize(d1::task_arena_base& ta) {
         .set_numa_id(ta.my_numa_id);
 #endif /*__TBB_ARENA_BINDING*/
 
-    if (ta.my_max_concurrency < 1) {
+    bool is_resizable = (ta.my_version_and_traits & d1::task_arena_base::resizable_flag) != 0;
+    unsigned default_num_slots = 0;
+    if (ta.my_max_concurrency < 1 || is_resizable) {
 #if __TBB_ARENA_BINDING
-        ta.my_max_concurrency = (int)default_concurrency(arena_constraints);
+        default_num_slots = default_concurrency(arena_constraints);
 #else /*!__TBB_ARENA_BINDING*/
-        ta.my_max_concurrency = (int)governor::default_num_threads();
+        default_num_slots = governor::default_num_threads();
 #endif /*!__TBB_ARENA_BINDING*/
     }
+    if (ta.my_max_concurrency < 1) {
+        ta.my_max_concurrency = (int)default_num_slots;
+    }
+    // The slots of a resizable arena are allocated for all threads available to it,
+    // two slots at least to allow reserving a slot after the arena has been created
+    unsigned max_num_slots = is_resizable ? max(default_num_slots, 2u) : 0;
 
 #if __TBB_CPUBIND_PRESENT
     numa_binding_observer* observer = construct_binding_observer(
-        static_cast<d1::task_arena*>(&ta), arena::num_arena_slots(ta.my_max_concurrency, ta.my_num_reserved_slots),
+        static_cast<d1::task_arena*>(&ta),
+        max(arena::num_arena_slots(ta.my_max_concurrency, ta.my_num_reserved_slots), max_num_slots),
         ta.my_numa_id, ta.core_type(), ta.max_threads_per_core());
     if (observer) {
         // TODO: Consider lazy initialization for internal arena so
@@ -568,7 +725,8 @@ void task_arena_impl::initialize(d1::task_arena_base& ta) {
     __TBB_ASSERT(ta.my_arena.load(std::memory_order_relaxed) == nullptr, "Arena already initialized");
     unsigned priority_level = arena_priority_level(ta.my_priority);
     threading_control* thr_control = threading_control::register_public_reference();
-    arena& a = arena::create(thr_control, unsigned(ta.my_max_concurrency), ta.my_num_reserved_slots, priority_level, arena_constraints);
+    arena& a = arena::create(thr_control, unsigned(ta.my_max_concurrency), ta.my_num_reserved_slots, priority_level,
+                             arena_constraints, max_num_slots);
 
     ta.my_arena.store(&a, std::memory_order_release);
 #if __TBB_CPUBIND_PRESENT
@@ -597,10 +755,10 @@ bool task_arena_impl::attach(d1::task_arena_base& ta) {
         // It's still used by s, so won't be destroyed right away.
         __TBB_ASSERT(a->my_references > 0, nullptr);
         a->my_references += arena::ref_external;
-        ta.my_num_reserved_slots = a->my_num_reserved_slots;
+        ta.my_num_reserved_slots = a->my_num_reserved_slots.load(std::memory_order_relaxed);
         ta.my_priority = arena_priority(a->my_priority_level);
-        ta.my_max_concurrency = ta.my_num_reserved_slots + a->my_max_num_workers;
-        __TBB_ASSERT(arena::num_arena_slots(ta.my_max_concurrency, ta.my_num_reserved_slots) == a->my_num_slots, nullptr);
+        ta.my_max_concurrency = ta.my_num_reserved_slots + a->my_max_num_workers.load(std::memory_order_relaxed);
+        __TBB_ASSERT(arena::num_arena_slots(ta.my_max_concurrency, ta.my_num_reserved_slots) <= a->my_num_slots, nullptr);
         ta.my_arena.store(a, std::memory_order_release);
         // increases threading_control's ref count for task_arena
         threading_control::register_public_reference();
@@ -609,7 +767,7 @@ bool task_arena_impl::attach(d1::task_arena_base& ta) {
     return false;
 }
 
-void task_arena_impl::enqueue(d1::task& t, d1::task_group_context* c, d1::task_arena_base* ta) {
+void task_arena_impl::enqueue(d1::task& t, d1::task_group_context* c, d1::task_arena_base* ta, std::uint64_t deadline) {
     thread_data* td = governor::get_thread_data();  // thread data is only needed for FastRandom instance
     assert_pointer_valid(td, "thread_data pointer should not be null");
     arena* a = ta ?
@@ -622,7 +780,7 @@ void task_arena_impl::enqueue(d1::task& t, d1::task_group_context* c, d1::task_a
     // Is there a better place for checking the state of ctx?
      __TBB_ASSERT(!a->my_default_ctx->is_group_execution_cancelled(),
                   "The task will not be executed because its task_group_context is cancelled.");
-     a->enqueue_task(t, *ctx, *td);
+     a->enqueue_task(t, *ctx, *td, deadline);
 }
 
 d1::slot_id task_arena_impl::execution_slot(const d1::task_arena_base& ta) {
@@ -654,7 +812,8 @@ public:
 
             // If the calling thread occupies the slots out of external thread reserve we need to notify the
             // market that this arena requires one worker less.
-            if (td.my_arena_index >= td.my_arena->my_num_reserved_slots) {
+            m_is_worker_slot_occupied = td.my_arena_index >= td.my_arena->my_num_reserved_slots.load(std::memory_order_relaxed);
+            if (m_is_worker_slot_occupied) {
                 td.my_arena->request_workers(/* mandatory_delta = */ 0, /* workers_delta = */ -1);
             }
 
@@ -664,6 +823,7 @@ public:
         }
 
         m_task_dispatcher = td.my_task_dispatcher;
+        m_scratch_mark = m_task_dispatcher->m_scratch_arena.enter_scope();
         m_orig_fifo_tasks_allowed = m_task_dispatcher->allow_fifo_task(true);
         m_orig_critical_task_allowed = m_task_dispatcher->m_properties.critical_task_allowed;
         m_task_dispatcher->m_properties.critical_task_allowed = true;
@@ -682,6 +842,7 @@ public:
     ~nested_arena_context() {
         thread_data& td = *m_task_dispatcher->m_thread_data;
         __TBB_ASSERT(governor::is_thread_data_set(&td), nullptr);
+        m_task_dispatcher->m_scratch_arena.leave_scope(m_scratch_mark);
         m_task_dispatcher->allow_fifo_task(m_orig_fifo_tasks_allowed);
         m_task_dispatcher->m_properties.critical_task_allowed = m_orig_critical_task_allowed;
         if (m_orig_arena) {
@@ -690,7 +851,7 @@ public:
 
             // Notify the market that this thread releasing a one slot
             // that can be used by a worker thread.
-            if (td.my_arena_index >= td.my_arena->my_num_reserved_slots) {
+            if (m_is_worker_slot_occupied) {
                 td.my_arena->request_workers(/* mandatory_delta = */ 0, /* workers_delta = */ 1);
             }
 
@@ -710,10 +871,13 @@ private:
     arena*              m_orig_arena{ nullptr };
     observer_proxy*     m_orig_last_observer{ nullptr };
     task_dispatcher*    m_task_dispatcher{ nullptr };
+    char*               m_scratch_mark{ nullptr };
     unsigned            m_orig_slot_index{};
     bool                m_orig_fifo_tasks_allowed{};
     bool                m_orig_critical_task_allowed{};
     bool                m_orig_is_thread_registered{};
+    // The number of reserved slots can change while the thread is in the arena
+    bool                m_is_worker_slot_occupied{};
 };
 
 class delegated_task : public d1::task {
@@ -834,7 +998,7 @@ void task_arena_impl::wait(d1::task_arena_base& ta) {
     thread_data* td = governor::get_thread_data();
     __TBB_ASSERT_EX(td, "Scheduler is not initialized");
     __TBB_ASSERT(td->my_arena != a || td->my_arena_index == 0, "internal_wait is not supported within a worker context" );
-    if (a->my_max_num_workers != 0) {
+    if (a->my_max_num_workers.load(std::memory_order_relaxed) != 0) {
         while (a->num_workers_active() || !a->is_empty()) {
             yield();
         }
@@ -851,10 +1015,11 @@ int task_arena_impl::max_concurrency(const d1::task_arena_base *ta) {
     if( a ) { // Get parameters from the arena
         __TBB_ASSERT( !ta || ta->my_max_concurrency==1, nullptr);
         int mandatory_worker = 0;
-        if (a->is_arena_workerless() && a->my_num_reserved_slots == 1) {
+        unsigned num_reserved_slots = a->my_num_reserved_slots.load(std::memory_order_relaxed);
+        if (a->is_arena_workerless() && num_reserved_slots == 1) {
             mandatory_worker = a->my_mandatory_concurrency.test() ? 1 : 0;
         }
-        return a->my_num_reserved_slots + a->my_max_num_workers + mandatory_worker;
+        return num_reserved_slots + a->my_max_num_workers.load(std::memory_order_relaxed) + mandatory_worker;
     }
 
     if (ta && ta->my_max_concurrency == 1) {
@@ -875,6 +1040,33 @@ int task_arena_impl::max_concurrency(const d1::task_arena_base *ta) {
     return int(governor::default_num_threads());
 }
 
+void task_arena_impl::get_metrics(const d1::task_arena_base& ta, d1::scheduler_metrics& metrics) {
+    metrics = d1::scheduler_metrics{};
+    if (arena* a = ta.my_arena.load(std::memory_order_acquire)) {
+        a->collect_metrics(metrics);
+    }
+}
+
+void task_arena_impl::set_max_concurrency(d1::task_arena_base& ta, int max_concurrency, unsigned reserved_for_masters) {
+    arena* a = ta.my_arena.load(std::memory_order_acquire);
+    assert_pointer_valid(a, "The arena should be initialized");
+    // The automatic concurrency is all allocated slots
+    unsigned num_slots = max_concurrency < 1 ? a->my_num_slots : unsigned(max_concurrency);
+    ta.my_max_concurrency = (int)a->set_concurrency(num_slots, reserved_for_masters);
+    ta.my_num_reserved_slots = a->my_num_reserved_slots.load(std::memory_order_relaxed);
+}
+
+void task_arena_impl::set_weight(d1::task_arena_base& ta, unsigned weight) {
+    arena* a = ta.my_arena.load(std::memory_order_acquire);
+    assert_pointer_valid(a, "The arena should be initialized");
+    a->set_weight(weight);
+}
+
+unsigned task_arena_impl::weight(const d1::task_arena_base& ta) {
+    arena* a = ta.my_arena.load(std::memory_order_acquire);
+    return a ? a->weight() : d1::default_arena_weight;
+}
+
 void isolate_within_arena(d1::delegate_base& d, std::intptr_t isolation) {
     // TODO: Decide what to do if the scheduler is not initialized. Is there a use case for it?
     thread_data* tls = governor::get_thread_data();
@@ -28,6 +28,7 @@
 #include "intrusive_list.h"
 #include "task_stream.h"
 #include "arena_slot.h"
+#include "scheduler_tracing.h"
 #include "rml_tbb.h"
 #include "mailbox.h"
 #include "governor.h"
@@ -38,6 +39,11 @@
 
 namespace tbb {
 namespace detail {
+
+namespace d1 {
+struct scheduler_metrics;
+}
+
 namespace r1 {
 
 class task_dispatcher;
@@ -203,6 +209,10 @@ struct arena_base : padded<intrusive_list_node> {
         - the enqueuing thread does not call any of wait_for_all methods. **/
     task_stream<front_accessor> my_fifo_task_stream; // heavy use in stealing loop
 
+    //! Task pool for the enqueued tasks with deadlines.
+    /** The tasks are taken in the order of their deadlines before the other enqueued tasks. **/
+    deadline_task_stream my_deadline_task_stream; // heavy use in stealing loop
+
     //! Task pool for the tasks scheduled via tbb::resume() function.
     task_stream<front_accessor> my_resume_task_stream; // heavy use in stealing loop
 
@@ -215,18 +225,40 @@ struct arena_base : padded<intrusive_list_node> {
     task_stream<back_nonnull_accessor> my_critical_task_stream;
 #endif
 
-    //! The total number of workers that are requested from the resource manager.
+    //! The sum of the requests for workers made by the task pool and the external threads.
+    /** The task pool requests my_num_slots workers while it is not empty, an external thread occupying
+        a non-reserved slot releases one worker. update_request converts the sum into the number of
+        workers, so the sum does not depend on the concurrency of the arena that can be changed. **/
     int my_total_num_workers_requested;
 
     //! The index in the array of per priority lists of arenas this object is in.
     /*const*/ unsigned my_priority_level;
 
+    //! The share of the arena in the workers relative to the other arenas of the same priority
+    std::atomic<unsigned> my_weight;
+
+    //! The number of workers requested from the resource manager, see update_request
+    std::atomic<unsigned> my_num_workers_requested;
+
     //! The max priority level of arena in permit manager.
     std::atomic<bool> my_is_top_priority{false};
 
     //! Current task pool state and estimate of available tasks amount.
     atomic_flag my_pool_state;
 
+    //! The maximal number of workers requested from the resource manager while the arena has work.
+    /** Set to the number of the active workers, at least one, when work appears in the empty arena,
+        and doubled every time a thread finds a task out of its own pool or a task is enqueued, so the
+        workers are woken up only when there is work for them. **/
+    std::atomic<unsigned> my_worker_request_limit;
+
+    //! The time of the latest request for more workers, see counters_time_stamp()
+    std::atomic<std::uint64_t> my_worker_request_time;
+
+    //! Changed every time a thread in the arena records new cache domains; always odd.
+    /** The threads recollect their victim lists when it changes, see arena::collect_victims. **/
+    std::atomic<unsigned> my_cache_domains_epoch;
+
     //! The list of local observers attached to this arena.
     observer_list my_observers;
 
@@ -255,10 +287,12 @@ struct arena_base : padded<intrusive_list_node> {
 
     //! The number of slots in the arena.
     unsigned my_num_slots;
+    //! The number of slots that threads can occupy; less than my_num_slots if the arena was shrunk.
+    std::atomic<unsigned> my_num_active_slots;
     //! The number of reserved slots (can be occupied only by external threads).
-    unsigned my_num_reserved_slots;
+    std::atomic<unsigned> my_num_reserved_slots;
     //! The number of workers requested by the external thread owning the arena.
-    unsigned my_max_num_workers;
+    std::atomic<unsigned> my_max_num_workers;
 
     threading_control_client my_tc_client;
 
@@ -281,13 +315,16 @@ public:
     };
 
     //! Constructor
-    arena(threading_control* control, unsigned max_num_workers, unsigned num_reserved_slots, unsigned priority_level);
+    arena(threading_control* control, unsigned max_num_workers, unsigned num_reserved_slots, unsigned priority_level,
+          unsigned max_num_slots);
 
     //! Allocate an instance of arena.
+    /** The slots are allocated for max_num_slots threads, so the concurrency can grow up to it. **/
     static arena& allocate_arena(threading_control* control, unsigned num_slots, unsigned num_reserved_slots,
-                                  unsigned priority_level);
+                                  unsigned priority_level, unsigned max_num_slots = 0);
 
-    static arena& create(threading_control* control, unsigned num_slots, unsigned num_reserved_slots, unsigned arena_priority_level, d1::constraints constraints = d1::constraints{});
+    static arena& create(threading_control* control, unsigned num_slots, unsigned num_reserved_slots, unsigned arena_priority_level,
+                         d1::constraints constraints = d1::constraints{}, unsigned max_num_slots = 0);
 
     static int unsigned num_arena_slots ( unsigned num_slots, unsigned num_reserved_slots ) {
         return num_reserved_slots == 0 ? num_slots : max(2u, num_slots);
@@ -319,6 +356,25 @@ public:
         return my_references.load(std::memory_order_acquire) >> ref_external_bits;
     }
 
+    //! Adds the active workers and the activity counters of the slots to the metrics
+    void collect_metrics(d1::scheduler_metrics& metrics) const;
+
+    //! Doubles the limit of the worker request if fewer workers than the arena can use are requested
+    void ramp_up_workers();
+
+    //! Requests more workers if the limit of the worker request is below the concurrency of the arena
+    /** Called when a thread finds a task out of its own pool and when a task is enqueued, but not
+        on the spawn path, since the new request takes the lock of the resource manager. **/
+    void try_ramp_up_workers() {
+        if (my_worker_request_limit.load(std::memory_order_relaxed) < my_max_num_workers.load(std::memory_order_relaxed)) {
+            ramp_up_workers();
+        }
+    }
+
+    //! Changes the concurrency within the allocated slots; returns the applied concurrency
+    /** The threads in excess leave the arena at the next task boundary. **/
+    unsigned set_concurrency(unsigned num_slots, unsigned num_reserved_slots);
+
     //! Check if the recall is requested by the market.
     bool is_recall_requested() const {
         return num_workers_active() > my_num_workers_allotted.load(std::memory_order_relaxed);
@@ -329,8 +385,23 @@ public:
     //! If necessary, raise a flag that there is new job in arena.
     template<arena::new_work_type work_type> void advertise_new_work();
 
-    //! Attempts to steal a task from a randomly chosen arena slot
-    d1::task* steal_task(unsigned arena_index, FastRandom& frnd, execution_data_ext& ed, isolation_type isolation);
+    //! Records the cache domains of the thread occupying the slot, invalidating the victim lists if they changed
+    void note_cache_domains(arena_slot& slot) {
+        if (slot.update_cache_domains()) {
+            // Incremented by two to skip zero that means the victims are not collected
+            my_cache_domains_epoch.fetch_add(2, std::memory_order_release);
+        }
+    }
+
+    //! Collects the slots sharing each cache domain with the thread occupying the slot
+    void collect_victims(unsigned arena_index);
+
+    //! Chooses the victim slot, preferring the threads that share a cache with the thief
+    std::size_t choose_victim(unsigned arena_index, std::size_t slot_num_limit, FastRandom& frnd);
+
+    //! Attempts to steal a task from an arena slot chosen by choose_victim
+    d1::task* steal_task(unsigned arena_index, FastRandom& frnd, execution_data_ext& ed, isolation_type isolation,
+                         steal_counters& counters, thread_tracer& tracer);
 
     //! Get a task from a global starvation resistant queue
     template<task_stream_accessor_type accessor>
@@ -345,7 +416,8 @@ public:
     void out_of_work();
 
     //! enqueue a task into starvation-resistance queue
-    void enqueue_task(d1::task&, d1::task_group_context&, thread_data&);
+    /** A task with a deadline goes into the deadline task stream. **/
+    void enqueue_task(d1::task&, d1::task_group_context&, thread_data&, std::uint64_t deadline = no_deadline);
 
     //! Registers the worker with the arena and enters TBB scheduler dispatch loop
     void process(thread_data&);
@@ -375,11 +447,16 @@ public:
 
     unsigned priority_level() { return my_priority_level; }
 
+    unsigned weight() const { return my_weight.load(std::memory_order_relaxed); }
+
+    //! Changes the share of the arena in the workers
+    void set_weight(unsigned weight);
+
     bool has_request() { return my_total_num_workers_requested; }
 
     unsigned references() const { return my_references.load(std::memory_order_acquire); }
 
-    bool is_arena_workerless() const { return my_max_num_workers == 0; }
+    bool is_arena_workerless() const { return my_max_num_workers.load(std::memory_order_relaxed) == 0; }
 
     void set_top_priority(bool);
 
@@ -412,7 +489,7 @@ void arena::advertise_new_work() {
         atomic_fence_seq_cst();
     }
 
-    if (work_type == work_enqueued && my_num_slots > my_num_reserved_slots) {
+    if (work_type == work_enqueued && my_num_active_slots.load(std::memory_order_relaxed) > my_num_reserved_slots.load(std::memory_order_relaxed)) {
         is_mandatory_needed = my_mandatory_concurrency.test_and_set();
     }
 
@@ -426,22 +503,51 @@ void arena::advertise_new_work() {
 
     if (is_mandatory_needed || are_workers_needed) {
         int mandatory_delta = is_mandatory_needed ? 1 : 0;
-        int workers_delta = are_workers_needed ? my_max_num_workers : 0;
-
-        if (is_mandatory_needed && is_arena_workerless()) {
-            // Set workers_delta to 1 to keep arena invariants consistent
-            workers_delta = 1;
+        // The number of workers is calculated by update_request, see my_total_num_workers_requested
+        int workers_delta = are_workers_needed ? (int)my_num_slots : 0;
+
+        if (are_workers_needed) {
+            // Request a single worker, or the workers that have not left the arena yet; the threads
+            // finding the tasks request more workers, see try_ramp_up_workers.
+            // Waking up all workers at once makes most of them find nothing and go back to sleep.
+            my_worker_request_limit.store(max(num_workers_active(), 1u), std::memory_order_relaxed);
+            my_worker_request_time.store(counters_time_stamp(), std::memory_order_relaxed);
         }
 
         request_workers(mandatory_delta, workers_delta, /* wakeup_threads = */ true);
     }
 }
 
-inline d1::task* arena::steal_task(unsigned arena_index, FastRandom& frnd, execution_data_ext& ed, isolation_type isolation) {
-    auto slot_num_limit = my_limit.load(std::memory_order_relaxed);
-    if (slot_num_limit == 1) {
-        // No slots to steal from
-        return nullptr;
+inline std::size_t arena::choose_victim(unsigned arena_index, std::size_t slot_num_limit, FastRandom& frnd) {
+    arena_slot& own_slot = my_slots[arena_index];
+    if (own_slot.steal_cache_level == 0 && own_slot.steal_failures == 0) {
+        // A new search for work; the thread might have migrated since the previous one
+        note_cache_domains(own_slot);
+        if (own_slot.my_victims_epoch != my_cache_domains_epoch.load(std::memory_order_acquire)) {
+            collect_victims(arena_index);
+        }
+    }
+    __TBB_ASSERT(own_slot.my_victims_epoch != 0, "The victims are not collected at the start of the search");
+    // Look for a victim with published tasks in the same L2 domain first, then in the same LLC domain.
+    for (; own_slot.steal_cache_level < arena_slot::num_cache_levels; own_slot.widen_steal_scope()) {
+        const unsigned level = own_slot.steal_cache_level;
+        const unsigned num_victims = own_slot.my_num_victims[level];
+        if (num_victims == 0) {
+            continue;
+        }
+        const int domain = own_slot.cache_domain(level);
+        const unsigned* victims = own_slot.my_victims + level * my_num_slots;
+        unsigned i = frnd.get() % num_victims;
+        for (unsigned n = 0; n < num_victims; ++n, i = i + 1 < num_victims ? i + 1 : 0) {
+            const std::size_t k = victims[i];
+            // The lists are collected over all slots and can be outdated if a thread has migrated
+            arena_slot& slot = my_slots[k];
+            if (k < slot_num_limit && slot.cache_domain(level) == domain &&
+                slot.task_pool.load(std::memory_order_relaxed) != EmptyTaskPool)
+            {
+                return k;
+            }
+        }
     }
     // Try to steal a task from a random victim.
     std::size_t k = frnd.get() % (slot_num_limit - 1);
@@ -453,10 +559,43 @@ inline d1::task* arena::steal_task(unsigned arena_index, FastRandom& frnd, execu
     if (k >= arena_index) {
         ++k; // Adjusts random distribution to exclude self
     }
+    return k;
+}
+
+inline d1::task* arena::steal_task(unsigned arena_index, FastRandom& frnd, execution_data_ext& ed, isolation_type isolation,
+                                   steal_counters& counters, thread_tracer& tracer)
+{
+    auto slot_num_limit = my_limit.load(std::memory_order_relaxed);
+    if (slot_num_limit == 1) {
+        // No slots to steal from
+        return nullptr;
+    }
+    arena_slot& own_slot = my_slots[arena_index];
+    std::size_t k = choose_victim(arena_index, slot_num_limit, frnd);
     arena_slot* victim = &my_slots[k];
     d1::task **pool = victim->task_pool.load(std::memory_order_relaxed);
-    d1::task *t = nullptr;
-    if (pool == EmptyTaskPool || !(t = victim->steal_task(*this, isolation, k))) {
+    if (pool == EmptyTaskPool) {
+        own_slot.note_steal_attempt(false);
+        counters.note_steal_attempt(0);
+        return nullptr;
+    }
+    stolen_tasks stolen;
+    d1::task *t = victim->steal_task(*this, isolation, k, stolen);
+    const std::size_t num_tasks = stolen.size + (t ? 1 : 0);
+    own_slot.note_steal_attempt(num_tasks != 0);
+    counters.note_steal_attempt(num_tasks, num_tasks != 0 && own_slot.shares_cache_with(*victim));
+    if (num_tasks) {
+        increase_counter(own_slot.my_counters.tasks_stolen, num_tasks);
+        tracer.record(trace_event_type::steal, steal_trace_argument(k, num_tasks));
+    }
+    if (stolen.size) {
+        // The other taken tasks go to the pool of the thief
+        for (std::size_t i = 0; i < stolen.size; ++i) {
+            own_slot.spawn(*stolen.tasks[i]);
+        }
+        advertise_new_work<work_spawned>();
+    }
+    if (!t) {
         return nullptr;
     }
     if (task_accessor::is_proxy_task(*t)) {
@@ -29,7 +29,7 @@ d1::task* arena_slot::get_task_impl(size_t T, execution_data_ext& ed, bool& task
     __TBB_ASSERT(tail.load(std::memory_order_relaxed) <= T || is_local_task_pool_quiescent(),
             "Is it safe to get a task at position T?");
 
-    d1::task* result = task_pool_ptr[T];
+    d1::task* result = task_at(T);
     __TBB_ASSERT(!is_poisoned( result ), "The poisoned task is going to be processed");
 
     if (!result) {
@@ -53,11 +53,155 @@ d1::task* arena_slot::get_task_impl(size_t T, execution_data_ext& ed, bool& task
     tp.allocator.delete_object(&tp, ed);
 
     if ( tasks_omitted ) {
-        task_pool_ptr[T] = nullptr;
+        task_at(T) = nullptr;
     }
     return nullptr;
 }
 
+#if __TBB_LOCK_FREE_TASK_POOL
+//! Checks if the thief can execute the task taken from the pool of the slot with the slot_index
+static bool can_be_stolen(d1::task& t, arena& a, isolation_type isolation, std::size_t slot_index) {
+    if (isolation != no_isolation && isolation != task_accessor::isolation(t)) {
+        return false;
+    }
+    if (!task_accessor::is_proxy_task(t)) {
+        return true;
+    }
+    task_proxy& tp = static_cast<task_proxy&>(t);
+    // If mailed task is likely to be grabbed by its destination thread, skip it.
+    return !task_proxy::is_shared(tp.task_and_tag) || !tp.outbox->recipient_is_idle() || a.mailbox(slot_index).recipient_is_idle();
+}
+
+d1::task* arena_slot::get_task(execution_data_ext& ed, isolation_type isolation) {
+    __TBB_ASSERT(is_task_pool_published(), nullptr);
+    // The tasks in [T, T0) are taken by the owner. The omitted ones are returned to the pool at the end.
+    std::size_t T0 = tail.load(std::memory_order_relaxed);
+    std::size_t T = T0;
+    d1::task* result = nullptr;
+    bool task_pool_empty = false;
+    bool tasks_omitted = false;
+    bool last_task_omitted = false;
+    do {
+        __TBB_ASSERT( !result, nullptr );
+        tail.store(--T, std::memory_order_relaxed);
+        // The full fence is required to sync the store of `tail` with the load of `head` (write-read barrier)
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        std::size_t H = head.load(std::memory_order_relaxed);
+        if ( std::intptr_t(T - H) < 0 ) {
+            // Thieves have taken the remaining tasks
+            __TBB_ASSERT( H == T + 1, "victim/thief arbitration algorithm failure" );
+            task_pool_empty = true;
+            break;
+        }
+        if ( H == T ) {
+            // There is only one task in the task pool, so compete with thieves for it.
+            task_pool_empty = true;
+            if ( !head.compare_exchange_strong(H, H + 1) ) {
+                break;
+            }
+        }
+        result = get_task_impl( T, ed, tasks_omitted, isolation );
+        if ( result ) {
+            poison_pointer( task_at(T) );
+            break;
+        } else if ( !tasks_omitted ) {
+            poison_pointer( task_at(T) );
+            __TBB_ASSERT( T0 == T+1, nullptr );
+            T0 = T;
+        } else if ( task_pool_empty ) {
+            last_task_omitted = task_at(T) != nullptr;
+        }
+    } while ( !result && !task_pool_empty );
+
+    if ( task_pool_empty ) {
+        // The tasks below T + 1 cannot be returned to the pool as the head has passed them.
+        __TBB_ASSERT( head.load(std::memory_order_relaxed) == T + 1, nullptr );
+        std::size_t new_tail = T + 1;
+        if ( tasks_omitted ) {
+            new_tail = T0;
+            if ( last_task_omitted ) {
+                // Move the omitted task from the position taken from thieves to the end of the pool.
+                // There is enough space as the pool contained all tasks in [T, T0).
+                task_at(T0) = task_at(T);
+                ++new_tail;
+            }
+        }
+        if ( new_tail == T + 1 ) {
+            tail.store(new_tail, std::memory_order_relaxed);
+            // Leave the task pool. The indices are not reset because
+            // a thief can still try to take a task with the old value of the head.
+            task_pool.store(EmptyTaskPool, std::memory_order_relaxed);
+        } else {
+            // The release store makes the moved task visible to thieves.
+            tail.store(new_tail, std::memory_order_release);
+            // Synchronize with snapshot as we published some tasks.
+            ed.task_disp->m_thread_data->my_arena->advertise_new_work<arena::wakeup>();
+        }
+    } else if ( tasks_omitted ) {
+        // A task has been obtained. We need to make a hole in position T.
+        __TBB_ASSERT( result, nullptr );
+        task_at(T) = nullptr;
+        tail.store(T0, std::memory_order_release);
+        // Synchronize with snapshot as we published some tasks.
+        ed.task_disp->m_thread_data->my_arena->advertise_new_work<arena::wakeup>();
+    }
+    return result;
+}
+
+d1::task* arena_slot::steal_task(arena& a, isolation_type isolation, std::size_t slot_index, stolen_tasks& stolen) {
+    d1::task* result = nullptr;
+    // The number of tasks to take, including the tasks taken for the thief's own pool
+    std::size_t batch_size = 0;
+    for (atomic_backoff backoff;;) {
+        std::size_t H = head.load(std::memory_order_acquire);
+        // The full fence is required to sync the load of `head` with the load of `tail` (read-read barrier)
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        std::size_t T = tail.load(std::memory_order_acquire);
+        if (std::intptr_t(T - H) <= 0) {
+            break;
+        }
+        // The pool is loaded after the tail, so it contains the tasks up to the tail
+        d1::task** victim_pool = task_pool.load(std::memory_order_acquire);
+        if (victim_pool == EmptyTaskPool) {
+            break;
+        }
+        __TBB_ASSERT(victim_pool != LockedTaskPool, "The lock-free task pool cannot be locked");
+        if (!batch_size) {
+            batch_size = 1;
+#if __TBB_STEAL_HALF
+            // An isolated thief takes one task not to hold the tasks that it cannot execute
+            if (isolation == no_isolation && (T - H) / 2 > 1) {
+                batch_size = (T - H) / 2 < stolen_tasks::capacity ? (T - H) / 2 : stolen_tasks::capacity;
+            }
+#endif
+        }
+        // The task is valid only if the head is not changed
+        d1::task* t = task_at(victim_pool, H);
+        if (!head.compare_exchange_strong(H, H + 1)) {
+            // Someone else has taken the task, so pause and retry.
+            backoff.pause();
+            continue;
+        }
+        if (!t) {
+            // A hole left by the owner
+            continue;
+        }
+        __TBB_ASSERT(!is_poisoned(t), nullptr);
+        // The task has to be taken before its fields can be read, so the tasks that
+        // the thief cannot execute are moved to the pool of the thief.
+        if (!result && can_be_stolen(*t, a, isolation, slot_index)) {
+            result = t;
+        } else {
+            stolen.push(t);
+        }
+        if (stolen.size + (result ? 1 : 0) >= batch_size) {
+            break;
+        }
+    }
+    return result;
+}
+#else
+
 d1::task* arena_slot::get_task(execution_data_ext& ed, isolation_type isolation) {
     __TBB_ASSERT(is_task_pool_published(), nullptr);
     // The current task position in the task pool.
@@ -145,7 +289,10 @@ d1::task* arena_slot::get_task(execution_data_ext& ed, isolation_type isolation)
     return result;
 }
 
-d1::task* arena_slot::steal_task(arena& a, isolation_type isolation, std::size_t slot_index) {
+d1::task* arena_slot::steal_task(arena& a, isolation_type isolation, std::size_t slot_index, stolen_tasks& stolen) {
+#if !__TBB_STEAL_HALF
+    suppress_unused_warning(stolen);
+#endif
     d1::task** victim_pool = lock_task_pool();
     if (!victim_pool) {
         return nullptr;
@@ -199,6 +346,32 @@ d1::task* arena_slot::steal_task(arena& a, isolation_type isolation, std::size_t
         // The release store synchronizes the victim_pool update(the store of nullptr).
         head.store( /*dead: H = */ H0, std::memory_order_release );
     }
+#if __TBB_STEAL_HALF
+    // An isolated thief takes one task not to hold the tasks that it cannot execute
+    else if (isolation == no_isolation) {
+        // Take up to half of the visible tasks, including the stolen one.
+        std::size_t T = tail.load(std::memory_order_acquire);
+        std::size_t batch_size = (std::intptr_t)T > (std::intptr_t)H ? (T - H + 1) / 2 : 1;
+        batch_size = batch_size < stolen_tasks::capacity ? batch_size : stolen_tasks::capacity;
+        while (stolen.size + 1 < batch_size) {
+            // The tasks are taken one by one, since the owner can take the tasks from the tail concurrently
+            H = ++head;
+            if ((std::intptr_t)H > (std::intptr_t)(tail.load(std::memory_order_acquire))) {
+                head.store(H - 1, std::memory_order_relaxed);
+                break;
+            }
+            d1::task* t = victim_pool[H-1];
+            __TBB_ASSERT( !is_poisoned( t ), nullptr );
+            if (!t || task_accessor::is_proxy_task(*t)) {
+                // The holes and the proxies are left for the regular stealing
+                head.store(H - 1, std::memory_order_relaxed);
+                break;
+            }
+            poison_pointer( victim_pool[H-1] );
+            stolen.push(t);
+        }
+    }
+#endif /* __TBB_STEAL_HALF */
 unlock:
     unlock_task_pool(victim_pool);
 
@@ -212,6 +385,7 @@ unlock:
     }
     return result;
 }
+#endif /* __TBB_LOCK_FREE_TASK_POOL */
 
 } // namespace r1
 } // namespace detail
@@ -29,6 +29,21 @@
 #include "scheduler_common.h"
 
 #include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <new>
+
+//! Replaces the lock of the arena slot task pool with the Chase-Lev work-stealing deque
+/** Thieves take tasks with a CAS on the head index instead of locking the task pool,
+    so they do not serialize on a busy victim. **/
+#ifndef __TBB_LOCK_FREE_TASK_POOL
+#define __TBB_LOCK_FREE_TASK_POOL 0
+#endif
+
+//! A thief takes up to half of the tasks of the victim in one steal attempt
+#ifndef __TBB_STEAL_HALF
+#define __TBB_STEAL_HALF 0
+#endif
 
 namespace tbb {
 namespace detail {
@@ -44,6 +59,91 @@ class task_group_context;
 static d1::task** const EmptyTaskPool  = nullptr;
 static d1::task** const LockedTaskPool = reinterpret_cast<d1::task**>(~std::intptr_t(0));
 
+//! Tasks that a thief has taken from the victim besides the one to be executed
+/** The thief puts them into its own task pool. **/
+struct stolen_tasks {
+    static constexpr std::size_t capacity = 16;
+
+    d1::task* tasks[capacity];
+    std::size_t size{0};
+
+    bool full() const {
+        return size == capacity;
+    }
+
+    void push(d1::task* t) {
+        __TBB_ASSERT(!full(), nullptr);
+        tasks[size++] = t;
+    }
+};
+
+//! Increases a counter that is modified by a single thread and read by the others
+inline void increase_counter(std::atomic<std::uint64_t>& counter, std::uint64_t delta) {
+    // Only one thread modifies the counter, so the read-modify-write operation is not required
+    counter.store(counter.load(std::memory_order_relaxed) + delta, std::memory_order_relaxed);
+}
+
+//! Work stealing counters of a thread
+/** Modified by the owning thread only, read by the threads collecting the statistics. **/
+struct steal_counters {
+    //! Number of the steal attempts that have taken at least one task
+    std::atomic<std::uint64_t> successes{0};
+    //! Number of the steal attempts that have not found a task to take
+    std::atomic<std::uint64_t> failures{0};
+    //! Number of the taken tasks, including the tasks put into the pool of the thief
+    std::atomic<std::uint64_t> tasks_stolen{0};
+    //! Number of the successful steal attempts whose victim shares a cache with the thief
+    std::atomic<std::uint64_t> cache_local_successes{0};
+
+    void note_steal_attempt(std::size_t num_tasks, bool is_cache_local = false) {
+        if (num_tasks) {
+            increase_counter(successes, 1);
+            increase_counter(tasks_stolen, num_tasks);
+            if (is_cache_local) {
+                increase_counter(cache_local_successes, 1);
+            }
+        } else {
+            increase_counter(failures, 1);
+        }
+    }
+};
+
+//! Activity counters of the threads that have occupied an arena slot
+/** Modified by the occupying thread only, read by the threads collecting the metrics. **/
+struct slot_counters {
+    //! Number of the tasks spawned into the task pool of the slot
+    std::atomic<std::uint64_t> tasks_spawned;
+    //! Number of the tasks taken from the other slots
+    std::atomic<std::uint64_t> tasks_stolen;
+    //! Number of the tasks taken from the mailbox of the slot
+    std::atomic<std::uint64_t> mailbox_tasks_executed;
+    //! Time in nanoseconds that the workers have spent spinning in search of work
+    std::atomic<std::uint64_t> worker_spin_time;
+    //! Number of the times a thread sleeping in the arena has been woken up
+    std::atomic<std::uint64_t> monitor_wakeups;
+    //! Number of the times a worker has joined the arena and taken a task
+    std::atomic<std::uint64_t> worker_wakeups;
+    //! Number of the times a worker has joined the arena and left it without taking a task
+    std::atomic<std::uint64_t> empty_worker_wakeups;
+    //! Total and maximal time in nanoseconds from the request for workers to the first task of a joined worker
+    std::atomic<std::uint64_t> worker_wakeup_latency;
+    std::atomic<std::uint64_t> max_worker_wakeup_latency;
+
+    void note_worker_wakeup(std::uint64_t latency) {
+        increase_counter(worker_wakeups, 1);
+        increase_counter(worker_wakeup_latency, latency);
+        if (latency > max_worker_wakeup_latency.load(std::memory_order_relaxed)) {
+            max_worker_wakeup_latency.store(latency, std::memory_order_relaxed);
+        }
+    }
+};
+
+//! Returns the time in nanoseconds used by the activity counters
+inline std::uint64_t counters_time_stamp() {
+    return std::uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
 struct alignas(max_nfs_size) arena_slot_shared_state {
     //! Scheduler of the thread attached to the slot
     /** Marks the slot as busy, and is used to iterate through the schedulers belonging to this arena **/
@@ -56,7 +156,9 @@ struct alignas(max_nfs_size) arena_slot_shared_state {
     std::atomic<d1::task**> task_pool;
 
     //! Index of the first ready task in the deque.
-    /** Modified by thieves, and by the owner during compaction/reallocation **/
+    /** Modified by thieves, and by the owner during compaction/reallocation.
+        In the lock-free task pool, the head and tail indices only grow, and the index i
+        refers to the element i % my_task_pool_size of the pool. **/
     std::atomic<std::size_t> head;
 };
 
@@ -83,6 +185,16 @@ struct alignas(max_nfs_size) arena_slot_private_state {
     //! Task pool of the scheduler that owns this slot
     // TODO: previously was task**__TBB_atomic, but seems like not accessed on other thread
     d1::task** task_pool_ptr;
+
+    //! Cache level of the victims that the thief prefers; the maximal value means any victim.
+    /** Modified by the owner thread when it steals. **/
+    unsigned steal_cache_level;
+
+    //! Number of unsuccessful steal attempts at the current steal_cache_level.
+    unsigned steal_failures;
+
+    //! The arena cache domains epoch the victim lists were collected at, zero if they are not collected.
+    unsigned my_victims_epoch;
 };
 
 class arena_slot : private arena_slot_shared_state, private arena_slot_private_state {
@@ -95,6 +207,56 @@ class arena_slot : private arena_slot_shared_state, private arena_slot_private_s
     //! The original task dispather associated with this slot
     task_dispatcher* my_default_task_dispatcher;
 
+public:
+    //! Number of the cache levels considered by victim selection: L2 and the last level cache
+    static constexpr unsigned num_cache_levels = 2;
+
+    //! Number of unsuccessful steal attempts after which the thief looks for victims beyond the cache
+    static constexpr unsigned steal_attempts_per_cache_level = 2;
+
+    //! Activity counters of the slot; zeroed together with the arena memory
+    slot_counters my_counters;
+
+private:
+    //! Indices of the L2 and last level cache domains of the occupying thread, -1 if unknown
+    /** Written by the occupying thread, read by the thieves choosing a victim. **/
+    std::atomic<int> my_cache_domains[num_cache_levels];
+
+    //! The slots sharing a cache domain with the occupying thread, my_num_slots entries per cache level
+    /** Collected by the occupying thread when the cache domains in the arena change, see
+        arena::collect_victims. Allocated on the first use and freed with the arena. **/
+    unsigned* my_victims;
+
+    //! The number of the collected victims at each cache level
+    unsigned my_num_victims[num_cache_levels];
+
+#if __TBB_LOCK_FREE_TASK_POOL
+    //! Precedes the elements of the lock-free task pool
+    struct alignas(max_nfs_size) task_pool_header {
+        //! Number of elements, a power of two
+        std::size_t capacity;
+        //! The task pool replaced by this one when the pool grew
+        /** Thieves may still read it, so it is kept until the task pool is freed. **/
+        d1::task** previous;
+    };
+
+    static task_pool_header& header_of( d1::task** pool ) {
+        return *(reinterpret_cast<task_pool_header*>(pool) - 1);
+    }
+
+    static d1::task*& task_at( d1::task** pool, std::size_t i ) {
+        return pool[i & (header_of(pool).capacity - 1)];
+    }
+
+    d1::task*& task_at( std::size_t i ) {
+        return task_pool_ptr[i & (my_task_pool_size - 1)];
+    }
+#else
+    d1::task*& task_at( std::size_t i ) {
+        return task_pool_ptr[i];
+    }
+#endif /* __TBB_LOCK_FREE_TASK_POOL */
+
 #if TBB_USE_ASSERT
     void fill_with_canary_pattern ( std::size_t first, std::size_t last ) {
         for ( std::size_t i = first; i < last; ++i )
@@ -106,6 +268,19 @@ class arena_slot : private arena_slot_shared_state, private arena_slot_private_s
 
     static constexpr std::size_t min_task_pool_size = 64;
 
+#if __TBB_LOCK_FREE_TASK_POOL
+    void allocate_task_pool( std::size_t n ) {
+        std::size_t capacity = min_task_pool_size;
+        while (capacity < n) {
+            capacity *= 2;
+        }
+        void* storage = cache_aligned_allocate(sizeof(task_pool_header) + capacity * sizeof(d1::task*));
+        task_pool_header* header = new (storage) task_pool_header{capacity, task_pool_ptr};
+        my_task_pool_size = capacity;
+        task_pool_ptr = reinterpret_cast<d1::task**>(header + 1);
+        fill_with_canary_pattern( 0, my_task_pool_size );
+    }
+#else
     void allocate_task_pool( std::size_t n ) {
         std::size_t byte_size = ((n * sizeof(d1::task*) + max_nfs_size - 1) / max_nfs_size) * max_nfs_size;
         my_task_pool_size = byte_size / sizeof(d1::task*);
@@ -114,6 +289,7 @@ class arena_slot : private arena_slot_shared_state, private arena_slot_private_s
         // But fill it with a canary pattern in the high vigilance debug mode.
         fill_with_canary_pattern( 0, my_task_pool_size );
     }
+#endif /* __TBB_LOCK_FREE_TASK_POOL */
 
 public:
     //! Deallocate task pool that was allocated by means of allocate_task_pool.
@@ -122,8 +298,16 @@ public:
         // __TBB_ASSERT( !task_pool /* TODO: == EmptyTaskPool */, nullptr);
         if( task_pool_ptr ) {
            __TBB_ASSERT( my_task_pool_size, nullptr);
+#if __TBB_LOCK_FREE_TASK_POOL
+           while ( task_pool_ptr ) {
+               task_pool_header& header = header_of( task_pool_ptr );
+               task_pool_ptr = header.previous;
+               cache_aligned_deallocate( &header );
+           }
+#else
            cache_aligned_deallocate( task_pool_ptr );
            task_pool_ptr = nullptr;
+#endif
            my_task_pool_size = 0;
         }
     }
@@ -135,17 +319,23 @@ public:
     d1::task* get_task(execution_data_ext&, isolation_type);
 
     //! Steal task from slot's ready pool
-    d1::task* steal_task(arena&, isolation_type, std::size_t);
+    /** The tasks taken from the pool that the thief cannot execute right away are put into stolen. **/
+    d1::task* steal_task(arena&, isolation_type, std::size_t, stolen_tasks& stolen);
 
     //! Some thread is now the owner of this slot
     void occupy() {
         __TBB_ASSERT(!my_is_occupied.load(std::memory_order_relaxed), nullptr);
         my_is_occupied.store(true, std::memory_order_release);
+        reset_steal_state();
     }
 
     //! Try to occupy the slot
     bool try_occupy() {
-        return !is_occupied() && my_is_occupied.exchange(true) == false;
+        if (!is_occupied() && my_is_occupied.exchange(true) == false) {
+            reset_steal_state();
+            return true;
+        }
+        return false;
     }
 
     //! Some thread is now the owner of this slot
@@ -157,8 +347,11 @@ public:
     //! Spawn newly created tasks
     void spawn(d1::task& t) {
         std::size_t T = prepare_task_pool(1);
+#if !__TBB_LOCK_FREE_TASK_POOL
+        // Thieves do not poison the elements of the lock-free task pool
         __TBB_ASSERT(is_poisoned(task_pool_ptr[T]), nullptr);
-        task_pool_ptr[T] = &t;
+#endif
+        task_at(T) = &t;
         commit_spawned_tasks(T + 1);
         if (!is_task_pool_published()) {
             publish_task_pool();
@@ -193,6 +386,74 @@ public:
 #endif
     }
 
+    void init_cache_domains() {
+        for (auto& domain : my_cache_domains) {
+            domain.store(-1, std::memory_order_relaxed);
+        }
+    }
+
+    //! Records the cache domains of the processor running the occupying thread
+    /** Returns true if the domains have changed. **/
+    bool update_cache_domains() {
+        int domains[num_cache_levels];
+        get_thread_cache_domains(domains[0], domains[1]);
+        bool changed = false;
+        for (unsigned level = 0; level < num_cache_levels; ++level) {
+            // Avoid invalidating the cache line read by the thieves if the thread has not migrated
+            if (my_cache_domains[level].load(std::memory_order_relaxed) != domains[level]) {
+                my_cache_domains[level].store(domains[level], std::memory_order_relaxed);
+                changed = true;
+            }
+        }
+        return changed;
+    }
+
+    //! Forgets the victim selection state left by the previous occupying thread
+    void reset_steal_state() {
+        steal_cache_level = 0;
+        steal_failures = 0;
+        my_victims_epoch = 0;
+    }
+
+    void free_victims() {
+        if (my_victims) {
+            cache_aligned_deallocate(my_victims);
+            my_victims = nullptr;
+        }
+    }
+
+    int cache_domain(unsigned level) const {
+        __TBB_ASSERT(level < num_cache_levels, nullptr);
+        return my_cache_domains[level].load(std::memory_order_relaxed);
+    }
+
+    //! Checks if the occupying threads of both slots share the L2 or the last level cache
+    bool shares_cache_with(const arena_slot& other) const {
+        for (unsigned level = 0; level < num_cache_levels; ++level) {
+            const int domain = cache_domain(level);
+            if (domain >= 0 && domain == other.cache_domain(level)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    //! Looks for the victims beyond the current cache level in the subsequent steal attempts
+    void widen_steal_scope() {
+        __TBB_ASSERT(steal_cache_level < num_cache_levels, nullptr);
+        ++steal_cache_level;
+        steal_failures = 0;
+    }
+
+    void note_steal_attempt(bool succeeded) {
+        if (succeeded) {
+            steal_cache_level = 0;
+            steal_failures = 0;
+        } else if (steal_cache_level < num_cache_levels && ++steal_failures == steal_attempts_per_cache_level) {
+            widen_steal_scope();
+        }
+    }
+
 #if __TBB_PREVIEW_CRITICAL_TASKS
     unsigned& critical_hint() {
         return hint_for_critical_stream;
@@ -210,6 +471,36 @@ private:
     //! Makes sure that the task pool can accommodate at least n more elements
     /** If necessary relocates existing task pointers or grows the ready task deque.
      *  Returns (possible updated) tail index (not accounting for n). **/
+#if __TBB_LOCK_FREE_TASK_POOL
+    std::size_t prepare_task_pool(std::size_t num_tasks) {
+        std::size_t T = tail.load(std::memory_order_relaxed); // mirror
+        if ( !my_task_pool_size ) {
+            __TBB_ASSERT( !is_task_pool_published() && is_quiescent_local_task_pool_reset(), nullptr);
+            __TBB_ASSERT( !task_pool_ptr, nullptr);
+            allocate_task_pool( num_tasks );
+            return T;
+        }
+        // Thieves only increase the head, so the number of tasks can be overestimated but not underestimated
+        std::size_t H = head.load(std::memory_order_relaxed);
+        __TBB_ASSERT( std::intptr_t(T - H) >= 0, nullptr );
+        if ( T - H + num_tasks <= my_task_pool_size ) {
+            return T;
+        }
+        // Thieves can still take tasks from the old pool. The tasks have the same indices
+        // in both pools, so it does not matter which of the pools a thief reads.
+        d1::task** old_task_pool = task_pool_ptr;
+        std::size_t old_size = my_task_pool_size;
+        allocate_task_pool( T - H + num_tasks > 2 * old_size ? T - H + num_tasks : 2 * old_size );
+        for ( std::size_t i = H; i != T; ++i ) {
+            task_at(i) = old_task_pool[i & (old_size - 1)];
+        }
+        if ( is_task_pool_published() ) {
+            // Thieves read the pool after the tail, so they see the new pool with the tasks spawned into it
+            task_pool.store( task_pool_ptr, std::memory_order_release );
+        }
+        return T;
+    }
+#else
     std::size_t prepare_task_pool(std::size_t num_tasks) {
         std::size_t T = tail.load(std::memory_order_relaxed); // mirror
         if ( T + num_tasks <= my_task_pool_size ) {
@@ -259,10 +550,15 @@ private:
         // assert_task_pool_valid();
         return T1;
     }
+#endif /* __TBB_LOCK_FREE_TASK_POOL */
 
     //! Makes newly spawned tasks visible to thieves
     void commit_spawned_tasks(std::size_t new_tail) {
+#if __TBB_LOCK_FREE_TASK_POOL
+        __TBB_ASSERT (new_tail - head.load(std::memory_order_relaxed) <= my_task_pool_size, "task deque end was overwritten");
+#else
         __TBB_ASSERT (new_tail <= my_task_pool_size, "task deque end was overwritten");
+#endif
         // emit "task was released" signal
         // Release fence is necessary to make sure that previously stored task pointers
         // are visible to thieves.
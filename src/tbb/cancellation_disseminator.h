@@ -70,6 +70,15 @@ public:
         my_threads_list.remove(td);
     }
 
+    //! Calls the function for every registered thread; the threads cannot unregister meanwhile.
+    template <typename Function>
+    void for_each_thread(Function&& f) {
+        threads_list_mutex_type::scoped_lock lock(my_threads_list_mutex);
+        for (auto& thr_data : my_threads_list) {
+            f(thr_data);
+        }
+    }
+
 private:
     using thread_data_list_type = intrusive_list<thread_data>;
     using threads_list_mutex_type = d1::mutex;
@@ -50,18 +50,8 @@
 #endif // __APPLE__
 
 #include <ucontext.h>
-#include <sys/mman.h> // mprotect
 
-#include "governor.h" // default_page_size()
-
-#ifndef MAP_STACK
-// macOS* does not define MAP_STACK
-#define MAP_STACK 0
-#endif
-#ifndef MAP_ANONYMOUS
-// macOS* defines MAP_ANON, which is deprecated in Linux*.
-#define MAP_ANONYMOUS MAP_ANON
-#endif
+#include "co_stack_pool.h"
 #endif // _WIN32 || _WIN64
 
 namespace tbb {
@@ -305,23 +295,11 @@ inline void destroy_coroutine(coroutine_type& c) {
 #else // !(_WIN32 || _WIN64)
 
 inline void create_coroutine(coroutine_type& c, std::size_t stack_size, void* arg) {
-    const std::size_t REG_PAGE_SIZE = governor::default_page_size();
-    const std::size_t page_aligned_stack_size = (stack_size + (REG_PAGE_SIZE - 1)) & ~(REG_PAGE_SIZE - 1);
-    const std::size_t protected_stack_size = page_aligned_stack_size + 2 * REG_PAGE_SIZE;
-
-    // Allocate the stack with protection property
-    std::uintptr_t stack_ptr = (std::uintptr_t)mmap(nullptr, protected_stack_size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_STACK, -1, 0);
-    __TBB_ASSERT((void*)stack_ptr != MAP_FAILED, nullptr);
+    // The stack is surrounded by the protected guard pages
+    c.my_stack = co_stack_pool::acquire(stack_size);
+    c.my_stack_size = stack_size;
 
-    // Allow read write on our stack (guarded pages are still protected)
-    int err = mprotect((void*)(stack_ptr + REG_PAGE_SIZE), page_aligned_stack_size, PROT_READ | PROT_WRITE);
-    __TBB_ASSERT_EX(!err, nullptr);
-
-    // Remember the stack state
-    c.my_stack = (void*)(stack_ptr + REG_PAGE_SIZE);
-    c.my_stack_size = page_aligned_stack_size;
-
-    err = getcontext(&c.my_context);
+    int err = getcontext(&c.my_context);
     __TBB_ASSERT_EX(!err, nullptr);
 
     c.my_context.uc_link = nullptr;
@@ -351,9 +329,8 @@ inline void swap_coroutine(coroutine_type& prev_coroutine, coroutine_type& new_c
 }
 
 inline void destroy_coroutine(coroutine_type& c) {
-    const std::size_t REG_PAGE_SIZE = governor::default_page_size();
-    // Free stack memory with guarded pages
-    munmap((void*)((std::uintptr_t)c.my_stack - REG_PAGE_SIZE), c.my_stack_size + 2 * REG_PAGE_SIZE);
+    // Keep the stack for the next coroutine
+    co_stack_pool::release(c.my_stack, c.my_stack_size);
     // Clear the stack state afterwards
     c.my_stack = nullptr;
     c.my_stack_size = 0;
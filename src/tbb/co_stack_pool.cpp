@@ -0,0 +1,222 @@
+/*
+    Copyright (c) 2024 Intel Corporation
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "oneapi/tbb/detail/_config.h"
+#include "oneapi/tbb/detail/_utils.h"
+#include "oneapi/tbb/cache_aligned_allocator.h"
+#include "oneapi/tbb/scheduler_statistics.h"
+#include "oneapi/tbb/spin_mutex.h"
+
+#include "co_stack_pool.h"
+
+#if __TBB_CO_STACK_POOL
+
+#include "governor.h"
+
+#include <sys/mman.h>
+
+#include <chrono>
+#include <cstdint>
+#include <new>
+
+#ifndef MAP_STACK
+// macOS* does not define MAP_STACK
+#define MAP_STACK 0
+#endif
+#ifndef MAP_ANONYMOUS
+// macOS* defines MAP_ANON, which is deprecated in Linux*.
+#define MAP_ANONYMOUS MAP_ANON
+#endif
+
+#endif // __TBB_CO_STACK_POOL
+
+namespace tbb {
+namespace detail {
+namespace r1 {
+
+std::atomic<std::size_t> the_coroutine_stack_size{0};
+
+#if __TBB_CO_STACK_POOL
+
+//! Stacks of the same size released on the same NUMA node
+/** The stacks are reused in the LIFO order, so the stacks below the top are idle longer,
+    and the oldest stacks are the first to have their memory returned to the system. **/
+class alignas(max_nfs_size) co_stack_bucket {
+    using idle_clock = std::chrono::steady_clock;
+public:
+    static constexpr std::size_t max_cached_stacks = 32;
+
+    void* pop(std::size_t& num_trimmed) {
+        spin_mutex::scoped_lock lock(my_mutex);
+        if (my_size == 0) {
+            return nullptr;
+        }
+        --my_size;
+        if (my_num_trimmed > my_size) {
+            my_num_trimmed = my_size;
+        }
+        num_trimmed = trim(idle_clock::now());
+        return my_stacks[my_size].stack;
+    }
+
+    bool push(void* stack, std::size_t stack_size, std::size_t& num_trimmed) {
+        spin_mutex::scoped_lock lock(my_mutex);
+        if (my_size == max_cached_stacks) {
+            return false;
+        }
+        idle_clock::time_point now = idle_clock::now();
+        my_stacks[my_size++] = { stack, now };
+        my_stack_size = stack_size;
+        num_trimmed = trim(now);
+        return true;
+    }
+
+private:
+    //! The time a stack stays idle in the cache before its memory is returned to the system
+    static constexpr std::chrono::milliseconds trim_delay{100};
+    //! The number of the stacks trimmed at most by one operation, to keep the lock short
+    static constexpr std::size_t trim_budget = 2;
+
+    //! Returns the memory of the oldest idle stacks to the system, keeping their mappings
+    std::size_t trim(idle_clock::time_point now) {
+        std::size_t num_trimmed = 0;
+        while (my_num_trimmed < my_size && num_trimmed < trim_budget &&
+               now - my_stacks[my_num_trimmed].release_time >= trim_delay)
+        {
+            madvise(my_stacks[my_num_trimmed].stack, my_stack_size, MADV_DONTNEED);
+            ++my_num_trimmed;
+            ++num_trimmed;
+        }
+        return num_trimmed;
+    }
+
+    struct cached_stack {
+        void* stack;
+        idle_clock::time_point release_time;
+    };
+
+    spin_mutex my_mutex{};
+    std::size_t my_size{0};
+    //! The number of the stacks at the bottom whose memory is returned to the system
+    std::size_t my_num_trimmed{0};
+    std::size_t my_stack_size{0};
+    cached_stack my_stacks[max_cached_stacks];
+};
+
+constexpr std::chrono::milliseconds co_stack_bucket::trim_delay;
+
+class co_stack_cache {
+public:
+    //! The stacks of the NUMA nodes beyond this number share the buckets
+    static constexpr unsigned max_numa_shards = 8;
+    //! The stacks of 2^num_size_classes pages and larger are not cached
+    static constexpr unsigned num_size_classes = 24;
+
+    co_stack_bucket& bucket(unsigned size_class) {
+        return my_buckets[current_numa_shard()][size_class];
+    }
+
+    std::atomic<std::uint64_t> my_hits{0};
+    std::atomic<std::uint64_t> my_misses{0};
+    std::atomic<std::uint64_t> my_trimmed{0};
+    std::atomic<std::size_t> my_cached{0};
+
+private:
+    static unsigned current_numa_shard() {
+        int node = get_thread_numa_domain();
+        return node > 0 ? unsigned(node) % max_numa_shards : 0;
+    }
+
+    co_stack_bucket my_buckets[max_numa_shards][num_size_classes];
+};
+
+//! The cache is never destroyed, because suspended tasks can outlive the static objects
+static co_stack_cache& the_co_stack_cache() {
+    static co_stack_cache* cache = new (cache_aligned_allocate(sizeof(co_stack_cache))) co_stack_cache{};
+    return *cache;
+}
+
+static unsigned stack_size_class(std::size_t num_pages) {
+    unsigned size_class = 0;
+    while ((std::size_t(1) << size_class) < num_pages) {
+        ++size_class;
+    }
+    return size_class;
+}
+
+void* co_stack_pool::acquire(std::size_t& stack_size) {
+    const std::size_t page_size = governor::default_page_size();
+    const unsigned size_class = stack_size_class((stack_size + page_size - 1) / page_size);
+    stack_size = page_size << size_class;
+
+    co_stack_cache& cache = the_co_stack_cache();
+    if (size_class < co_stack_cache::num_size_classes) {
+        std::size_t num_trimmed = 0;
+        void* stack = cache.bucket(size_class).pop(num_trimmed);
+        cache.my_trimmed.fetch_add(num_trimmed, std::memory_order_relaxed);
+        if (stack) {
+            cache.my_cached.fetch_sub(1, std::memory_order_relaxed);
+            cache.my_hits.fetch_add(1, std::memory_order_relaxed);
+            return stack;
+        }
+    }
+    cache.my_misses.fetch_add(1, std::memory_order_relaxed);
+
+    // Allocate the stack with protection property
+    const std::size_t protected_stack_size = stack_size + 2 * page_size;
+    void* region = mmap(nullptr, protected_stack_size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_STACK, -1, 0);
+    __TBB_ASSERT(region != MAP_FAILED, nullptr);
+
+    // Allow read write on our stack (guarded pages are still protected)
+    void* stack = static_cast<char*>(region) + page_size;
+    int err = mprotect(stack, stack_size, PROT_READ | PROT_WRITE);
+    __TBB_ASSERT_EX(!err, nullptr);
+    return stack;
+}
+
+void co_stack_pool::release(void* stack, std::size_t stack_size) {
+    const std::size_t page_size = governor::default_page_size();
+    const unsigned size_class = stack_size_class(stack_size / page_size);
+    __TBB_ASSERT(stack_size == page_size << size_class, "The stack was not acquired from the pool");
+
+    co_stack_cache& cache = the_co_stack_cache();
+    std::size_t num_trimmed = 0;
+    if (size_class < co_stack_cache::num_size_classes && cache.bucket(size_class).push(stack, stack_size, num_trimmed)) {
+        cache.my_cached.fetch_add(1, std::memory_order_relaxed);
+        cache.my_trimmed.fetch_add(num_trimmed, std::memory_order_relaxed);
+        return;
+    }
+    // Free stack memory with guarded pages
+    munmap(static_cast<char*>(stack) - page_size, stack_size + 2 * page_size);
+}
+
+void co_stack_pool::collect_metrics(d1::scheduler_metrics& metrics) {
+    co_stack_cache& cache = the_co_stack_cache();
+    metrics.coroutine_stack_hits += cache.my_hits.load(std::memory_order_relaxed);
+    metrics.coroutine_stack_misses += cache.my_misses.load(std::memory_order_relaxed);
+    metrics.trimmed_coroutine_stacks += cache.my_trimmed.load(std::memory_order_relaxed);
+    metrics.cached_coroutine_stacks += cache.my_cached.load(std::memory_order_relaxed);
+}
+
+#else // !__TBB_CO_STACK_POOL
+
+void co_stack_pool::collect_metrics(d1::scheduler_metrics&) {}
+
+#endif // __TBB_CO_STACK_POOL
+
+} // namespace r1
+} // namespace detail
+} // namespace tbb
@@ -0,0 +1,65 @@
+/*
+    Copyright (c) 2024 Intel Corporation
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#ifndef _TBB_co_stack_pool_H
+#define _TBB_co_stack_pool_H
+
+#include "oneapi/tbb/detail/_config.h"
+
+#include <atomic>
+#include <cstddef>
+
+#if __TBB_RESUMABLE_TASKS && !__TBB_RESUMABLE_TASKS_USE_THREADS && !(_WIN32 || _WIN64)
+//! The stacks of the coroutines are allocated by the library rather than by the system
+#define __TBB_CO_STACK_POOL 1
+#else
+#define __TBB_CO_STACK_POOL 0
+#endif
+
+namespace tbb {
+namespace detail {
+namespace d1 {
+struct scheduler_metrics;
+}
+
+namespace r1 {
+
+//! The stack size of the coroutines set by global_control::coroutine_stack_size; zero means the worker stack size
+extern std::atomic<std::size_t> the_coroutine_stack_size;
+
+//! The process-wide cache of the coroutine stacks
+/** The stacks are grouped by the NUMA node of the thread that releases them, once the system
+    topology is loaded, and by the size classes of a power of two pages. A stack idle in the cache
+    longer than 100 milliseconds keeps its mapping and guard pages, but its memory is returned
+    to the system with madvise on the next operation with the same group. **/
+class co_stack_pool {
+public:
+    //! Returns the stack of at least the given size, which is rounded up to the size of the class
+    /** The stack is surrounded by the protected guard pages. **/
+    static void* acquire(std::size_t& stack_size);
+
+    //! Returns the stack to the cache or unmaps it if the cache for its size is full
+    static void release(void* stack, std::size_t stack_size);
+
+    //! Adds the counters of the cache to the global metrics
+    static void collect_metrics(d1::scheduler_metrics& metrics);
+};
+
+} // namespace r1
+} // namespace detail
+} // namespace tbb
+
+#endif /* _TBB_co_stack_pool_H */
@@ -22,10 +22,13 @@
 #include "oneapi/tbb/tbb_allocator.h"
 #include "oneapi/tbb/spin_mutex.h"
 
+#include "co_stack_pool.h"
+#include "environment.h"
 #include "governor.h"
 #include "threading_control.h"
 #include "market.h"
 #include "misc.h"
+#include "scheduler_tracing.h"
 
 #include <atomic>
 #include <set>
@@ -142,13 +145,67 @@ class alignas(max_nfs_size) lifetime_control : public control_storage {
     }
 };
 
-static control_storage* controls[] = {nullptr, nullptr, nullptr, nullptr};
+class alignas(max_nfs_size) scheduler_tracing_control : public control_storage {
+    std::size_t default_value() const override {
+        return my_default_value;
+    }
+    void apply_active(std::size_t new_active) override {
+        control_storage::apply_active(new_active);
+        the_scheduler_tracing_enabled.store(new_active != 0, std::memory_order_relaxed);
+    }
+
+    //! Set by the TBB_SCHEDULER_TRACING environment variable
+    const std::size_t my_default_value;
+public:
+    scheduler_tracing_control() : my_default_value(GetBoolEnvironmentVariable("TBB_SCHEDULER_TRACING")) {
+        the_scheduler_tracing_enabled.store(my_default_value != 0, std::memory_order_relaxed);
+    }
+};
+
+//! The settings of the wait policies in the order of d1::global_control::wait_policy
+static const wait_policy_settings wait_policies[] = {
+    /*power_saving*/ { 0, 2, std::chrono::microseconds(0), false },
+    /*balanced*/ { 2, 100, std::chrono::microseconds(1000), false },
+    /*low_latency*/ { 8, 1000, std::chrono::microseconds(10000), true }
+};
+
+std::atomic<const wait_policy_settings*> the_wait_policy_settings{ &wait_policies[d1::global_control::balanced_wait_policy] };
+
+class alignas(max_nfs_size) wait_policy_control : public control_storage {
+    std::size_t default_value() const override {
+        return d1::global_control::balanced_wait_policy;
+    }
+    bool is_first_arg_preferred(std::size_t a, std::size_t b) const override {
+        return a < b; // prefer the policy that spends less processor time
+    }
+    void apply_active(std::size_t new_active) override {
+        __TBB_ASSERT(new_active <= d1::global_control::low_latency_wait_policy, "Invalid wait policy");
+        control_storage::apply_active(new_active);
+        std::size_t policy = min(new_active, std::size_t(d1::global_control::low_latency_wait_policy));
+        the_wait_policy_settings.store(&wait_policies[policy], std::memory_order_relaxed);
+    }
+};
+
+class alignas(max_nfs_size) coroutine_stack_size_control : public control_storage {
+    std::size_t default_value() const override {
+        return 0; // the stack size of the worker threads
+    }
+    void apply_active(std::size_t new_active) override {
+        control_storage::apply_active(new_active);
+        the_coroutine_stack_size.store(new_active, std::memory_order_relaxed);
+    }
+};
+
+static control_storage* controls[] = {nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr};
 
 void global_control_acquire() {
     controls[0] = new (cache_aligned_allocate(sizeof(allowed_parallelism_control))) allowed_parallelism_control{};
     controls[1] = new (cache_aligned_allocate(sizeof(stack_size_control))) stack_size_control{};
     controls[2] = new (cache_aligned_allocate(sizeof(terminate_on_exception_control))) terminate_on_exception_control{};
     controls[3] = new (cache_aligned_allocate(sizeof(lifetime_control))) lifetime_control{};
+    controls[4] = new (cache_aligned_allocate(sizeof(scheduler_tracing_control))) scheduler_tracing_control{};
+    controls[5] = new (cache_aligned_allocate(sizeof(wait_policy_control))) wait_policy_control{};
+    controls[6] = new (cache_aligned_allocate(sizeof(coroutine_stack_size_control))) coroutine_stack_size_control{};
 }
 
 void global_control_release() {
@@ -37,6 +37,10 @@
 #include <atomic>
 #include <algorithm>
 
+#if __linux__
+#include <sched.h> // sched_getcpu
+#endif
+
 #ifdef EMSCRIPTEN
 #include <emscripten/stack.h>
 #endif
@@ -50,6 +54,7 @@ std::atomic<int> the_observer_proxy_count;
 #endif /* TBB_USE_ASSERT */
 
 void clear_address_waiter_table();
+void release_trace_buffers();
 void global_control_acquire();
 void global_control_release();
 
@@ -93,6 +98,7 @@ void governor::release_resources () {
     if( status )
         runtime_warning("failed to destroy task scheduler TLS: %s", std::strerror(status));
     clear_address_waiter_table();
+    release_trace_buffers();
 
 #if TBB_USE_ASSERT
     if (the_observer_proxy_count != 0) {
@@ -224,6 +230,7 @@ void governor::init_external_thread() {
     td.enter_task_dispatcher(task_disp, calculate_stealing_threshold(stack_base, stack_size));
 
     td.my_arena_slot->occupy();
+    a.note_cache_domains(*td.my_arena_slot);
     thr_control->register_thread(td);
     set_thread_data(td);
 #if (_WIN32||_WIN64) && !__TBB_DYNAMIC_LOAD_ENABLED
@@ -345,6 +352,7 @@ bool __TBB_EXPORTED_FUNC finalize(d1::task_scheduler_handle& handle, std::intptr
 #pragma weak __TBB_internal_apply_affinity
 #pragma weak __TBB_internal_restore_affinity
 #pragma weak __TBB_internal_get_default_concurrency
+#pragma weak __TBB_internal_get_cache_domains
 
 extern "C" {
 void __TBB_internal_initialize_system_topology(
@@ -362,6 +370,9 @@ void __TBB_internal_apply_affinity( binding_handler* handler_ptr, int slot_num )
 void __TBB_internal_restore_affinity( binding_handler* handler_ptr, int slot_num );
 
 int __TBB_internal_get_default_concurrency( int numa_id, int core_type_id, int max_threads_per_core );
+
+void __TBB_internal_get_cache_domains( int& processors_count, int*& l2_domains_list, int*& llc_domains_list,
+                                       int*& numa_domains_list );
 }
 #endif /* __TBB_WEAK_SYMBOLS_PRESENT */
 
@@ -391,6 +402,9 @@ static void (*restore_affinity_ptr)( binding_handler* handler_ptr, int slot_num
     = dummy_restore_affinity;
 int (*get_default_concurrency_ptr)( int numa_id, int core_type_id, int max_threads_per_core )
     = dummy_get_default_concurrency;
+// Optional handler, absent in the TBBbind libraries of the earlier versions
+static void (*get_cache_domains_ptr)( int& processors_count, int*& l2_domains_list, int*& llc_domains_list,
+                                      int*& numa_domains_list ) = nullptr;
 
 #if _WIN32 || _WIN64 || __unix__ || __APPLE__
 
@@ -409,6 +423,11 @@ static const dynamic_link_descriptor TbbBindLinkTable[] = {
 
 static const unsigned LinkTableSize = sizeof(TbbBindLinkTable) / sizeof(dynamic_link_descriptor);
 
+// Linked separately, so the TBBbind libraries without the cache domains information are still used.
+static const dynamic_link_descriptor TbbBindCacheDomainsLinkTable[] = {
+    DLD(__TBB_internal_get_cache_domains, get_cache_domains_ptr)
+};
+
 #if TBB_USE_DEBUG
 #define DEBUG_SUFFIX "_debug"
 #else
@@ -448,6 +467,12 @@ int* numa_nodes_indexes = nullptr;
 int  core_types_count = 0;
 int* core_types_indexes = nullptr;
 
+// The L2 and last level cache domains and the NUMA nodes of the processors, indexed by the OS processor index
+int  cache_domains_processors_count = 0;
+int* l2_domains_indexes = nullptr;
+int* llc_domains_indexes = nullptr;
+int* numa_domains_indexes = nullptr;
+
 const char* load_tbbbind_shared_object() {
 #if _WIN32 || _WIN64 || __unix__ || __APPLE__
 #if _WIN32 && !_WIN64
@@ -458,6 +483,7 @@ const char* load_tbbbind_shared_object() {
 #endif /* _WIN32 && !_WIN64 */
     for (const auto& tbbbind_version : {TBBBIND_2_5_NAME, TBBBIND_2_0_NAME, TBBBIND_NAME}) {
         if (dynamic_link(tbbbind_version, TbbBindLinkTable, LinkTableSize, nullptr, DYNAMIC_LINK_LOCAL_BINDING)) {
+            dynamic_link(tbbbind_version, TbbBindCacheDomainsLinkTable, 1, nullptr, DYNAMIC_LINK_LOCAL_BINDING);
             return tbbbind_version;
         }
     }
@@ -486,6 +512,10 @@ void initialization_impl() {
             numa_nodes_count, numa_nodes_indexes,
             core_types_count, core_types_indexes
         );
+        if (get_cache_domains_ptr) {
+            get_cache_domains_ptr(cache_domains_processors_count, l2_domains_indexes, llc_domains_indexes,
+                                  numa_domains_indexes);
+        }
 
         PrintExtraVersionInfo("TBBBIND", tbbbind_name);
         return;
@@ -533,6 +563,43 @@ void restore_affinity_mask(binding_handler* handler_ptr, int slot_index) {
     restore_affinity_ptr(handler_ptr, slot_index);
 }
 
+static int current_processor_index() {
+#if __linux__
+    return sched_getcpu();
+#elif _WIN32 || _WIN64
+    PROCESSOR_NUMBER processor;
+    GetCurrentProcessorNumberEx(&processor);
+    // TBBbind numbers the processors of a group after the processors of the previous groups
+    return int(processor.Group) * 64 + int(processor.Number);
+#else
+    return -1;
+#endif
+}
+
+void get_thread_cache_domains(int& l2_domain, int& llc_domain) {
+    l2_domain = llc_domain = -1;
+    // The topology is not loaded only for this purpose, since loading it takes noticeable time
+    if (system_topology::initialization_state.load(std::memory_order_acquire) != do_once_state::executed) {
+        return;
+    }
+    int processor = current_processor_index();
+    if (0 <= processor && processor < system_topology::cache_domains_processors_count) {
+        l2_domain = system_topology::l2_domains_indexes[processor];
+        llc_domain = system_topology::llc_domains_indexes[processor];
+    }
+}
+
+int get_thread_numa_domain() {
+    if (system_topology::initialization_state.load(std::memory_order_acquire) != do_once_state::executed) {
+        return -1;
+    }
+    int processor = current_processor_index();
+    if (0 <= processor && processor < system_topology::cache_domains_processors_count) {
+        return system_topology::numa_domains_indexes[processor];
+    }
+    return -1;
+}
+
 unsigned __TBB_EXPORTED_FUNC numa_node_count() {
     system_topology::initialize();
     return system_topology::numa_nodes_count;
@@ -598,6 +665,14 @@ int __TBB_EXPORTED_FUNC constraints_default_concurrency(const d1::constraints& c
 int __TBB_EXPORTED_FUNC constraints_threads_per_core(const d1::constraints&, intptr_t /*reserved*/) {
     return system_topology::automatic;
 }
+#else /* !__TBB_ARENA_BINDING */
+void get_thread_cache_domains(int& l2_domain, int& llc_domain) {
+    l2_domain = llc_domain = -1;
+}
+
+int get_thread_numa_domain() {
+    return -1;
+}
 #endif /* __TBB_ARENA_BINDING */
 
 } // namespace r1
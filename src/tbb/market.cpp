@@ -17,7 +17,9 @@
 #include "arena.h"
 #include "market.h"
 
-#include <algorithm> // std::find
+#include <algorithm> // std::find, std::stable_sort
+#include <climits>
+#include <cstdint>
 
 namespace tbb {
 namespace detail {
@@ -75,14 +77,60 @@ void market::update_allotment() {
 
     int unassigned_workers = max_workers;
     int assigned = 0;
-    int carry = 0;
     unsigned max_priority_level = num_priority_levels;
     for (unsigned list_idx = 0; list_idx < num_priority_levels; ++list_idx ) {
         int assigned_per_priority = min(my_priority_level_demand[list_idx], unassigned_workers);
         unassigned_workers -= assigned_per_priority;
-        // We use reverse iterator there to serve last added clients first
+
+        // The workers are shared in proportion to the demands multiplied by the weights. The clients
+        // whose share exceeds the demand get the demand, and the rest is shared among the others.
+        // Such clients are the ones with the greatest weights, so they are marked by the weight limit.
+        unsigned saturation_weight = UINT_MAX;
+        int shared_workers = 0;
+        std::uint64_t weighted_demand = 0;
+        // Both passes must see the same weights, otherwise a client can be given a share of no demand
+        for (pm_client* c : my_clients[list_idx]) {
+            c->update_weight();
+        }
+        for (;;) {
+            shared_workers = assigned_per_priority;
+            weighted_demand = 0;
+            for (pm_client* c : my_clients[list_idx]) {
+                if (c->weight() >= saturation_weight) {
+                    shared_workers -= c->max_workers();
+                } else {
+                    weighted_demand += std::uint64_t(c->weight()) * c->max_workers();
+                }
+            }
+            unsigned min_saturated_weight = saturation_weight;
+            for (pm_client* c : my_clients[list_idx]) {
+                if (c->max_workers() > 0 && c->weight() < min_saturated_weight &&
+                    std::uint64_t(c->weight()) * shared_workers >= weighted_demand) {
+                    min_saturated_weight = c->weight();
+                }
+            }
+            if (min_saturated_weight == saturation_weight) {
+                break;
+            }
+            saturation_weight = min_saturated_weight;
+        }
+        __TBB_ASSERT(shared_workers >= 0, nullptr);
+
+        // We use reverse iterator there to serve last added clients first. The clients with the earlier
+        // pending deadlines are served last, so they get the workers left by the rounding of the shares.
+        // The deadlines are read once, since the enqueueing threads change them concurrently.
+        my_allotment_order.clear();
         for (auto it = my_clients[list_idx].rbegin(); it != my_clients[list_idx].rend(); ++it) {
-            tbb_permit_manager_client& client = static_cast<tbb_permit_manager_client&>(**it);
+            my_allotment_order.emplace_back((*it)->earliest_deadline(), *it);
+        }
+        std::stable_sort(my_allotment_order.begin(), my_allotment_order.end(),
+            [] (const std::pair<std::uint64_t, pm_client*>& lhs, const std::pair<std::uint64_t, pm_client*>& rhs) {
+                return lhs.first > rhs.first;
+            });
+
+        std::uint64_t carry = 0;
+        for (auto& item : my_allotment_order) {
+            tbb_permit_manager_client& client = static_cast<tbb_permit_manager_client&>(*item.second);
             if (client.max_workers() == 0) {
                 client.set_allotment(0);
                 continue;
@@ -96,10 +144,12 @@ void market::update_allotment() {
             if (my_num_workers_soft_limit == 0) {
                 __TBB_ASSERT(max_workers == 0 || max_workers == 1, nullptr);
                 allotted = client.min_workers() > 0 && assigned < max_workers ? 1 : 0;
+            } else if (client.weight() >= saturation_weight) {
+                allotted = client.max_workers();
             } else {
-                int tmp = client.max_workers() * assigned_per_priority + carry;
-                allotted = tmp / my_priority_level_demand[list_idx];
-                carry = tmp % my_priority_level_demand[list_idx];
+                std::uint64_t tmp = std::uint64_t(client.weight()) * client.max_workers() * shared_workers + carry;
+                allotted = int(tmp / weighted_demand);
+                carry = tmp % weighted_demand;
                 __TBB_ASSERT(allotted <= client.max_workers(), nullptr);
             }
             client.set_allotment(allotted);
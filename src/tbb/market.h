@@ -25,6 +25,8 @@
 #include "pm_client.h"
 
 #include <atomic>
+#include <cstdint>
+#include <utility>
 #include <vector>
 
 namespace tbb {
@@ -69,6 +71,12 @@ private:
     //! Per priority list of registered arenas
     using clients_container_type = std::vector<pm_client*, tbb::tbb_allocator<pm_client*>>;
     clients_container_type my_clients[num_priority_levels];
+
+    //! The clients of a priority list in the order of sharing the workers, paired with their earliest deadlines
+    /** Kept between the calls of update_allotment to avoid the allocations under the lock. **/
+    using allotment_order_type = std::vector<std::pair<std::uint64_t, pm_client*>,
+                                             tbb::tbb_allocator<std::pair<std::uint64_t, pm_client*>>>;
+    allotment_order_type my_allotment_order;
 }; // class market
 
 } // namespace r1
@@ -216,6 +216,14 @@ struct cpu_features_type {
 
 void detect_cpu_features(cpu_features_type& cpu_features);
 
+//! Gets the indices of the L2 and last level cache domains of the processor running the calling thread
+/** The indices are -1 if they are unknown, in particular if the system topology has not been loaded by TBBbind. **/
+void get_thread_cache_domains(int& l2_domain, int& llc_domain);
+
+//! Gets the index of the NUMA node of the processor running the calling thread, or -1 if it is unknown
+/** Like the cache domains, the node is known only after the system topology has been loaded by TBBbind. **/
+int get_thread_numa_domain();
+
 #if __TBB_ARENA_BINDING
 class binding_handler;
 
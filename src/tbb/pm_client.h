@@ -32,10 +32,27 @@ public:
         return my_arena.priority_level();
     }
 
+    //! The weight of the arena as of the latest update_weight call
+    unsigned weight() const {
+        return my_weight;
+    }
+
+    //! Reads the weight of the arena that task_arena::set_weight can change at any time
+    /** Called under the lock of the resource manager, so the weight does not change while the
+        workers are shared. **/
+    void update_weight() {
+        my_weight = my_arena.weight();
+    }
+
     void set_top_priority(bool b) {
         my_arena.set_top_priority(b);
     }
 
+    //! The earliest deadline of the tasks enqueued into the arena or no_deadline if there are none
+    std::uint64_t earliest_deadline() const {
+        return my_arena.my_deadline_task_stream.earliest_deadline();
+    }
+
     int min_workers() const {
         return my_min_workers;
     }
@@ -67,6 +84,7 @@ protected:
     arena& my_arena;
     int my_min_workers{0};
     int my_max_workers{0};
+    unsigned my_weight{d1::default_arena_weight};
 };
 
 } // namespace r1
@@ -28,6 +28,7 @@
 #include "co_context.h"
 #include "misc.h"
 #include "governor.h"
+#include "scratch_arena.h"
 
 #ifndef __TBB_SCHEDULER_MUTEX_TYPE
 #define __TBB_SCHEDULER_MUTEX_TYPE tbb::spin_mutex
@@ -40,6 +41,7 @@
 #include <atomic>
 #endif
 
+#include <chrono>
 #include <cstdint>
 #include <exception>
 #include <memory> // unique_ptr
@@ -238,7 +240,7 @@ inline void prolonged_pause_impl() {
 }
 #endif
 
-inline void prolonged_pause() {
+inline void prolonged_pause(bool fast_wakeup = false) {
 #if __TBB_WAITPKG_INTRINSICS_PRESENT
     if (governor::wait_package_enabled()) {
         std::uint64_t time_stamp = machine_time_stamp();
@@ -247,11 +249,33 @@ inline void prolonged_pause() {
         // Constant "1000" is ticks to wait for.
         // TODO : Modify this parameter based on empirical study of benchmarks.
         // First parameter 0 selects between a lower power (cleared) or faster wakeup (set) optimized state.
-        _tpause(0, time_stamp + 1000);
+        _tpause(fast_wakeup ? 1 : 0, time_stamp + 1000);
     }
     else
 #endif
-    prolonged_pause_impl();
+    {
+        suppress_unused_warning(fast_wakeup);
+        prolonged_pause_impl();
+    }
+}
+
+//! How long the threads search for work before they block
+struct wait_policy_settings {
+    //! The number of the pauses per arena slot before a thread starts yielding
+    int pauses_per_slot;
+    //! The number of the yields before a thread reports that the arena is out of work
+    int yields;
+    //! How long a worker waits for new work before it leaves the arena
+    std::chrono::microseconds worker_leave_duration;
+    //! Selects the faster wakeup state of the pauses
+    bool fast_wakeup;
+};
+
+//! The settings of the policy set by global_control::worker_wait_policy
+extern std::atomic<const wait_policy_settings*> the_wait_policy_settings;
+
+inline const wait_policy_settings& current_wait_policy() {
+    return *the_wait_policy_settings.load(std::memory_order_relaxed);
 }
 
 // TODO: investigate possibility to work with number of CPU cycles
@@ -261,21 +285,24 @@ inline void prolonged_pause() {
 class stealing_loop_backoff {
     const int my_pause_threshold;
     const int my_yield_threshold;
+    const bool my_fast_wakeup;
     int my_pause_count;
     int my_yield_count;
 public:
-    // my_yield_threshold = 100 is an experimental value. Ideally, once we start calling __TBB_Yield(),
-    // the time spent spinning before calling out_of_work() should be approximately
+    // The balanced policy yields 100 times, which is an experimental value. Ideally, once we start
+    // calling __TBB_Yield(), the time spent spinning before calling out_of_work() should be approximately
     // the time it takes for a thread to be woken up. Doing so would guarantee that we do
     // no worse than 2x the optimal spin time. Or perhaps a time-slice quantum is the right amount.
-    stealing_loop_backoff(int num_workers, int yields_multiplier)
-        : my_pause_threshold{ 2 * (num_workers + 1) }
-        , my_yield_threshold{100 * yields_multiplier}
+    stealing_loop_backoff(int num_workers, int yields_multiplier,
+                          const wait_policy_settings& policy = current_wait_policy())
+        : my_pause_threshold{ policy.pauses_per_slot * (num_workers + 1) }
+        , my_yield_threshold{ policy.yields * yields_multiplier }
+        , my_fast_wakeup{ policy.fast_wakeup }
         , my_pause_count{}
         , my_yield_count{}
     {}
     bool pause() {
-        prolonged_pause();
+        prolonged_pause(my_fast_wakeup);
         if (my_pause_count++ >= my_pause_threshold) {
             my_pause_count = my_pause_threshold;
             d0::yield();
@@ -483,6 +510,12 @@ public:
                       >
         m_reference_vertex_map;
 
+    //! The memory allocated by the tasks during their execution on this dispatcher
+    scratch_arena m_scratch_arena;
+
+    //! The number of the nested task executions; traced when the dispatcher is suspended and resumed
+    std::uint32_t m_num_executing_tasks{0};
+
     //! Attempt to get a task from the mailbox.
     /** Gets a task only if it has not been executed by its sender or a thief
         that has stolen it from the sender's task pool. Otherwise returns nullptr.
@@ -556,6 +589,7 @@ public:
     d1::task* get_stream_or_critical_task(execution_data_ext&, arena&, task_stream<front_accessor>&,
                                       unsigned& /*hint_for_stream*/, isolation_type,
                                       bool /*critical_allowed*/);
+    d1::task* get_deadline_or_critical_task(execution_data_ext&, arena&, isolation_type, bool /*critical_allowed*/);
     d1::task* steal_or_get_critical(execution_data_ext&, arena&, unsigned /*arena_index*/, FastRandom&,
                                 isolation_type, bool /*critical_allowed*/);
 
@@ -0,0 +1,93 @@
+/*
+    Copyright (c) 2024 Intel Corporation
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "oneapi/tbb/detail/_config.h"
+#include "oneapi/tbb/scheduler_statistics.h"
+
+#include "co_stack_pool.h"
+#include "governor.h"
+#include "threading_control.h"
+#include "thread_data.h"
+
+namespace tbb {
+namespace detail {
+namespace r1 {
+
+static void read_steal_counters(const steal_counters& counters, d1::steal_statistics& stats) {
+    // The counters can be modified concurrently, so the attempts are derived from the loaded values
+    stats.successes = counters.successes.load(std::memory_order_relaxed);
+    stats.failures = counters.failures.load(std::memory_order_relaxed);
+    stats.attempts = stats.successes + stats.failures;
+    stats.tasks_stolen = counters.tasks_stolen.load(std::memory_order_relaxed);
+    stats.cache_local_steals = counters.cache_local_successes.load(std::memory_order_relaxed);
+}
+
+void __TBB_EXPORTED_FUNC get_thread_steal_statistics(d1::steal_statistics& stats) {
+    stats = d1::steal_statistics{};
+    if (thread_data* td = governor::get_thread_data_if_initialized()) {
+        read_steal_counters(td->my_steal_counters, stats);
+    }
+}
+
+std::size_t __TBB_EXPORTED_FUNC fill_steal_statistics(d1::steal_statistics* buffer, std::size_t size) {
+    std::size_t num_threads = 0;
+    threading_control::for_each_thread([&] (thread_data& td) {
+        if (num_threads < size) {
+            read_steal_counters(td.my_steal_counters, buffer[num_threads]);
+        }
+        ++num_threads;
+    });
+    return num_threads;
+}
+
+static void read_pool_counters(const small_object_pool_impl& pool, d1::small_object_pool_statistics& stats) {
+    const small_object_pool_counters& counters = pool.counters();
+    stats.local_allocations = counters.local_allocations.load(std::memory_order_relaxed);
+    stats.remote_allocations = counters.remote_allocations.load(std::memory_order_relaxed);
+    stats.new_allocations = counters.new_allocations.load(std::memory_order_relaxed);
+    stats.local_deallocations = counters.local_deallocations.load(std::memory_order_relaxed);
+    stats.remote_deallocations = counters.remote_deallocations.load(std::memory_order_relaxed);
+    stats.remote_batches = counters.remote_batches.load(std::memory_order_relaxed);
+    stats.public_list_length = pool.public_list_length();
+}
+
+void __TBB_EXPORTED_FUNC get_thread_small_object_pool_statistics(d1::small_object_pool_statistics& stats) {
+    stats = d1::small_object_pool_statistics{};
+    if (thread_data* td = governor::get_thread_data_if_initialized()) {
+        read_pool_counters(*td->my_small_object_pool, stats);
+    }
+}
+
+std::size_t __TBB_EXPORTED_FUNC fill_small_object_pool_statistics(d1::small_object_pool_statistics* buffer, std::size_t size) {
+    std::size_t num_threads = 0;
+    threading_control::for_each_thread([&] (thread_data& td) {
+        if (num_threads < size) {
+            read_pool_counters(*td.my_small_object_pool, buffer[num_threads]);
+        }
+        ++num_threads;
+    });
+    return num_threads;
+}
+
+void __TBB_EXPORTED_FUNC get_scheduler_metrics(d1::scheduler_metrics& metrics) {
+    metrics = d1::scheduler_metrics{};
+    threading_control::collect_metrics(metrics);
+    co_stack_pool::collect_metrics(metrics);
+}
+
+} // namespace r1
+} // namespace detail
+} // namespace tbb
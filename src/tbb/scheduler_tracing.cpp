@@ -0,0 +1,262 @@
+/*
+    Copyright (c) 2024 Intel Corporation
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "oneapi/tbb/detail/_config.h"
+#include "oneapi/tbb/scheduler_tracing.h"
+#include "oneapi/tbb/cache_aligned_allocator.h"
+#include "oneapi/tbb/spin_mutex.h"
+
+#include "scheduler_tracing.h"
+#include "governor.h"
+#include "thread_data.h"
+
+#include <chrono>
+#include <cstdio>
+#include <new>
+#include <vector>
+
+namespace tbb {
+namespace detail {
+namespace r1 {
+
+std::atomic<bool> the_scheduler_tracing_enabled{false};
+
+std::size_t trace_buffer::copy_events(event* buffer) const {
+    std::uint64_t first_event = my_first_event.load(std::memory_order_acquire);
+    std::uint64_t tail = my_tail.load(std::memory_order_acquire);
+    std::uint64_t begin = tail > capacity ? tail - capacity : 0;
+    // The events of the previous owner of the buffer are not reported
+    begin = begin > first_event ? begin : first_event;
+    for (std::uint64_t i = begin; i < tail; ++i) {
+        const event_slot& slot = my_events[i % capacity];
+        event& e = buffer[i - begin];
+        e.time_stamp = slot.time_stamp.load(std::memory_order_relaxed);
+        std::uint64_t payload = slot.payload.load(std::memory_order_relaxed);
+        e.type = trace_event_type(payload & 0xff);
+        e.argument = payload >> 8;
+    }
+    // If an overwritten slot was read, the tail loaded after the fence covers the overwriting event.
+    // The event with the index equal to the new tail might be being recorded right now.
+    std::atomic_thread_fence(std::memory_order_acquire);
+    std::uint64_t new_tail = my_tail.load(std::memory_order_relaxed);
+    std::uint64_t valid_begin = new_tail >= capacity ? new_tail - capacity + 1 : 0;
+    if (valid_begin <= begin) {
+        return std::size_t(tail - begin);
+    }
+    if (valid_begin >= tail) {
+        return 0;
+    }
+    std::size_t num_skipped = std::size_t(valid_begin - begin);
+    std::size_t num_events = std::size_t(tail - valid_begin);
+    for (std::size_t i = 0; i < num_events; ++i) {
+        buffer[i] = buffer[i + num_skipped];
+    }
+    return num_events;
+}
+
+//! The list of the buffers of all threads that have recorded an event
+/** The buffers are not freed until the library is unloaded, so the list can be traversed without the lock. **/
+static std::atomic<trace_buffer*> trace_buffers_head{nullptr};
+static spin_mutex trace_buffers_mutex;
+//! The number of the threads that have started recording; used as the identifiers of the threads
+static std::size_t trace_threads_count{0};
+//! The buffers of the exited threads; reused by the new threads, so the number of the buffers does
+//! not exceed the number of the threads recording at the same time
+static trace_buffer* trace_free_buffers{nullptr};
+
+//! The moment the first buffer was created; used to convert the time stamps into the time
+static std::uint64_t trace_start_time_stamp{0};
+static std::chrono::steady_clock::time_point trace_start_time{};
+
+trace_buffer* acquire_trace_buffer(bool is_worker) {
+    spin_mutex::scoped_lock lock(trace_buffers_mutex);
+    if (trace_threads_count == 0) {
+        trace_start_time = std::chrono::steady_clock::now();
+        trace_start_time_stamp = trace_time_stamp();
+    }
+    if (trace_buffer* buffer = trace_free_buffers) {
+        trace_free_buffers = buffer->my_next_free;
+        buffer->reuse(trace_threads_count++, is_worker);
+        return buffer;
+    }
+    void* storage = cache_aligned_allocate(sizeof(trace_buffer));
+    trace_buffer* buffer = new (storage) trace_buffer(trace_threads_count++, is_worker);
+    buffer->my_next = trace_buffers_head.load(std::memory_order_relaxed);
+    trace_buffers_head.store(buffer, std::memory_order_release);
+    return buffer;
+}
+
+void release_trace_buffer(trace_buffer* buffer) {
+    spin_mutex::scoped_lock lock(trace_buffers_mutex);
+    buffer->my_next_free = trace_free_buffers;
+    trace_free_buffers = buffer;
+}
+
+void release_trace_buffers() {
+    spin_mutex::scoped_lock lock(trace_buffers_mutex);
+    trace_buffer* buffer = trace_buffers_head.exchange(nullptr);
+    while (buffer) {
+        trace_buffer* next = buffer->my_next;
+        buffer->~trace_buffer();
+        cache_aligned_deallocate(buffer);
+        buffer = next;
+    }
+    trace_free_buffers = nullptr;
+    trace_threads_count = 0;
+}
+
+void trace_current_thread(trace_event_type type, std::uint64_t argument) {
+    if (thread_data* td = governor::get_thread_data_if_initialized()) {
+        td->my_tracer.record(type, argument);
+    }
+}
+
+//! Writes the events in the Chrome trace event format, which is also understood by Perfetto
+class trace_writer {
+public:
+    trace_writer(std::FILE* file, double ticks_per_microsecond)
+        : my_file(file), my_ticks_per_microsecond(ticks_per_microsecond) {}
+
+    void write_thread(const trace_buffer& buffer, const trace_buffer::event* events, std::size_t num_events) {
+        my_tid = buffer.thread_id();
+        std::fprintf(my_file, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%llu,"
+            "\"args\":{\"name\":\"%s %llu\"}}", separator(), (unsigned long long)my_tid,
+            buffer.is_worker() ? "TBB worker" : "External thread", (unsigned long long)my_tid);
+        for (std::size_t i = 0; i < num_events; ++i) {
+            write_event(events[i]);
+        }
+    }
+
+private:
+    const char* separator() {
+        const char* s = my_is_first ? "\n" : ",\n";
+        my_is_first = false;
+        return s;
+    }
+
+    void begin_event(const char* name, const char* phase, std::uint64_t time_stamp) {
+        // The events recorded before the start point were recorded with another time base
+        double ts = time_stamp > trace_start_time_stamp ? (time_stamp - trace_start_time_stamp) / my_ticks_per_microsecond : 0.;
+        std::fprintf(my_file, "%s{\"name\":\"%s\",\"cat\":\"scheduler\",\"ph\":\"%s\",\"ts\":%.3f,\"pid\":1,\"tid\":%llu",
+            separator(), name, phase, ts, (unsigned long long)my_tid);
+        if (phase[0] == 'i') {
+            std::fputs(",\"s\":\"t\"", my_file);
+        }
+    }
+
+    void write_object(const char* name, const char* phase, const trace_buffer::event& e, const char* arg_name) {
+        begin_event(name, phase, e.time_stamp);
+        std::fprintf(my_file, ",\"args\":{\"%s\":\"0x%llx\"}}", arg_name, (unsigned long long)e.argument);
+    }
+
+    void write_plain(const char* name, const char* phase, const trace_buffer::event& e) {
+        begin_event(name, phase, e.time_stamp);
+        std::fputs("}", my_file);
+    }
+
+    void write_event(const trace_buffer::event& e) {
+        switch (e.type) {
+        case trace_event_type::spawn:
+            write_object("spawn", "i", e, "task");
+            break;
+        case trace_event_type::steal:
+            begin_event("steal", "i", e.time_stamp);
+            std::fprintf(my_file, ",\"args\":{\"victim\":%llu,\"tasks\":%llu}}",
+                (unsigned long long)(e.argument & 0xffffffff), (unsigned long long)(e.argument >> 32));
+            break;
+        case trace_event_type::execute_begin:
+            write_object("execute", "B", e, "task");
+            break;
+        case trace_event_type::execute_end:
+            write_plain("execute", "E", e);
+            break;
+        case trace_event_type::sleep:
+            write_plain("sleep", "B", e);
+            break;
+        case trace_event_type::wake:
+            write_plain("sleep", "E", e);
+            break;
+        case trace_event_type::arena_join:
+            write_object("arena", "B", e, "arena");
+            break;
+        case trace_event_type::arena_leave:
+            write_plain("arena", "E", e);
+            break;
+        case trace_event_type::mailbox_hit:
+            write_object("mailbox hit", "i", e, "task");
+            break;
+        case trace_event_type::mailbox_miss:
+            write_plain("mailbox miss", "i", e);
+            break;
+        case trace_event_type::suspend:
+            for (std::uint64_t i = 0; i < e.argument; ++i) {
+                write_plain("execute", "E", e);
+            }
+            write_plain("suspend", "i", e);
+            break;
+        case trace_event_type::resume:
+            write_plain("resume", "i", e);
+            for (std::uint64_t i = 0; i < e.argument; ++i) {
+                write_plain("execute", "B", e);
+            }
+            break;
+        }
+    }
+
+    std::FILE* my_file;
+    const double my_ticks_per_microsecond;
+    std::size_t my_tid{0};
+    bool my_is_first{true};
+};
+
+bool __TBB_EXPORTED_FUNC dump_scheduler_trace(const char* file_name) {
+    __TBB_ASSERT(file_name, "The file name is required");
+    std::FILE* file = std::fopen(file_name, "w");
+    if (!file) {
+        return false;
+    }
+
+    trace_buffer* head = nullptr;
+    double ticks_per_microsecond = 1.;
+    {
+        spin_mutex::scoped_lock lock(trace_buffers_mutex);
+        head = trace_buffers_head.load(std::memory_order_acquire);
+        if (head) {
+            // Calibrate the time stamp counter over the whole tracing period
+            std::uint64_t ticks = trace_time_stamp() - trace_start_time_stamp;
+            double microseconds = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - trace_start_time).count();
+            if (ticks > 0 && microseconds > 0.) {
+                ticks_per_microsecond = ticks / microseconds;
+            }
+        }
+    }
+
+    std::fputs("{\"traceEvents\":[", file);
+    trace_writer writer(file, ticks_per_microsecond);
+    std::vector<trace_buffer::event> events(head ? trace_buffer::capacity : 0);
+    for (trace_buffer* buffer = head; buffer; buffer = buffer->my_next) {
+        std::size_t num_events = buffer->copy_events(events.data());
+        writer.write_thread(*buffer, events.data(), num_events);
+    }
+    std::fputs("\n],\"displayTimeUnit\":\"ns\"}\n", file);
+
+    bool is_written = !std::ferror(file);
+    return std::fclose(file) == 0 && is_written;
+}
+
+} // namespace r1
+} // namespace detail
+} // namespace tbb
@@ -0,0 +1,195 @@
+/*
+    Copyright (c) 2024 Intel Corporation
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#ifndef _TBB_scheduler_tracing_H
+#define _TBB_scheduler_tracing_H
+
+#include "oneapi/tbb/detail/_config.h"
+#include "oneapi/tbb/detail/_utils.h"
+
+#include "scheduler_common.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace tbb {
+namespace detail {
+namespace r1 {
+
+//! Kinds of the events recorded by the scheduler tracing
+enum class trace_event_type : std::uint8_t {
+    //! A task is put into the local task pool; the argument is the task
+    spawn,
+    //! Tasks are taken from another slot; the argument is the victim slot and the number of tasks
+    steal,
+    //! The argument of the beginning of the task execution is the task
+    execute_begin,
+    execute_end,
+    //! The thread is going to block until new work appears
+    sleep,
+    wake,
+    //! The argument of joining an arena is the arena
+    arena_join,
+    arena_leave,
+    //! A task mailed to the thread is taken from its mailbox; the argument is the task
+    mailbox_hit,
+    //! A task mailed to the thread has already been executed by another thread
+    mailbox_miss,
+    //! The thread switches from or back to a suspended task dispatcher; the argument is the number
+    //! of the tasks it executes, whose executions are ended or begun again in the trace of the thread
+    suspend,
+    resume
+};
+
+//! Packs the victim slot and the number of the taken tasks into the argument of the steal event
+inline std::uint64_t steal_trace_argument(std::size_t victim, std::size_t num_tasks) {
+    return std::uint64_t(num_tasks) << 32 | std::uint32_t(victim);
+}
+
+//! Returns the time stamp of the traced events
+/** The time stamp counter is read when it is available, since it is much cheaper than the system clock. **/
+inline std::uint64_t trace_time_stamp() {
+#if (_WIN32 || _WIN64 || __unix__ || __APPLE__) && (__TBB_x86_32 || __TBB_x86_64)
+    return machine_time_stamp();
+#else
+    return std::uint64_t(std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+}
+
+//! Ring buffer of the events recorded by a single thread
+/** Only the owning thread records the events, and it overwrites the oldest ones when the buffer is full.
+    The events can be copied by another thread concurrently with the recording. **/
+class trace_buffer {
+public:
+    static constexpr std::size_t capacity = 16 * 1024;
+
+    struct event {
+        std::uint64_t time_stamp;
+        trace_event_type type;
+        std::uint64_t argument;
+    };
+
+    trace_buffer(std::size_t thread_id, bool is_worker) : my_thread_id(thread_id), my_is_worker(is_worker) {}
+
+    //! Passes the buffer of an exited thread to another thread
+    /** The events of the exited thread are not reported anymore. **/
+    void reuse(std::size_t thread_id, bool is_worker) {
+        my_thread_id.store(thread_id, std::memory_order_relaxed);
+        my_is_worker.store(is_worker, std::memory_order_relaxed);
+        my_first_event.store(my_tail.load(std::memory_order_relaxed), std::memory_order_release);
+    }
+
+    void record(trace_event_type type, std::uint64_t argument) {
+        std::uint64_t tail = my_tail.load(std::memory_order_relaxed);
+        // Orders the publication of the previous event before the slot is overwritten, see copy_events
+        std::atomic_thread_fence(std::memory_order_release);
+        event_slot& slot = my_events[tail % capacity];
+        slot.time_stamp.store(trace_time_stamp(), std::memory_order_relaxed);
+        // The argument is either a small number or an address, so its upper bits are not used
+        slot.payload.store(argument << 8 | std::uint64_t(type), std::memory_order_relaxed);
+        my_tail.store(tail + 1, std::memory_order_release);
+    }
+
+    //! Copies the recorded events in the order of the recording, and returns their number
+    /** The size of the buffer must be at least capacity. The events that could have been overwritten
+        during the copying are skipped. **/
+    std::size_t copy_events(event* buffer) const;
+
+    std::size_t thread_id() const { return my_thread_id.load(std::memory_order_relaxed); }
+    bool is_worker() const { return my_is_worker.load(std::memory_order_relaxed); }
+
+    //! The next buffer in the list of all buffers
+    trace_buffer* my_next{nullptr};
+
+    //! The next buffer in the list of the buffers released by the exited threads
+    trace_buffer* my_next_free{nullptr};
+
+private:
+    struct event_slot {
+        std::atomic<std::uint64_t> time_stamp{0};
+        std::atomic<std::uint64_t> payload{0};
+    };
+
+    std::atomic<std::size_t> my_thread_id;
+    std::atomic<bool> my_is_worker;
+
+    //! The number of the events recorded so far
+    std::atomic<std::uint64_t> my_tail{0};
+
+    //! The index of the first event recorded by the current owner of the buffer
+    std::atomic<std::uint64_t> my_first_event{0};
+
+    event_slot my_events[capacity];
+};
+
+//! Indicates if the threads record the scheduler events
+/** Controlled by the TBB_SCHEDULER_TRACING environment variable and global_control::scheduler_tracing. **/
+extern std::atomic<bool> the_scheduler_tracing_enabled;
+
+inline bool is_scheduler_tracing_enabled() {
+    return the_scheduler_tracing_enabled.load(std::memory_order_relaxed);
+}
+
+//! Returns a buffer released by an exited thread, or creates a buffer and adds it to the list of all buffers
+trace_buffer* acquire_trace_buffer(bool is_worker);
+
+//! Makes the buffer of the exiting thread available to the threads that start recording
+void release_trace_buffer(trace_buffer* buffer);
+
+//! Frees the buffers; called when the library is unloaded
+void release_trace_buffers();
+
+//! Records the event in the buffer of the calling thread if it is known to the library
+void trace_current_thread(trace_event_type type, std::uint64_t argument);
+
+//! The scheduler events recorder of a thread
+class thread_tracer {
+public:
+    explicit thread_tracer(bool is_worker) : my_is_worker(is_worker) {}
+
+    ~thread_tracer() {
+        if (my_buffer) {
+            release_trace_buffer(my_buffer);
+        }
+    }
+
+    void record(trace_event_type type, std::uint64_t argument = 0) {
+        if (is_scheduler_tracing_enabled()) {
+            // The buffer is created on the first event, so the threads do not pay for the tracing being off
+            if (!my_buffer) {
+                my_buffer = acquire_trace_buffer(my_is_worker);
+            }
+            my_buffer->record(type, argument);
+        }
+    }
+
+    void record(trace_event_type type, const void* object) {
+        record(type, std::uint64_t(reinterpret_cast<std::uintptr_t>(object)));
+    }
+
+private:
+    //! The buffer outlives the thread, so its events are reported until another thread reuses it
+    trace_buffer* my_buffer{nullptr};
+    const bool my_is_worker;
+};
+
+} // namespace r1
+} // namespace detail
+} // namespace tbb
+
+#endif // _TBB_scheduler_tracing_H
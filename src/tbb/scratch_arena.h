@@ -0,0 +1,157 @@
+/*
+    Copyright (c) 2024 Intel Corporation
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#ifndef _TBB_scratch_arena_H
+#define _TBB_scratch_arena_H
+
+#include "oneapi/tbb/detail/_assert.h"
+#include "oneapi/tbb/detail/_exception.h"
+#include "oneapi/tbb/detail/_utils.h"
+#include "oneapi/tbb/cache_aligned_allocator.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+namespace tbb {
+namespace detail {
+namespace r1 {
+
+//! The bump pointer allocator of the memory used by the tasks during their execution
+/** The task dispatcher marks the position before the execution of a task and releases the
+    memory allocated after it when the execution completes. The executions on the same
+    dispatcher are nested, so the memory is released in the reverse order of allocation.
+    The released chunks are kept for the next tasks, except for the oversized ones. **/
+class scratch_arena : no_copy {
+public:
+    //! The size of the regular chunk
+    static constexpr std::size_t chunk_size = 64 * 1024;
+
+    ~scratch_arena() {
+        while (my_first) {
+            chunk* next = my_first->next;
+            cache_aligned_deallocate(my_first);
+            my_first = next;
+        }
+    }
+
+    //! Starts an execution that releases the memory allocated in it; returns the position to release
+    char* enter_scope() {
+#if TBB_USE_ASSERT
+        ++my_num_scopes;
+#endif
+        return my_top;
+    }
+
+    //! Ends the execution started by enter_scope and releases its memory
+    void leave_scope(char* mark) {
+        release(mark);
+#if TBB_USE_ASSERT
+        __TBB_ASSERT(my_num_scopes > 0, nullptr);
+        --my_num_scopes;
+#endif
+    }
+
+    void* allocate(std::size_t size, std::size_t alignment) {
+        __TBB_ASSERT(is_power_of_two(alignment), "The alignment must be a power of two");
+        // Otherwise, nothing releases the memory
+        __TBB_ASSERT(my_num_scopes > 0, "The scratch memory can be allocated only by a task or inside task_arena::execute");
+        std::uintptr_t top = std::uintptr_t(my_top);
+        std::uintptr_t aligned = (top + alignment - 1) & ~std::uintptr_t(alignment - 1);
+        if (my_top && size <= std::uintptr_t(my_end) - top && aligned - top <= std::uintptr_t(my_end) - top - size) {
+            my_top = reinterpret_cast<char*>(aligned + size);
+            return reinterpret_cast<void*>(aligned);
+        }
+        return allocate_in_next_chunk(size, alignment);
+    }
+
+    //! Releases the memory allocated after the mark
+    void release(char* mark) {
+        if (my_top != mark) {
+            release_chunks(mark);
+        }
+    }
+
+private:
+    struct alignas(alignof(std::max_align_t)) chunk {
+        chunk(chunk* prev_chunk, chunk* next_chunk, std::size_t data_size)
+            : prev(prev_chunk), next(next_chunk), size(data_size) {}
+
+        char* begin() { return reinterpret_cast<char*>(this + 1); }
+        char* end() { return begin() + size; }
+        bool contains(const char* position) { return begin() <= position && position <= end(); }
+
+        chunk* prev;
+        chunk* next;
+        std::size_t size;
+    };
+
+    void* allocate_in_next_chunk(std::size_t size, std::size_t alignment) {
+        if (size > ~std::size_t(0) - sizeof(chunk) - alignment) {
+            throw_exception(exception_id::bad_alloc);
+        }
+        std::size_t required = size + alignment - 1;
+        chunk* next = my_chunk ? my_chunk->next : my_first;
+        if (!next || next->size < required) {
+            // The smaller chunk stays after the new one for the next tasks
+            std::size_t data_size = required > chunk_size ? required : chunk_size;
+            next = new (cache_aligned_allocate(sizeof(chunk) + data_size)) chunk(my_chunk, next, data_size);
+            if (next->next) {
+                next->next->prev = next;
+            }
+            (my_chunk ? my_chunk->next : my_first) = next;
+        }
+        my_chunk = next;
+        std::uintptr_t aligned = (std::uintptr_t(next->begin()) + alignment - 1) & ~std::uintptr_t(alignment - 1);
+        my_top = reinterpret_cast<char*>(aligned + size);
+        my_end = next->end();
+        return reinterpret_cast<void*>(aligned);
+    }
+
+    void release_chunks(char* mark) {
+        // Step back to the chunk that contains the mark
+        while (my_chunk && !my_chunk->contains(mark)) {
+            chunk* released = my_chunk;
+            my_chunk = released->prev;
+            if (released->size > chunk_size) {
+                // The oversized chunks are not kept to bound the memory held by the dispatcher
+                (my_chunk ? my_chunk->next : my_first) = released->next;
+                if (released->next) {
+                    released->next->prev = my_chunk;
+                }
+                cache_aligned_deallocate(released);
+            }
+        }
+        my_top = my_chunk ? mark : nullptr;
+        my_end = my_chunk ? my_chunk->end() : nullptr;
+    }
+
+    char* my_top{nullptr};
+    char* my_end{nullptr};
+    //! The chunk that contains the top, or nullptr if no memory is allocated
+    chunk* my_chunk{nullptr};
+    chunk* my_first{nullptr};
+#if TBB_USE_ASSERT
+    //! The number of the executions that release the memory allocated in them, see enter_scope
+    int my_num_scopes{0};
+#endif
+};
+
+} // namespace r1
+} // namespace detail
+} // namespace tbb
+
+#endif /* _TBB_scratch_arena_H */
@@ -51,17 +51,23 @@ void* small_object_pool_impl::allocate_impl(d1::small_object_pool*& allocator, s
         if (m_private_list) {
             obj = m_private_list;
             m_private_list = m_private_list->next;
+            increase_counter(m_counters.local_allocations, 1);
         } else if (m_public_list.load(std::memory_order_relaxed)) {
+            // The length is approximate: it is not updated atomically with the list
+            m_public_list_length.store(0, std::memory_order_relaxed);
             // No fence required for read of my_public_list above, because std::atomic::exchange() has a fence.
             obj = m_public_list.exchange(nullptr);
             __TBB_ASSERT( obj, "another thread emptied the my_public_list" );
             m_private_list = obj->next;
+            increase_counter(m_counters.remote_allocations, 1);
         } else {
             obj = new (cache_aligned_allocate(small_object_size)) small_object{nullptr};
             ++m_private_counter;
+            increase_counter(m_counters.new_allocations, 1);
         }
     } else {
         obj = new (cache_aligned_allocate(number_of_bytes)) small_object{nullptr};
+        increase_counter(m_counters.new_allocations, 1);
     }
     allocator = this;
 
@@ -91,31 +97,68 @@ void small_object_pool_impl::deallocate_impl(void* ptr, std::size_t number_of_by
         if (td.my_small_object_pool == this) {
             obj->next = m_private_list;
             m_private_list = obj;
+            increase_counter(m_counters.local_deallocations, 1);
         } else {
-            auto old_public_list = m_public_list.load(std::memory_order_relaxed);
-
-            for (;;) {
-                if (old_public_list == dead_public_list) {
-                    obj->~small_object();
-                    cache_aligned_deallocate(obj);
-                    if (++m_public_counter == 0)
-                    {
-                        this->~small_object_pool_impl();
-                        cache_aligned_deallocate(this);
-                    }
-                    break;
-                }
-                obj->next = old_public_list;
-                if (m_public_list.compare_exchange_strong(old_public_list, obj)) {
-                    break;
-                }
-            }
+            // The objects are returned in batches to reduce the contention on the public list of the owner
+            td.my_small_object_pool->add_remote_object(*this, obj);
         }
     } else {
         cache_aligned_deallocate(ptr);
     }
 }
 
+void small_object_pool_impl::add_remote_object(small_object_pool_impl& pool, small_object* obj) {
+    increase_counter(m_counters.remote_deallocations, 1);
+    remote_batch& batch = m_remote_batches[std::uintptr_t(&pool) / max_nfs_size % num_remote_batches];
+    if (batch.pool != &pool) {
+        if (batch.pool) {
+            return_remote_batch(batch);
+        }
+        batch.pool = &pool;
+        batch.tail = obj;
+    }
+    obj->next = batch.head;
+    batch.head = obj;
+    if (++batch.size == remote_batch_size) {
+        return_remote_batch(batch);
+    }
+}
+
+void small_object_pool_impl::return_remote_batch(remote_batch& batch) {
+    __TBB_ASSERT(batch.pool && batch.head && batch.tail, "the batch should not be empty");
+    small_object_pool_impl* pool = batch.pool;
+    increase_counter(m_counters.remote_batches, 1);
+    // The pool cannot be destroyed before the batched objects are returned to it
+    pool->m_public_list_length.fetch_add(batch.size, std::memory_order_relaxed);
+    auto old_public_list = pool->m_public_list.load(std::memory_order_relaxed);
+
+    for (;;) {
+        if (old_public_list == dead_public_list) {
+            batch.tail->next = nullptr;
+            std::int64_t removed_count = cleanup_list(batch.head);
+            if ((pool->m_public_counter += removed_count) == 0)
+            {
+                pool->~small_object_pool_impl();
+                cache_aligned_deallocate(pool);
+            }
+            break;
+        }
+        batch.tail->next = old_public_list;
+        if (pool->m_public_list.compare_exchange_strong(old_public_list, batch.head)) {
+            break;
+        }
+    }
+    batch = remote_batch{};
+}
+
+void small_object_pool_impl::flush_remote_batches() {
+    for (remote_batch& batch : m_remote_batches) {
+        if (batch.pool) {
+            return_remote_batch(batch);
+        }
+    }
+}
+
 std::int64_t small_object_pool_impl::cleanup_list(small_object* list)
 {
     std::int64_t removed_count{};
@@ -132,6 +175,7 @@ std::int64_t small_object_pool_impl::cleanup_list(small_object* list)
 
 void small_object_pool_impl::destroy()
 {
+    flush_remote_batches();
     // clean up private list and subtract the removed count from private counter
     m_private_counter -= cleanup_list(m_private_list);
     // Grab public list and place dead mark
@@ -31,25 +31,70 @@ namespace r1 {
 
 class thread_data;
 
+//! Activity counters of the small object pool of a thread
+/** Modified by the owning thread only, read by the threads collecting the statistics. **/
+struct small_object_pool_counters {
+    //! Number of the allocations that have reused an object from the private list
+    std::atomic<std::uint64_t> local_allocations{0};
+    //! Number of the allocations that have taken the list of the objects returned by other threads
+    std::atomic<std::uint64_t> remote_allocations{0};
+    //! Number of the allocations that have requested the memory from the memory allocator
+    std::atomic<std::uint64_t> new_allocations{0};
+    //! Number of the deallocated objects that belong to the pool of the thread
+    std::atomic<std::uint64_t> local_deallocations{0};
+    //! Number of the deallocated objects that belong to the pools of other threads
+    std::atomic<std::uint64_t> remote_deallocations{0};
+    //! Number of the batches of objects returned to the pools of other threads
+    std::atomic<std::uint64_t> remote_batches{0};
+};
+
 class small_object_pool_impl : public d1::small_object_pool
 {
     static constexpr std::size_t small_object_size = 256;
+    //! Number of the pools of other threads whose objects are batched at the same time
+    static constexpr std::size_t num_remote_batches = 4;
+    //! Number of the objects after which the batch is returned to its pool
+    static constexpr std::size_t remote_batch_size = 32;
     struct small_object {
         small_object* next;
     };
+    //! The objects of another pool deallocated by the owning thread and not returned yet
+    struct remote_batch {
+        small_object_pool_impl* pool;
+        small_object* head;
+        small_object* tail;
+        std::size_t size;
+    };
     static small_object* const dead_public_list;
 public:
     void* allocate_impl(small_object_pool*& allocator, std::size_t number_of_bytes);
     void deallocate_impl(void* ptr, std::size_t number_of_bytes, thread_data& td);
+    //! Returns the batched objects to their pools
+    /** Called by the owning thread before it looks for work in other threads or goes to sleep. **/
+    void flush_remote_batches();
     void destroy();
+
+    const small_object_pool_counters& counters() const {
+        return m_counters;
+    }
+
+    //! Approximate number of the objects returned by other threads and not taken by the owner yet
+    std::uint64_t public_list_length() const {
+        return m_public_list_length.load(std::memory_order_relaxed);
+    }
 private:
+    void add_remote_object(small_object_pool_impl& pool, small_object* obj);
+    void return_remote_batch(remote_batch& batch);
     static std::int64_t cleanup_list(small_object* list);
     ~small_object_pool_impl() = default;
 private:
     alignas(max_nfs_size) small_object* m_private_list;
     std::int64_t m_private_counter{};
+    remote_batch m_remote_batches[num_remote_batches]{};
+    small_object_pool_counters m_counters;
     alignas(max_nfs_size) std::atomic<small_object*> m_public_list;
     std::atomic<std::int64_t> m_public_counter{};
+    std::atomic<std::uint64_t> m_public_list_length{};
 };
 
 } // namespace r1
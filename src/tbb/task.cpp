@@ -22,6 +22,7 @@
 #include "task_dispatcher.h"
 #include "waiters.h"
 #include "itt_notify.h"
+#include "co_stack_pool.h"
 
 #include "oneapi/tbb/detail/_task.h"
 #include "oneapi/tbb/partitioner.h"
@@ -83,7 +84,11 @@ task_dispatcher& create_coroutine(thread_data& td) {
     if (!task_disp) {
         void* ptr = cache_aligned_allocate(sizeof(task_dispatcher));
         task_disp = new(ptr) task_dispatcher(td.my_arena);
-        task_disp->init_suspend_point(td.my_arena, td.my_arena->my_threading_control->worker_stack_size());
+        std::size_t stack_size = the_coroutine_stack_size.load(std::memory_order_relaxed);
+        if (stack_size == 0) {
+            stack_size = td.my_arena->my_threading_control->worker_stack_size();
+        }
+        task_disp->init_suspend_point(td.my_arena, stack_size);
     }
     // Prolong the arena's lifetime until all coroutines is alive
     // (otherwise the arena can be destroyed while some tasks are suspended).
@@ -132,6 +137,10 @@ bool task_dispatcher::resume(task_dispatcher& target) {
         // Change the task dispatcher
         td->detach_task_dispatcher();
         td->attach_task_dispatcher(target);
+        // The tasks of this dispatcher can be resumed by another thread, so their executions end here
+        if (m_num_executing_tasks) {
+            td->my_tracer.record(trace_event_type::suspend, m_num_executing_tasks);
+        }
     }
     __TBB_ASSERT(m_suspend_point != nullptr, "Suspend point must be created");
     __TBB_ASSERT(target.m_suspend_point != nullptr, "Suspend point must be created");
@@ -143,6 +152,9 @@ bool task_dispatcher::resume(task_dispatcher& target) {
         thread_data* td = m_thread_data;
         __TBB_ASSERT(td != nullptr, "This task dispatcher must be attach to a thread data");
         __TBB_ASSERT(td->my_task_dispatcher == this, "Thread data must be attached to this task dispatcher");
+        if (m_num_executing_tasks) {
+            td->my_tracer.record(trace_event_type::resume, m_num_executing_tasks);
+        }
         do_post_resume_action();
 
         // Remove the recall flag if the thread in its original task dispatcher
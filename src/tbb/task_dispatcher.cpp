@@ -17,12 +17,15 @@
 #include "task_dispatcher.h"
 #include "waiters.h"
 
+#include "oneapi/tbb/scratch_allocator.h"
+
 namespace tbb {
 namespace detail {
 namespace r1 {
 
 static inline void spawn_and_notify(d1::task& t, arena_slot* slot, arena* a) {
     slot->spawn(t);
+    increase_counter(slot->my_counters.tasks_spawned, 1);
     a->advertise_new_work<arena::work_spawned>();
     // TODO: TBB_REVAMP_TODO slot->assert_task_pool_valid();
 }
@@ -36,6 +39,7 @@ void __TBB_EXPORTED_FUNC spawn(d1::task& t, d1::task_group_context& ctx) {
     task_accessor::context(t) = &ctx;
     // Mark isolation
     task_accessor::isolation(t) = tls->my_task_dispatcher->m_execute_data_ext.isolation;
+    tls->my_tracer.record(trace_event_type::spawn, &t);
     spawn_and_notify(t, slot, a);
 }
 
@@ -50,6 +54,7 @@ void __TBB_EXPORTED_FUNC spawn(d1::task& t, d1::task_group_context& ctx, d1::slo
     task_accessor::context(t) = &ctx;
     // Mark isolation
     task_accessor::isolation(t) = ed.isolation;
+    tls->my_tracer.record(trace_event_type::spawn, &t);
 
     if ( id != d1::no_slot && id != tls->my_arena_index && id < a->my_num_slots) {
         // Allocate proxy task
@@ -150,6 +155,20 @@ d1::task_group_context* __TBB_EXPORTED_FUNC current_context() {
     }
 }
 
+void* __TBB_EXPORTED_FUNC scratch_allocate(std::size_t size, std::size_t alignment) {
+    thread_data* td = governor::get_thread_data();
+    assert_pointers_valid(td, td->my_task_dispatcher);
+    return td->my_task_dispatcher->m_scratch_arena.allocate(size, alignment);
+}
+
+void* __TBB_EXPORTED_FUNC scratch_allocate(const d1::execution_data& ed, std::size_t size, std::size_t alignment) {
+    const execution_data_ext& ed_ext = static_cast<const execution_data_ext&>(ed);
+    assert_pointer_valid(ed_ext.task_disp);
+    __TBB_ASSERT(ed_ext.task_disp == governor::get_thread_data()->my_task_dispatcher,
+        "The execution data shall belong to the current task dispatcher");
+    return ed_ext.task_disp->m_scratch_arena.allocate(size, alignment);
+}
+
 void task_dispatcher::execute_and_wait(d1::task* t, d1::wait_context& wait_ctx, d1::task_group_context& w_ctx) {
     // Get an associated task dispatcher
     thread_data* tls = governor::get_thread_data();
@@ -167,6 +186,7 @@ void task_dispatcher::execute_and_wait(d1::task* t, d1::wait_context& wait_ctx,
     external_waiter waiter{ *tls->my_arena, wait_ctx };
     t = local_td.local_wait_for_all(t, waiter);
     __TBB_ASSERT_EX(t == nullptr, "External waiter must not leave dispatch loop with a task");
+    local_td.m_thread_data->my_small_object_pool->flush_remote_batches();
 
     // The external thread couldn't exit the dispatch loop in an idle state
     if (local_td.m_thread_data->my_inbox.is_idle_state(true)) {
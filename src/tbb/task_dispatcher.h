@@ -155,11 +155,22 @@ inline d1::task* task_dispatcher::get_stream_or_critical_task(
     return a.get_stream_task(stream, hint);
 }
 
+inline d1::task* task_dispatcher::get_deadline_or_critical_task(
+    execution_data_ext& ed, arena& a, isolation_type isolation, bool critical_allowed)
+{
+    if (a.my_deadline_task_stream.empty())
+        return nullptr;
+    d1::task* result = get_critical_task(nullptr, ed, isolation, critical_allowed);
+    if (result)
+        return result;
+    return a.my_deadline_task_stream.pop();
+}
+
 inline d1::task* task_dispatcher::steal_or_get_critical(
     execution_data_ext& ed, arena& a, unsigned arena_index, FastRandom& random,
     isolation_type isolation, bool critical_allowed)
 {
-    if (d1::task* t = a.steal_task(arena_index, random, ed, isolation)) {
+    if (d1::task* t = a.steal_task(arena_index, random, ed, isolation, m_thread_data->my_steal_counters, m_thread_data->my_tracer)) {
         ed.context = task_accessor::context(*t);
         ed.isolation = task_accessor::isolation(*t);
         return get_critical_task(t, ed, isolation, critical_allowed);
@@ -210,6 +221,10 @@ d1::task* task_dispatcher::receive_or_steal_task(
         else if ((t = get_stream_or_critical_task(ed, a, resume_stream, resume_hint, isolation, critical_allowed))) {
             // Successfully got the resume or critical task
         }
+        else if (fifo_allowed && isolation == no_isolation
+                 && (t = get_deadline_or_critical_task(ed, a, isolation, critical_allowed))) {
+            // The enqueued tasks with the earliest deadlines go ahead of the other enqueued tasks.
+        }
         else if (fifo_allowed && isolation == no_isolation
                  && (t = get_stream_or_critical_task(ed, a, fifo_stream, fifo_hint, isolation, critical_allowed))) {
             // Checked if there are tasks in starvation-resistant stream. Only allowed at the outermost dispatch level without isolation.
@@ -226,11 +241,22 @@ d1::task* task_dispatcher::receive_or_steal_task(
             ed.context = task_accessor::context(*t);
             ed.isolation = task_accessor::isolation(*t);
             a.my_observers.notify_entry_observers(tls.my_last_observer, tls.my_is_worker);
+            // The task is taken from elsewhere, so there can be more work than the threads in the arena
+            a.try_ramp_up_workers();
+            if (tls.my_worker_request_time != 0) {
+                std::uint64_t now = counters_time_stamp();
+                slot.my_counters.note_worker_wakeup(now > tls.my_worker_request_time ? now - tls.my_worker_request_time : 0);
+                tls.my_worker_request_time = 0;
+            }
             break; // Stealing success, end of stealing attempt
         }
+        // The steal attempt has failed, so the batched objects are returned to their pools before
+        // the thread pauses rather than after each stolen task.
+        tls.my_small_object_pool->flush_remote_batches();
         // Nothing to do, pause a little.
         waiter.pause(slot);
     } // end of nonlocal task retrieval loop
+    waiter.finish_search(slot);
 
     __TBB_ASSERT(is_alive(a.my_guard), nullptr);
     if (inbox.is_idle_state(true)) {
@@ -288,6 +314,16 @@ d1::task* task_dispatcher::local_wait_for_all(d1::task* t, Waiter& waiter ) {
     m_properties.outermost = false;
     m_properties.fifo_tasks_allowed = false;
 
+    // The scratch memory allocated by a task is released when its execution completes
+    struct scratch_scope_guard {
+        scratch_arena& arena;
+        char* const mark;
+
+        ~scratch_scope_guard() {
+            arena.leave_scope(mark);
+        }
+    } scratch_guard{ m_scratch_arena, m_scratch_arena.enter_scope() };
+
     if (!dl_guard.is_initially_registered) {
         m_thread_data->my_arena->my_tc_client.get_pm_client()->register_thread();
         m_thread_data->my_is_registered = true;
@@ -327,6 +363,8 @@ d1::task* task_dispatcher::local_wait_for_all(d1::task* t, Waiter& waiter ) {
                     suppress_unused_warning(itt_caller);
 
                     ITT_CALLEE_ENTER(ITTPossible, t, itt_caller);
+                    m_thread_data->my_tracer.record(trace_event_type::execute_begin, t);
+                    ++m_num_executing_tasks;
 
                     if (ed.context->is_group_execution_cancelled()) {
                         t = t->cancel(ed);
@@ -334,7 +372,12 @@ d1::task* task_dispatcher::local_wait_for_all(d1::task* t, Waiter& waiter ) {
                         t = t->execute(ed);
                     }
 
+                    // m_thread_data can be changed by t->execute(); the execution is begun again in the trace
+                    // of the thread that resumes the dispatcher, see task_dispatcher::resume
+                    --m_num_executing_tasks;
+                    m_thread_data->my_tracer.record(trace_event_type::execute_end);
                     ITT_CALLEE_LEAVE(ITTPossible, itt_caller);
+                    m_scratch_arena.release(scratch_guard.mark);
 
                     // The task affinity in execution data is set for affinitized tasks.
                     // So drop it after the task execution.
@@ -366,6 +409,10 @@ d1::task* task_dispatcher::local_wait_for_all(d1::task* t, Waiter& waiter ) {
             } while (t != nullptr); // main dispatch loop
             break; // Exit exception loop;
         } catch (...) {
+            // Only the task bodies throw, so the execution of the task ends here
+            --m_num_executing_tasks;
+            m_thread_data->my_tracer.record(trace_event_type::execute_end);
+            m_scratch_arena.release(scratch_guard.mark);
             if (global_control::active_value(global_control::terminate_on_exception) == 1) {
                 do_throw_noexcept([] { throw; });
             }
@@ -454,8 +501,11 @@ inline d1::task* task_dispatcher::get_mailbox_task(mail_inbox& my_inbox, executi
         if (d1::task* result = tp->extract_task<task_proxy::mailbox_bit>()) {
             ed.original_slot = (unsigned short)(-2);
             ed.affinity_slot = ed.task_disp->m_thread_data->my_arena_index;
+            m_thread_data->my_tracer.record(trace_event_type::mailbox_hit, result);
+            increase_counter(m_thread_data->my_arena_slot->my_counters.mailbox_tasks_executed, 1);
             return result;
         }
+        m_thread_data->my_tracer.record(trace_event_type::mailbox_miss);
         // We have exclusive access to the proxy, and can destroy it.
         tp->allocator.delete_object(tp, ed);
     }
@@ -32,7 +32,10 @@
 #include "misc.h" // for FastRandom
 
 #include <deque>
+#include <vector>
+#include <algorithm>
 #include <climits>
+#include <cstdint>
 #include <atomic>
 
 namespace tbb {
@@ -279,6 +282,147 @@ private:
 
 }; // task_stream
 
+//! The deadline of a task that has no deadline
+static constexpr std::uint64_t no_deadline = UINT64_MAX;
+
+//! The container for the enqueued tasks with deadlines.
+/** Each lane is a binary min-heap ordered by the deadlines. The earliest deadline of every lane
+    is published in the lane, so consumers choose the lane with the earliest task without locking
+    the lanes. The order is exact within a lane and approximate across the lanes, because a lane
+    can be changed after its deadline is read. **/
+class deadline_task_stream : no_copy {
+    struct heap_item {
+        std::uint64_t deadline;
+        d1::task* task;
+    };
+
+    //! Makes the heap a min-heap with respect to the deadlines
+    struct later_deadline {
+        bool operator()(const heap_item& lhs, const heap_item& rhs) const {
+            return lhs.deadline > rhs.deadline;
+        }
+    };
+
+    struct alignas(max_nfs_size) lane_t {
+        using heap_base_t = std::vector<heap_item, cache_aligned_allocator<heap_item>>;
+
+        heap_base_t my_heap{};
+        std::atomic<std::uint64_t> my_earliest_deadline{no_deadline};
+        mutex my_mutex{};
+    };
+
+    std::atomic<population_t> population{};
+    lane_t* lanes{nullptr};
+    unsigned N{};
+
+public:
+    deadline_task_stream() = default;
+
+    void initialize( unsigned n_lanes ) {
+        const unsigned max_lanes = sizeof(population_t) * CHAR_BIT;
+
+        N = n_lanes >= max_lanes ? max_lanes : n_lanes > 2 ? 1 << (tbb::detail::log2(n_lanes - 1) + 1) : 2;
+        __TBB_ASSERT( N == max_lanes || (N >= n_lanes && ((N - 1) & N) == 0), "number of lanes miscalculated" );
+        lanes = static_cast<lane_t*>(cache_aligned_allocate(sizeof(lane_t) * N));
+        for (unsigned i = 0; i < N; ++i) {
+            new (lanes + i) lane_t;
+        }
+        __TBB_ASSERT( !population.load(std::memory_order_relaxed), nullptr);
+    }
+
+    ~deadline_task_stream() {
+        if (lanes) {
+            for (unsigned i = 0; i < N; ++i) {
+                lanes[i].~lane_t();
+            }
+            cache_aligned_deallocate(lanes);
+        }
+    }
+
+    //! Push a task with the deadline into a lane chosen by the selector.
+    template<typename lane_selector_t>
+    void push( d1::task* source, std::uint64_t deadline, const lane_selector_t& next_lane ) {
+        unsigned lane = 0;
+        do {
+            lane = next_lane( /*out_of=*/N );
+            __TBB_ASSERT( lane < N, "Incorrect lane index." );
+        } while( !try_push( source, deadline, lane ) );
+    }
+
+    //! Pop the task with the earliest deadline among the heads of the lanes.
+    d1::task* pop() {
+        d1::task* popped = nullptr;
+        for (atomic_backoff b; !empty() && !popped; b.pause()) {
+            unsigned lane = earliest_lane();
+            if( lane < N )
+                popped = try_pop( lane );
+        }
+        return popped;
+    }
+
+    //! Returns the earliest deadline of the tasks in the stream or no_deadline if it is empty.
+    std::uint64_t earliest_deadline() const {
+        unsigned lane = earliest_lane();
+        return lane < N ? lanes[lane].my_earliest_deadline.load(std::memory_order_relaxed) : no_deadline;
+    }
+
+    //! Checks existence of a task.
+    bool empty() const {
+        return !population.load(std::memory_order_relaxed);
+    }
+
+private:
+    //! Returns the index of the populated lane with the earliest deadline or N if there is none.
+    unsigned earliest_lane() const {
+        population_t populated = population.load(std::memory_order_relaxed);
+        unsigned result = N;
+        std::uint64_t earliest = no_deadline;
+        for (unsigned idx = 0; populated; ++idx, populated >>= 1) {
+            if( populated & one ) {
+                std::uint64_t deadline = lanes[idx].my_earliest_deadline.load(std::memory_order_relaxed);
+                if( result == N || deadline < earliest ) {
+                    earliest = deadline;
+                    result = idx;
+                }
+            }
+        }
+        return result;
+    }
+
+    //! Returns true on successful push, otherwise - false.
+    bool try_push( d1::task* source, std::uint64_t deadline, unsigned lane_idx ) {
+        lane_t& lane = lanes[lane_idx];
+        mutex::scoped_lock lock;
+        if( lock.try_acquire( lane.my_mutex ) ) {
+            lane.my_heap.push_back( heap_item{deadline, source} );
+            std::push_heap( lane.my_heap.begin(), lane.my_heap.end(), later_deadline{} );
+            lane.my_earliest_deadline.store( lane.my_heap.front().deadline, std::memory_order_relaxed );
+            set_one_bit( population, lane_idx );
+            return true;
+        }
+        return false;
+    }
+
+    //! Returns pointer to task on successful pop, otherwise - nullptr.
+    d1::task* try_pop( unsigned lane_idx ) {
+        lane_t& lane = lanes[lane_idx];
+        mutex::scoped_lock lock;
+        if( lock.try_acquire( lane.my_mutex ) && !lane.my_heap.empty() ) {
+            std::pop_heap( lane.my_heap.begin(), lane.my_heap.end(), later_deadline{} );
+            d1::task* result = lane.my_heap.back().task;
+            lane.my_heap.pop_back();
+            if( lane.my_heap.empty() ) {
+                lane.my_earliest_deadline.store( no_deadline, std::memory_order_relaxed );
+                clear_one_bit( population, lane_idx );
+            } else {
+                lane.my_earliest_deadline.store( lane.my_heap.front().deadline, std::memory_order_relaxed );
+            }
+            return result;
+        }
+        return nullptr;
+    }
+}; // deadline_task_stream
+
 } // namespace r1
 } // namespace detail
 } // namespace tbb
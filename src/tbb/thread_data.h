@@ -29,6 +29,7 @@
 #include "misc.h" // FastRandom
 #include "small_object_pool_impl.h"
 #include "intrusive_list.h"
+#include "scheduler_tracing.h"
 
 #include <atomic>
 
@@ -110,6 +111,7 @@ public:
         , my_last_observer{ nullptr }
         , my_small_object_pool{new (cache_aligned_allocate(sizeof(small_object_pool_impl))) small_object_pool_impl{}}
         , my_context_list(new (cache_aligned_allocate(sizeof(context_list))) context_list{})
+        , my_tracer{ is_worker }
 #if __TBB_RESUMABLE_TASKS
         , my_post_resume_action{ task_dispatcher::post_resume_action::none }
         , my_post_resume_arg{nullptr}
@@ -172,6 +174,15 @@ public:
     small_object_pool_impl* my_small_object_pool;
 
     context_list* my_context_list;
+
+    //! Work stealing counters of the thread
+    steal_counters my_steal_counters;
+
+    //! Recorder of the scheduler events of the thread
+    thread_tracer my_tracer;
+
+    //! The time of the request for workers when the worker joined the arena; zero after it takes a task
+    std::uint64_t my_worker_request_time{0};
 #if __TBB_RESUMABLE_TASKS
     //! Suspends the current coroutine (task_dispatcher).
     void suspend(void* suspend_callback, void* user_callback);
@@ -232,9 +243,11 @@ inline void thread_data::detach_task_dispatcher() {
 inline void thread_data::enter_task_dispatcher(task_dispatcher& task_disp, std::uintptr_t stealing_threshold) {
     task_disp.set_stealing_threshold(stealing_threshold);
     attach_task_dispatcher(task_disp);
+    my_tracer.record(trace_event_type::arena_join, my_arena);
 }
 
 inline void thread_data::leave_task_dispatcher() {
+    my_tracer.record(trace_event_type::arena_leave);
     my_task_dispatcher->set_stealing_threshold(0);
     detach_task_dispatcher();
 }
@@ -17,10 +17,30 @@
 #include "thread_dispatcher.h"
 #include "threading_control.h"
 
+#include "oneapi/tbb/scheduler_statistics.h"
+
 namespace tbb {
 namespace detail {
 namespace r1 {
 
+//! The counters of the destroyed clients
+/** Kept for the lifetime of the process, so the global counters do not decrease when the thread dispatcher
+    is recreated. **/
+static d1::scheduler_metrics retired_metrics;
+static spin_mutex retired_metrics_mutex;
+
+static void add_counters(d1::scheduler_metrics& dst, const d1::scheduler_metrics& src) {
+    dst.tasks_spawned += src.tasks_spawned;
+    dst.tasks_stolen += src.tasks_stolen;
+    dst.mailbox_tasks_executed += src.mailbox_tasks_executed;
+    dst.worker_spin_time += src.worker_spin_time;
+    dst.monitor_wakeups += src.monitor_wakeups;
+    dst.worker_wakeups += src.worker_wakeups;
+    dst.empty_worker_wakeups += src.empty_worker_wakeups;
+    dst.worker_wakeup_latency += src.worker_wakeup_latency;
+    dst.max_worker_wakeup_latency = max(dst.max_worker_wakeup_latency, src.max_worker_wakeup_latency);
+}
+
 thread_dispatcher::thread_dispatcher(threading_control& tc, unsigned hard_limit, std::size_t stack_size)
     : my_threading_control(tc)
     , my_num_workers_hard_limit(hard_limit)
@@ -74,6 +94,7 @@ bool thread_dispatcher::try_unregister_client(thread_dispatcher_client* client,
                 // a race over workers_requested
                 if (!client->references() && !client->has_request()) {
                     // Client is abandoned. Destroy it.
+                    retire_client_metrics(*client);
                     remove_client(*client);
                     ++my_clients_aba_epoch;
 
@@ -115,6 +136,33 @@ void thread_dispatcher::remove_client(thread_dispatcher_client& client) {
     my_next_client = select_next_client(my_next_client);
 }
 
+// Should be called under lock
+void thread_dispatcher::retire_client_metrics(thread_dispatcher_client& client) {
+    d1::scheduler_metrics metrics{};
+    client.collect_metrics(metrics);
+    spin_mutex::scoped_lock lock(retired_metrics_mutex);
+    add_counters(retired_metrics, metrics);
+}
+
+void thread_dispatcher::collect_retired_metrics(d1::scheduler_metrics& metrics) {
+    spin_mutex::scoped_lock lock(retired_metrics_mutex);
+    add_counters(metrics, retired_metrics);
+}
+
+void thread_dispatcher::collect_metrics(d1::scheduler_metrics& metrics) {
+    // The clients are retired under the write lock, so none is counted twice or missed
+    client_list_mutex_type::scoped_lock lock(my_list_mutex, /*is_writer=*/false);
+    collect_retired_metrics(metrics);
+    for (auto& list : my_client_list) {
+        for (auto& client : list) {
+            client.collect_metrics(metrics);
+        }
+    }
+    unsigned num_workers = my_first_unused_worker_idx.load(std::memory_order_relaxed);
+    unsigned num_awake_workers = my_num_awake_workers.load(std::memory_order_relaxed);
+    metrics.sleeping_workers += num_workers > num_awake_workers ? num_workers - num_awake_workers : 0;
+}
+
 bool thread_dispatcher::is_client_alive(thread_dispatcher_client* client) {
     if (!client) {
         return false;
@@ -138,6 +186,22 @@ thread_dispatcher_client* thread_dispatcher::client_in_need(client_list_type* cl
         return nullptr;
     }
 
+    // The client with the earliest deadline of the enqueued tasks goes first
+    thread_dispatcher_client* earliest = nullptr;
+    std::uint64_t earliest_deadline = no_deadline;
+    for (unsigned level = 0; level < num_priority_levels; ++level) {
+        for (auto& client : clients[level]) {
+            std::uint64_t deadline = client.earliest_deadline();
+            if (deadline < earliest_deadline && client.is_joinable()) {
+                earliest_deadline = deadline;
+                earliest = &client;
+            }
+        }
+    }
+    if (earliest && earliest->try_join()) {
+        return earliest;
+    }
+
     client_list_type::iterator it = hint;
     unsigned curr_priority_level = hint->priority_level();
     __TBB_ASSERT(it != clients[curr_priority_level].end(), nullptr);
@@ -187,6 +251,9 @@ void thread_dispatcher::release(bool blocking_terminate) {
 
 void thread_dispatcher::process(job& j) {
     thread_data& td = static_cast<thread_data&>(j);
+    // The worker comes here after being woken up or after leaving the previous client
+    td.my_tracer.record(trace_event_type::wake);
+    ++my_num_awake_workers;
     // td.my_last_client can be dead. Don't access it until client_in_need is called
     thread_dispatcher_client* client = td.my_last_client;
     for (int i = 0; i < 2; ++i) {
@@ -202,6 +269,9 @@ void thread_dispatcher::process(job& j) {
             yield();
         }
     }
+    // The worker is returned to RML that puts it to sleep unless there is a demand for workers
+    --my_num_awake_workers;
+    td.my_tracer.record(trace_event_type::sleep);
 }
 
 
@@ -46,6 +46,11 @@ public:
     bool try_unregister_client(thread_dispatcher_client* client, std::uint64_t aba_epoch, unsigned priority);
     bool is_any_client_in_need();
 
+    //! Adds the counters of the alive and the destroyed clients and the state of the workers to the metrics
+    void collect_metrics(d1::scheduler_metrics& metrics);
+    //! Adds the counters of the destroyed clients
+    static void collect_retired_metrics(d1::scheduler_metrics& metrics);
+
     void adjust_job_count_estimate(int delta);
     void release(bool blocking_terminate);
     void process(job& j) override;
@@ -66,6 +71,7 @@ private:
     void destroy_client(thread_dispatcher_client* client);
     void insert_client(thread_dispatcher_client& client);
     void remove_client(thread_dispatcher_client& client);
+    void retire_client_metrics(thread_dispatcher_client& client);
     bool is_client_alive(thread_dispatcher_client* client);
     thread_dispatcher_client* client_in_need(client_list_type* clients, thread_dispatcher_client* hint);
     thread_dispatcher_client* client_in_need(thread_dispatcher_client* prev);
@@ -96,6 +102,10 @@ private:
     /** Used to assign indices to the new workers coming from RML **/
     std::atomic<unsigned> my_first_unused_worker_idx{0};
 
+    //! Number of the workers that are looking for a client or work for one
+    /** The other workers have been returned to RML, which keeps them asleep while there is no demand. **/
+    std::atomic<unsigned> my_num_awake_workers{0};
+
     //! Pointer to the RML server object that services this TBB instance.
     rml::tbb_server* my_server{nullptr};
 };
@@ -57,6 +57,14 @@ public:
         return my_arena.has_request();
     }
 
+    std::uint64_t earliest_deadline() {
+        return my_arena.my_deadline_task_stream.earliest_deadline();
+    }
+
+    void collect_metrics(d1::scheduler_metrics& metrics) {
+        my_arena.collect_metrics(metrics);
+    }
+
 private:
     arena& my_arena;
     std::uint64_t my_aba_epoch;
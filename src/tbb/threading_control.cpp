@@ -112,6 +112,10 @@ void threading_control_impl::set_active_num_workers(unsigned soft_limit) {
     my_permit_manager->set_active_num_workers(soft_limit);
 }
 
+void threading_control_impl::collect_metrics(d1::scheduler_metrics& metrics) {
+    my_thread_dispatcher->collect_metrics(metrics);
+}
+
 threading_control_client threading_control_impl::create_client(arena& a) {
     pm_client* pm_client = my_permit_manager->create_client(a);
     thread_dispatcher_client* td_client = my_thread_dispatcher->create_client(a);
@@ -346,6 +350,15 @@ void threading_control::set_active_num_workers(unsigned soft_limit) {
     }
 }
 
+void threading_control::collect_metrics(d1::scheduler_metrics& metrics) {
+    global_mutex_type::scoped_lock lock(g_threading_control_mutex);
+    if (g_threading_control) {
+        g_threading_control->my_pimpl->collect_metrics(metrics);
+    } else {
+        thread_dispatcher::collect_retired_metrics(metrics);
+    }
+}
+
 bool threading_control::is_present() {
     global_mutex_type::scoped_lock lock(g_threading_control_mutex);
     return g_threading_control != nullptr;
@@ -64,9 +64,15 @@ public:
     void propagate_task_group_state(std::atomic<uint32_t> d1::task_group_context::*mptr_state,
                                     d1::task_group_context& src, uint32_t new_state);
 
+    template <typename Function>
+    void for_each_thread(Function&& f) {
+        my_cancellation_disseminator->for_each_thread(std::forward<Function>(f));
+    }
+
     void set_active_num_workers(unsigned soft_limit);
     std::size_t worker_stack_size();
     unsigned max_num_workers();
+    void collect_metrics(d1::scheduler_metrics& metrics);
 
     void adjust_demand(threading_control_client, int mandatory_delta, int workers_delta);
     bool is_any_other_client_active();
@@ -116,6 +122,18 @@ public:
     std::size_t worker_stack_size();
     static unsigned max_num_workers();
 
+    //! Calls the function for every thread registered in the library, if the library is initialized
+    template <typename Function>
+    static void for_each_thread(Function&& f) {
+        global_mutex_type::scoped_lock lock(g_threading_control_mutex);
+        if (g_threading_control) {
+            g_threading_control->my_pimpl->for_each_thread(std::forward<Function>(f));
+        }
+    }
+
+    //! Adds the counters of all arenas ever created
+    static void collect_metrics(d1::scheduler_metrics& metrics);
+
     void adjust_demand(threading_control_client client, int mandatory_delta, int workers_delta);
     bool is_any_other_client_active();
 
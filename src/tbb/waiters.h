@@ -45,6 +45,9 @@ public:
         my_backoff.reset_wait();
     }
 
+    //! Called when the search for a task ends, either with a task or without one
+    void finish_search(arena_slot&) {}
+
 protected:
     arena& my_arena;
     stealing_loop_backoff my_backoff;
@@ -54,20 +57,32 @@ class outermost_worker_waiter : public waiter_base {
 public:
     using waiter_base::waiter_base;
 
-    bool continue_execution(arena_slot& slot, d1::task*& t) const {
+    bool continue_execution(arena_slot& slot, d1::task*& t) {
         __TBB_ASSERT(t == nullptr, nullptr);
 
+        if (is_slot_deactivated(slot)) {
+            // The arena has been shrunk, see arena::set_concurrency. The tasks left in the pool of
+            // the slot are taken by the other threads.
+            if (slot.task_pool.load(std::memory_order_relaxed) != EmptyTaskPool) {
+                my_arena.advertise_new_work<arena::wakeup>();
+            }
+            return false;
+        }
+
         if (is_worker_should_leave(slot)) {
             if (!governor::hybrid_cpu()) {
-                static constexpr std::chrono::microseconds worker_wait_leave_duration(1000);
-                static_assert(worker_wait_leave_duration > std::chrono::steady_clock::duration(1), "Clock resolution is not enough for measured interval.");
+                static_assert(std::chrono::microseconds(1) > std::chrono::steady_clock::duration(1), "Clock resolution is not enough for measured interval.");
+                const std::chrono::microseconds worker_wait_leave_duration = current_wait_policy().worker_leave_duration;
 
-                for (auto t1 = std::chrono::steady_clock::now(), t2 = t1;
-                    std::chrono::duration_cast<std::chrono::microseconds>(t2 - t1) < worker_wait_leave_duration;
+                bool is_work_found = false;
+                auto t1 = std::chrono::steady_clock::now(), t2 = t1;
+                start_spinning(t1);
+                for (; std::chrono::duration_cast<std::chrono::microseconds>(t2 - t1) < worker_wait_leave_duration;
                     t2 = std::chrono::steady_clock::now())
                 {
                     if (!my_arena.is_empty() && !my_arena.is_recall_requested()) {
-                        return true;
+                        is_work_found = true;
+                        break;
                     }
 
                     if (my_arena.my_threading_control->is_any_other_client_active()) {
@@ -75,6 +90,9 @@ public:
                     }
                     d0::yield();
                 }
+                if (is_work_found) {
+                    return true;
+                }
             }
             // Leave dispatch loop
             return false;
@@ -85,9 +103,18 @@ public:
     }
 
     void pause(arena_slot&) {
+        if (!my_is_spinning) {
+            start_spinning(std::chrono::steady_clock::now());
+        }
         waiter_base::pause();
     }
 
+    void finish_search(arena_slot& slot) {
+        if (my_is_spinning) {
+            add_spin_time(slot, std::chrono::steady_clock::now() - my_spin_start);
+            my_is_spinning = false;
+        }
+    }
 
     d1::wait_context* wait_ctx() {
         return nullptr;
@@ -100,6 +127,28 @@ public:
 private:
     using base_type = waiter_base;
 
+    //! The time of the first pause of the current search for a task
+    /** The spin time is measured from the first pause to the end of the search, so the clock is not
+        read on every pause. **/
+    std::chrono::steady_clock::time_point my_spin_start{};
+    bool my_is_spinning{false};
+
+    void start_spinning(std::chrono::steady_clock::time_point start) {
+        if (!my_is_spinning) {
+            my_spin_start = start;
+            my_is_spinning = true;
+        }
+    }
+
+    static void add_spin_time(arena_slot& slot, std::chrono::steady_clock::duration d) {
+        increase_counter(slot.my_counters.worker_spin_time,
+            std::uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(d).count()));
+    }
+
+    bool is_slot_deactivated(arena_slot& slot) const {
+        return std::size_t(&slot - my_arena.my_slots) >= my_arena.my_num_active_slots.load(std::memory_order_relaxed);
+    }
+
     bool is_worker_should_leave(arena_slot& slot) const {
         bool is_top_priority_arena = my_arena.is_top_priority();
         bool is_task_pool_empty = slot.task_pool.load(std::memory_order_relaxed) == EmptyTaskPool;
@@ -129,9 +178,19 @@ protected:
     using waiter_base::waiter_base;
 
     template <typename Pred>
-    void sleep(std::uintptr_t uniq_tag, Pred wakeup_condition) {
-        my_arena.get_waiting_threads_monitor().wait<thread_control_monitor::thread_context>(wakeup_condition,
-            market_context{uniq_tag, &my_arena});
+    void sleep(arena_slot& slot, std::uintptr_t uniq_tag, Pred wakeup_condition) {
+        if (is_scheduler_tracing_enabled()) {
+            trace_current_thread(trace_event_type::sleep, 0);
+        }
+        governor::get_thread_data()->my_small_object_pool->flush_remote_batches();
+        if (my_arena.get_waiting_threads_monitor().wait<thread_control_monitor::thread_context>(wakeup_condition,
+            market_context{uniq_tag, &my_arena}))
+        {
+            increase_counter(slot.my_counters.monitor_wakeups, 1);
+        }
+        if (is_scheduler_tracing_enabled()) {
+            trace_current_thread(trace_event_type::wake, 0);
+        }
         reset_wait();
     }
 };
@@ -150,14 +209,14 @@ public:
         return true;
     }
 
-    void pause(arena_slot&) {
+    void pause(arena_slot& slot) {
         if (!sleep_waiter::pause()) {
             return;
         }
 
         auto wakeup_condition = [&] { return !my_arena.is_empty() || !my_wait_ctx.continue_execution(); };
 
-        sleep(std::uintptr_t(&my_wait_ctx), wakeup_condition);
+        sleep(slot, std::uintptr_t(&my_wait_ctx), wakeup_condition);
     }
 
     d1::wait_context* wait_ctx() {
@@ -193,7 +252,7 @@ public:
 
         auto wakeup_condition = [&] { return !my_arena.is_empty() || sp->m_is_owner_recalled.load(std::memory_order_relaxed); };
 
-        sleep(std::uintptr_t(sp), wakeup_condition);
+        sleep(slot, std::uintptr_t(sp), wakeup_condition);
     }
 
     d1::wait_context* wait_ctx() {
@@ -73,6 +73,11 @@ class system_topology {
     std::vector<hwloc_cpuset_t> core_types_affinity_masks_list{};
     std::vector<int> core_types_indexes_list{};
 
+    // Cache domains related topology members, indexed by the OS indexes of the processors
+    std::vector<int> l2_domains_list{};
+    std::vector<int> llc_domains_list{};
+    std::vector<int> numa_domains_list{};
+
     enum init_stages { uninitialized,
                        started,
                        topology_allocated,
@@ -237,6 +242,67 @@ private:
         }
     }
 
+    // Returns the closest ancestor of the object that is a data or unified cache of the given level
+    hwloc_obj_t cache_ancestor(hwloc_obj_t obj, unsigned level) {
+        for (obj = obj->parent; obj != nullptr; obj = obj->parent) {
+#if HWLOC_API_VERSION >= 0x20000
+            bool is_cache = hwloc_obj_type_is_cache(obj->type);
+#else
+            bool is_cache = obj->type == HWLOC_OBJ_CACHE;
+#endif
+            if (is_cache && obj->attr->cache.depth == level && obj->attr->cache.type != HWLOC_OBJ_CACHE_INSTRUCTION) {
+                return obj;
+            }
+        }
+        return nullptr;
+    }
+
+    void cache_domains_topology_parsing() {
+        // Leave the lists empty if topology parsing is broken, so the domains of all processors are unknown.
+        if ( initialization_state != topology_loaded ) {
+            return;
+        }
+        int last_processor = hwloc_bitmap_last(process_cpu_affinity_mask);
+        if (last_processor < 0) {
+            return;
+        }
+        l2_domains_list.assign(last_processor + 1, -1);
+        llc_domains_list.assign(last_processor + 1, -1);
+        numa_domains_list.assign(last_processor + 1, -1);
+
+        hwloc_obj_t processor = nullptr;
+        while ((processor = hwloc_get_next_obj_by_type(topology, HWLOC_OBJ_PU, processor)) != nullptr) {
+            if (processor->os_index > unsigned(last_processor)) {
+                continue;
+            }
+            // The processors of a core share its L2 cache even if the cache is not reported.
+            hwloc_obj_t l2_domain = cache_ancestor(processor, 2);
+            if (l2_domain == nullptr) {
+                l2_domain = hwloc_get_ancestor_obj_by_type(topology, HWLOC_OBJ_CORE, processor);
+            }
+            // Without the L3 cache the package is the closest approximation of the last level cache domain.
+            hwloc_obj_t llc_domain = cache_ancestor(processor, 3);
+            if (llc_domain == nullptr) {
+                llc_domain = hwloc_get_ancestor_obj_by_type(topology, HWLOC_OBJ_PACKAGE, processor);
+            }
+            l2_domains_list[processor->os_index] = l2_domain ? int(l2_domain->logical_index) : -1;
+            llc_domains_list[processor->os_index] = llc_domain ? int(llc_domain->logical_index) : -1;
+        }
+
+        // The masks of the NUMA nodes are already limited by the process affinity mask
+        for (int numa_index : numa_indexes_list) {
+            if (numa_index < 0) {
+                continue;
+            }
+            int i = 0;
+            hwloc_bitmap_foreach_begin(i, numa_affinity_masks_list[numa_index]) {
+                if (i <= last_processor) {
+                    numa_domains_list[i] = numa_index;
+                }
+            } hwloc_bitmap_foreach_end();
+        }
+    }
+
 #if __TBBBIND_HWLOC_WINDOWS_API_AVAILABLE
     void processor_groups_topology_parsing() {
         __TBB_ASSERT(number_of_processors_groups > 1, nullptr);
@@ -278,6 +344,7 @@ private:
         topology_initialization(groups_num);
         numa_topology_parsing();
         core_types_topology_parsing();
+        cache_domains_topology_parsing();
 #if __TBBBIND_HWLOC_WINDOWS_API_AVAILABLE
         if (intergroup_binding_allowed(groups_num)) {
            processor_groups_topology_parsing();
@@ -351,6 +418,15 @@ public:
         _core_types_indexes_list = core_types_indexes_list.data();
     }
 
+    void fill_cache_domains_information(int& _processors_count, int*& _l2_domains_list, int*& _llc_domains_list,
+                                        int*& _numa_domains_list) {
+        __TBB_ASSERT(is_topology_parsed(), "Trying to get access to uninitialized system_topology");
+        _processors_count = (int)l2_domains_list.size();
+        _l2_domains_list = l2_domains_list.data();
+        _llc_domains_list = llc_domains_list.data();
+        _numa_domains_list = numa_domains_list.data();
+    }
+
     void fill_constraints_affinity_mask(affinity_mask input_mask, int numa_node_index, int core_type_index, int max_threads_per_core) {
         __TBB_ASSERT(is_topology_parsed(), "Trying to get access to uninitialized system_topology");
         __TBB_ASSERT(numa_node_index < (int)numa_affinity_masks_list.size(), "Wrong NUMA node id");
@@ -591,6 +667,12 @@ TBBBIND_EXPORT int __TBB_internal_get_default_concurrency(int numa_id, int core_
     return system_topology::instance().get_default_concurrency(numa_id, core_type_id, max_threads_per_core);
 }
 
+TBBBIND_EXPORT void __TBB_internal_get_cache_domains(int& processors_count, int*& l2_domains_list, int*& llc_domains_list,
+                                                    int*& numa_domains_list) {
+    system_topology::instance().fill_cache_domains_information(processors_count, l2_domains_list, llc_domains_list,
+                                                               numa_domains_list);
+}
+
 TBBBIND_EXPORT void __TBB_internal_destroy_system_topology() {
     return system_topology::destroy();
 }
@@ -39,6 +39,63 @@
 #ifndef TBB_PREVIEW_ISOLATED_TASK_GROUP
 #define TBB_PREVIEW_ISOLATED_TASK_GROUP 1
 #endif
+#ifndef TBB_PREVIEW_PARALLEL_SORT_STRATEGIES
+#define TBB_PREVIEW_PARALLEL_SORT_STRATEGIES 1
+#endif
+#ifndef TBB_PREVIEW_PARALLEL_STABLE_SORT
+#define TBB_PREVIEW_PARALLEL_STABLE_SORT 1
+#endif
+#ifndef TBB_PREVIEW_PARALLEL_PARTIAL_SORT
+#define TBB_PREVIEW_PARALLEL_PARTIAL_SORT 1
+#endif
+#ifndef TBB_PREVIEW_PARALLEL_PREFIX_SCAN
+#define TBB_PREVIEW_PARALLEL_PREFIX_SCAN 1
+#endif
+#ifndef TBB_PREVIEW_PARALLEL_TRANSFORM_REDUCE
+#define TBB_PREVIEW_PARALLEL_TRANSFORM_REDUCE 1
+#endif
+#ifndef TBB_PREVIEW_LEARNING_PARTITIONER
+#define TBB_PREVIEW_LEARNING_PARTITIONER 1
+#endif
+#ifndef TBB_PREVIEW_WEIGHTED_BLOCKED_RANGE
+#define TBB_PREVIEW_WEIGHTED_BLOCKED_RANGE 1
+#endif
+#ifndef TBB_PREVIEW_BLOCKED_RANGE_TRAVERSAL
+#define TBB_PREVIEW_BLOCKED_RANGE_TRAVERSAL 1
+#endif
+#ifndef TBB_PREVIEW_PARALLEL_FOR_CHAIN
+#define TBB_PREVIEW_PARALLEL_FOR_CHAIN 1
+#endif
+#ifndef TBB_PREVIEW_PARALLEL_WAVEFRONT
+#define TBB_PREVIEW_PARALLEL_WAVEFRONT 1
+#endif
+#ifndef TBB_PREVIEW_SCHEDULER_STATISTICS
+#define TBB_PREVIEW_SCHEDULER_STATISTICS 1
+#endif
+#ifndef TBB_PREVIEW_SCHEDULER_TRACING
+#define TBB_PREVIEW_SCHEDULER_TRACING 1
+#endif
+#ifndef TBB_PREVIEW_WORKER_WAIT_POLICY
+#define TBB_PREVIEW_WORKER_WAIT_POLICY 1
+#endif
+#ifndef TBB_PREVIEW_TASK_ARENA_RESIZING
+#define TBB_PREVIEW_TASK_ARENA_RESIZING 1
+#endif
+#ifndef TBB_PREVIEW_TASK_ARENA_WEIGHTS
+#define TBB_PREVIEW_TASK_ARENA_WEIGHTS 1
+#endif
+#ifndef TBB_PREVIEW_TASK_DEADLINES
+#define TBB_PREVIEW_TASK_DEADLINES 1
+#endif
+#ifndef TBB_PREVIEW_COROUTINES
+#define TBB_PREVIEW_COROUTINES 1
+#endif
+#ifndef TBB_PREVIEW_TASK_DEPENDENCIES
+#define TBB_PREVIEW_TASK_DEPENDENCIES 1
+#endif
+#ifndef TBB_PREVIEW_SCRATCH_ALLOCATOR
+#define TBB_PREVIEW_SCRATCH_ALLOCATOR 1
+#endif
 #endif
 
 #include "oneapi/tbb/detail/_config.h"
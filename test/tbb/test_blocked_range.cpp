@@ -14,6 +14,9 @@
     limitations under the License.
 */
 
+#define TBB_PREVIEW_WEIGHTED_BLOCKED_RANGE 1
+#define TBB_PREVIEW_BLOCKED_RANGE_TRAVERSAL 1
+
 #include "common/test.h"
 #include "common/utils.h"
 #include "common/utils_report.h"
@@ -25,11 +28,19 @@
 #include "tbb/blocked_range2d.h"
 #include "tbb/blocked_range3d.h"
 #include "tbb/blocked_nd_range.h"
+#include "tbb/weighted_blocked_range.h"
+#include "tbb/blocked_range_traversal.h"
+#include "tbb/parallel_for.h"
+#include "tbb/parallel_reduce.h"
 
 //! \file test_blocked_range.cpp
 //! \brief Test for [algorithms.blocked_range algorithms.blocked_range2d algorithms.blocked_range3d algorithms.blocked_nd_range] specification
 
 #include <utility> //for std::pair
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <type_traits>
 #include <functional>
 #include <vector>
 
@@ -84,6 +95,279 @@ TEST_CASE("Proportional split overflow") {
     }
 }
 
+//! Row pointers of a matrix in the CSR format where the number of nonzeros grows quadratically with the row index
+static std::vector<std::size_t> skewed_row_pointers(std::size_t rows) {
+    std::vector<std::size_t> row_ptr(rows + 1, 0);
+    for (std::size_t i = 0; i < rows; ++i) {
+        row_ptr[i + 1] = row_ptr[i] + (i * i) % 100003 + (i % 7 == 0 ? 0 : 1);
+    }
+    return row_ptr;
+}
+
+//! Checks that the weights of the parts follow the proportion up to the weight of one index
+static void check_weighted_split(const std::vector<std::size_t>& row_ptr, std::size_t begin, std::size_t end,
+                                 std::size_t left, std::size_t right) {
+    using range_type = tbb::weighted_blocked_range<std::size_t, const std::size_t*>;
+    range_type r1(begin, end, row_ptr.data());
+    const std::size_t total = r1.weight();
+    tbb::proportional_split proportion(left, right);
+    range_type r2(r1, proportion);
+
+    REQUIRE((r1.begin() == begin && r1.end() == r2.begin() && r2.end() == end));
+    REQUIRE((!r1.empty() && !r2.empty()));
+    REQUIRE(r1.weight() + r2.weight() == total);
+
+    const double expected = double(total) * left / (left + right);
+    const std::size_t boundary_weight = row_ptr[r2.begin()] - row_ptr[r2.begin() - 1];
+    const std::size_t next_weight = r2.size() > 1 ? row_ptr[r2.begin() + 1] - row_ptr[r2.begin()] : 0;
+    const bool is_light_enough = double(r1.weight()) <= expected + boundary_weight;
+    const bool is_heavy_enough = double(r1.weight()) + next_weight >= expected || r2.size() == 1;
+    CHECK_MESSAGE(is_light_enough, "The left part is too heavy");
+    CHECK_MESSAGE(is_heavy_enough, "The left part is too light");
+}
+
+//! Testing that weighted_blocked_range splits by the weight of the iterations
+//! \brief \ref requirement
+TEST_CASE("weighted_blocked_range split") {
+    std::vector<std::size_t> row_ptr = skewed_row_pointers(10000);
+    for (std::size_t begin : {std::size_t(0), std::size_t(1), std::size_t(5000), std::size_t(9990)}) {
+        check_weighted_split(row_ptr, begin, 10000, 1, 1);
+        check_weighted_split(row_ptr, begin, 10000, 1, 3);
+        check_weighted_split(row_ptr, begin, 10000, 7, 1);
+    }
+    check_weighted_split(row_ptr, 100, 102, 1, 1);
+
+    using range_type = tbb::weighted_blocked_range<std::size_t, const std::size_t*>;
+    range_type r(0, row_ptr.size() - 1, row_ptr.data(), 1000);
+    REQUIRE(r.weight() == row_ptr.back());
+    REQUIRE(r.grainsize() == 1000);
+    REQUIRE(r.is_divisible());
+
+    // A single index and a range lighter than the grain size are not divisible
+    REQUIRE_FALSE(range_type(42, 43, row_ptr.data()).is_divisible());
+    REQUIRE_FALSE(range_type(0, 3, row_ptr.data(), 1000).is_divisible());
+    REQUIRE(range_type(5, 5, row_ptr.data()).empty());
+
+    // The heavy half of the rows gets the smaller half of the indices
+    range_type r2(r, tbb::split());
+    REQUIRE(r.size() > r2.size());
+    REQUIRE(r.end() == r2.begin());
+}
+
+//! Testing weighted_blocked_range with parallel algorithms
+//! \brief \ref requirement
+TEST_CASE("weighted_blocked_range with parallel_for and parallel_reduce") {
+    using range_type = tbb::weighted_blocked_range<std::size_t, const std::size_t*>;
+    const std::size_t rows = 20000;
+    std::vector<std::size_t> row_ptr = skewed_row_pointers(rows);
+    const std::size_t grainsize = row_ptr.back() / 1000;
+
+    std::vector<std::atomic<int>> visits(rows);
+    for (auto& v : visits) {
+        v = 0;
+    }
+    std::atomic<std::size_t> max_chunk_weight{0};
+    tbb::parallel_for(range_type(0, rows, row_ptr.data(), grainsize), [&](const range_type& r) {
+        for (std::size_t i = r.begin(); i != r.end(); ++i) {
+            ++visits[i];
+        }
+        if (r.size() > 1) {
+            std::size_t current = max_chunk_weight;
+            while (current < r.weight() && !max_chunk_weight.compare_exchange_weak(current, r.weight())) {}
+        }
+    }, tbb::simple_partitioner());
+    bool visited_once = true;
+    for (auto& v : visits) {
+        visited_once = visited_once && v == 1;
+    }
+    REQUIRE_MESSAGE(visited_once, "Each index must be processed exactly once");
+    REQUIRE_MESSAGE(max_chunk_weight <= grainsize, "Divisible chunks must not be heavier than the grain size");
+
+    for (auto& v : visits) {
+        v = 0;
+    }
+    tbb::parallel_for(range_type(0, rows, row_ptr.data()), [&](const range_type& r) {
+        for (std::size_t i = r.begin(); i != r.end(); ++i) {
+            ++visits[i];
+        }
+    });
+    visited_once = true;
+    for (auto& v : visits) {
+        visited_once = visited_once && v == 1;
+    }
+    REQUIRE_MESSAGE(visited_once, "Each index must be processed exactly once");
+
+    std::size_t nonzeros = tbb::parallel_reduce(range_type(0, rows, row_ptr.data(), grainsize), std::size_t(0),
+        [&](const range_type& r, std::size_t sum) {
+            for (std::size_t i = r.begin(); i != r.end(); ++i) {
+                sum += row_ptr[i + 1] - row_ptr[i];
+            }
+            return sum;
+        }, std::plus<std::size_t>(), tbb::static_partitioner());
+    REQUIRE(nonzeros == row_ptr.back());
+}
+
+//! Testing that for_each_tile visits every tile of the range once in the requested order
+//! \brief \ref requirement
+TEST_CASE("for_each_tile") {
+    using range2d_type = tbb::blocked_range2d<int>;
+    for (auto order : {tbb::traversal_order::row_major, tbb::traversal_order::morton, tbb::traversal_order::hilbert}) {
+        // 2D range of 7 x 13 tiles of 4 x 3 elements starting at (2, 5); the last tiles are incomplete
+        const int rows = 27, cols = 38;
+        std::vector<int> visits(rows * cols, 0);
+        std::vector<std::pair<int, int>> tiles;
+        tbb::for_each_tile(range2d_type(2, 2 + rows, 4, 5, 5 + cols, 3), order, [&](const range2d_type& tile) {
+            REQUIRE((tile.rows().size() <= 4 && tile.cols().size() <= 3));
+            REQUIRE(((tile.rows().begin() - 2) % 4 == 0 && (tile.cols().begin() - 5) % 3 == 0));
+            for (int i = tile.rows().begin(); i != tile.rows().end(); ++i) {
+                for (int j = tile.cols().begin(); j != tile.cols().end(); ++j) {
+                    ++visits[(i - 2) * cols + (j - 5)];
+                }
+            }
+            tiles.emplace_back((tile.rows().begin() - 2) / 4, (tile.cols().begin() - 5) / 3);
+        });
+        REQUIRE(tiles.size() == 7 * 13);
+        REQUIRE_MESSAGE(std::count(visits.begin(), visits.end(), 1) == rows * cols, "Each element must be visited once");
+        if (order == tbb::traversal_order::row_major) {
+            REQUIRE(std::is_sorted(tiles.begin(), tiles.end()));
+        }
+    }
+
+    // Z-order of a 4 x 4 grid of tiles
+    std::vector<int> morton;
+    tbb::for_each_tile(range2d_type(0, 4, 1, 0, 4, 1), tbb::traversal_order::morton, [&](const range2d_type& tile) {
+        morton.push_back(tile.rows().begin() * 4 + tile.cols().begin());
+    });
+    REQUIRE(morton == std::vector<int>{0, 1, 4, 5, 2, 3, 6, 7, 8, 9, 12, 13, 10, 11, 14, 15});
+
+    // Consecutive tiles of the Hilbert curve are neighbors
+    int previous_row = -1, previous_col = -1;
+    int tile_count = 0;
+    bool is_continuous = true;
+    tbb::for_each_tile(range2d_type(0, 64, 4, 0, 64, 4), tbb::traversal_order::hilbert, [&](const range2d_type& tile) {
+        const int row = tile.rows().begin() / 4, col = tile.cols().begin() / 4;
+        if (tile_count++ > 0) {
+            is_continuous = is_continuous && std::abs(row - previous_row) + std::abs(col - previous_col) == 1;
+        }
+        previous_row = row;
+        previous_col = col;
+    });
+    REQUIRE(tile_count == 256);
+    REQUIRE_MESSAGE(is_continuous, "Consecutive tiles of the Hilbert curve must share a side");
+
+    tbb::for_each_tile(range2d_type(0, 0, 0, 10), tbb::traversal_order::hilbert, [](const range2d_type&) {
+        REQUIRE_MESSAGE(false, "Empty range must not have tiles");
+    });
+}
+
+//! Testing for_each_tile with 3D and N-dimensional ranges
+//! \brief \ref requirement
+TEST_CASE("for_each_tile in more than two dimensions") {
+    using range3d_type = tbb::blocked_range3d<int>;
+    using range4d_type = tbb::blocked_nd_range<int, 4>;
+    for (auto order : {tbb::traversal_order::row_major, tbb::traversal_order::morton, tbb::traversal_order::hilbert}) {
+        std::vector<int> visits(9 * 10 * 11, 0);
+        tbb::for_each_tile(range3d_type(0, 9, 2, 0, 10, 3, 0, 11, 4), order, [&](const range3d_type& tile) {
+            for (int p = tile.pages().begin(); p != tile.pages().end(); ++p) {
+                for (int r = tile.rows().begin(); r != tile.rows().end(); ++r) {
+                    for (int c = tile.cols().begin(); c != tile.cols().end(); ++c) {
+                        ++visits[(p * 10 + r) * 11 + c];
+                    }
+                }
+            }
+        });
+        REQUIRE(std::count(visits.begin(), visits.end(), 1) == int(visits.size()));
+
+        std::vector<int> nd_visits(5 * 6 * 7 * 3, 0);
+        int tiles = 0;
+        tbb::for_each_tile(range4d_type({0, 5, 2}, {0, 6, 2}, {0, 7, 2}, {0, 3, 2}), order, [&](const range4d_type& tile) {
+            ++tiles;
+            for (int a = tile.dim(0).begin(); a != tile.dim(0).end(); ++a) {
+                for (int b = tile.dim(1).begin(); b != tile.dim(1).end(); ++b) {
+                    for (int c = tile.dim(2).begin(); c != tile.dim(2).end(); ++c) {
+                        for (int d = tile.dim(3).begin(); d != tile.dim(3).end(); ++d) {
+                            ++nd_visits[((a * 6 + b) * 7 + c) * 3 + d];
+                        }
+                    }
+                }
+            }
+        });
+        REQUIRE(tiles == 3 * 3 * 4 * 2);
+        REQUIRE(std::count(nd_visits.begin(), nd_visits.end(), 1) == int(nd_visits.size()));
+    }
+}
+
+//! Testing that cache_oblivious_range halves the longest dimension at the tile boundaries
+//! \brief \ref requirement
+TEST_CASE("cache_oblivious_range split") {
+    using range_type = tbb::cache_oblivious_range<tbb::blocked_range2d<int>>;
+    range_type r(10, 110, 8, 0, 40, 4);
+    range_type r2(r, tbb::split());
+    // The rows are longer and are split at the boundary of the tile that is nearest to the middle
+    REQUIRE((r.rows().begin() == 10 && r.rows().end() == 58 && r2.rows().begin() == 58 && r2.rows().end() == 110));
+    REQUIRE((r.cols().begin() == 0 && r.cols().end() == 40 && r2.cols().begin() == 0 && r2.cols().end() == 40));
+    range_type r3(r, tbb::split());
+    REQUIRE((r.rows().size() == 24 && r3.rows().size() == 24 && r3.cols().size() == 40));
+    range_type r4(r, tbb::split());
+    REQUIRE((r.rows().size() == 24 && r.cols().end() == 20 && r4.cols().begin() == 20));
+
+    // The proportional split of the underlying range must not be used
+    REQUIRE_FALSE(std::is_constructible<range_type, range_type&, tbb::proportional_split&>::value);
+
+    using range3d_type = tbb::cache_oblivious_range<tbb::blocked_range3d<int>>;
+    range3d_type r3d(0, 10, 0, 100, 0, 30);
+    range3d_type r3d_second(r3d, tbb::split());
+    REQUIRE((r3d.rows().end() == 50 && r3d_second.rows().begin() == 50 && r3d_second.pages().size() == 10));
+
+    using range_nd_type = tbb::cache_oblivious_range<tbb::blocked_nd_range<int, 3>>;
+    range_nd_type rnd({0, 10, 2}, {0, 10, 2}, {0, 40, 16});
+    range_nd_type rnd_second(rnd, tbb::split());
+    REQUIRE((rnd.dim(2).end() == 16 && rnd_second.dim(2).begin() == 16 && rnd_second.dim(0).size() == 10));
+}
+
+//! Testing cache_oblivious_range with parallel_for
+//! \brief \ref requirement
+TEST_CASE("cache_oblivious_range with parallel_for") {
+    using range_type = tbb::cache_oblivious_range<tbb::blocked_range2d<int>>;
+    const int rows = 300, cols = 500;
+    std::vector<std::atomic<int>> visits(rows * cols);
+    for (auto& v : visits) {
+        v = 0;
+    }
+    std::atomic<bool> is_aligned{true};
+    tbb::parallel_for(range_type(0, rows, 16, 0, cols, 16), [&](const range_type& r) {
+        if (r.rows().begin() % 16 != 0 || r.cols().begin() % 16 != 0) {
+            is_aligned = false;
+        }
+        tbb::for_each_tile(r, tbb::traversal_order::hilbert, [&](const tbb::blocked_range2d<int>& tile) {
+            for (int i = tile.rows().begin(); i != tile.rows().end(); ++i) {
+                for (int j = tile.cols().begin(); j != tile.cols().end(); ++j) {
+                    ++visits[i * cols + j];
+                }
+            }
+        });
+    });
+    bool visited_once = true;
+    for (auto& v : visits) {
+        visited_once = visited_once && v == 1;
+    }
+    REQUIRE_MESSAGE(visited_once, "Each element must be processed exactly once");
+    REQUIRE_MESSAGE(is_aligned, "Subranges must be aligned to the grain size");
+
+    using range_nd_type = tbb::cache_oblivious_range<tbb::blocked_nd_range<int, 2>>;
+    std::atomic<long> sum{0};
+    tbb::parallel_for(range_nd_type({rows, cols}, 8), [&](const range_nd_type& r) {
+        long local = 0;
+        for (int i = r.dim(0).begin(); i != r.dim(0).end(); ++i) {
+            for (int j = r.dim(1).begin(); j != r.dim(1).end(); ++j) {
+                local += i * cols + j;
+            }
+        }
+        sum += local;
+    }, tbb::simple_partitioner());
+    REQUIRE(sum == long(rows * cols) * (rows * cols - 1) / 2);
+}
+
 #if __TBB_CPP20_CONCEPTS_PRESENT
 
 template <bool ExpectSatisfies, typename... Types>
@@ -0,0 +1,209 @@
+/*
+    Copyright (c) 2024 Intel Corporation
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#define TBB_PREVIEW_COROUTINES 1
+
+#include "common/test.h"
+#include "common/utils.h"
+#include "common/spin_barrier.h"
+
+#include "oneapi/tbb/detail/_config.h"
+
+//! \file test_coro_task.cpp
+//! \brief Test for [scheduler.coroutines] preview feature
+
+#if __TBB_CPP20_COROUTINES_PRESENT
+
+#include "tbb/coro_task.h"
+#include "tbb/flow_graph.h"
+#include "tbb/global_control.h"
+#include "tbb/task_arena.h"
+#include "tbb/task_group.h"
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+static tbb::coro_task<int> square(int value) {
+    co_return value * value;
+}
+
+static tbb::coro_task<int> sum_of_squares(int count) {
+    int sum = 0;
+    for (int i = 0; i < count; ++i) {
+        sum += co_await square(i);
+    }
+    co_return sum;
+}
+
+//! Testing that a coroutine awaits the results of other coroutines
+//! \brief \ref interface
+TEST_CASE("Awaiting coro_task") {
+    std::atomic<int> result{0};
+    auto body = [](std::atomic<int>& sum) -> tbb::coro_task<> {
+        sum = co_await sum_of_squares(10);
+    };
+    tbb::task_group tg;
+    tg.run(body(result));
+    tg.wait();
+    CHECK(result == 285);
+}
+
+//! Testing that the coroutine is resumed inside the given arena
+//! \brief \ref requirement
+TEST_CASE("Resuming in an arena") {
+    constexpr int arena_concurrency = 3;
+    tbb::task_arena arena(arena_concurrency);
+    std::atomic<int> observed_concurrency{0};
+    auto body = [](tbb::task_arena& a, std::atomic<int>& concurrency) -> tbb::coro_task<> {
+        co_await tbb::resume_in(a);
+        concurrency = tbb::this_task_arena::max_concurrency();
+    };
+    tbb::task_group tg;
+    tg.run(body(arena, observed_concurrency));
+    tg.wait();
+    CHECK(observed_concurrency == arena_concurrency);
+}
+
+//! Testing that many coroutines suspended at the same time are completed
+//! \brief \ref requirement
+TEST_CASE("Many coroutines in a task group") {
+    constexpr int num_coroutines = 10000;
+    tbb::task_arena arena;
+    std::atomic<int> num_completed{0};
+    auto body = [](tbb::task_arena& a, std::atomic<int>& completed) -> tbb::coro_task<> {
+        co_await tbb::resume_in(a);
+        int value = co_await square(2);
+        co_await tbb::resume_in(a);
+        completed += value;
+    };
+    tbb::task_group tg;
+    for (int i = 0; i < num_coroutines; ++i) {
+        tg.run(body(arena, num_completed));
+    }
+    tg.wait();
+    CHECK(num_completed == 4 * num_coroutines);
+}
+
+constexpr int num_tasks = 100;
+
+//! Testing that a coroutine awaits the tasks of a task group and the work of a flow graph
+//! \brief \ref interface
+TEST_CASE("Awaiting task_group and flow graph") {
+    std::atomic<int> num_executed{0};
+    std::atomic<bool> is_done{false};
+    auto body = [](std::atomic<int>& executed, std::atomic<bool>& done) -> tbb::coro_task<> {
+        tbb::task_group inner;
+        for (int i = 0; i < num_tasks; ++i) {
+            inner.run([&executed] { ++executed; });
+        }
+        tbb::task_group_status status = co_await inner;
+        CHECK(status == tbb::complete);
+        CHECK(executed == num_tasks);
+
+        tbb::flow::graph g;
+        tbb::flow::function_node<int> node(g, tbb::flow::unlimited, [&executed](int) { ++executed; });
+        for (int i = 0; i < num_tasks; ++i) {
+            node.try_put(i);
+        }
+        status = co_await g;
+        CHECK(status == tbb::complete);
+        CHECK(executed == 2 * num_tasks);
+        done = true;
+    };
+    tbb::task_group tg;
+    tg.run(body(num_executed, is_done));
+    tg.wait();
+    CHECK(is_done);
+}
+
+//! Testing that the coroutines awaiting the work do not hold the threads of the arena
+//! \brief \ref requirement
+TEST_CASE("More awaiting coroutines than threads") {
+    constexpr int num_coroutines = 8;
+    tbb::global_control parallelism(tbb::global_control::max_allowed_parallelism, 3);
+    tbb::task_arena arena(2, 0);
+    std::unique_ptr<tbb::task_group[]> groups(new tbb::task_group[num_coroutines]);
+    // The deferred tasks keep the work of the groups incomplete until they are destroyed
+    std::vector<tbb::task_handle> reservations;
+    for (int i = 0; i < num_coroutines; ++i) {
+        reservations.push_back(groups[i].defer([] {}));
+    }
+    std::atomic<int> num_suspended{0};
+    std::atomic<int> num_resumed{0};
+    auto body = [](tbb::task_group& inner, std::atomic<int>& suspended, std::atomic<int>& resumed) -> tbb::coro_task<> {
+        ++suspended;
+        tbb::task_group_status status = co_await inner;
+        CHECK(status == tbb::complete);
+        ++resumed;
+    };
+    tbb::task_group outer;
+    arena.execute([&] {
+        for (int i = 0; i < num_coroutines; ++i) {
+            outer.run(body(groups[i], num_suspended, num_resumed));
+        }
+    });
+    utils::SpinWaitUntilEq(num_suspended, num_coroutines);
+
+    std::atomic<bool> is_executed{false};
+    arena.enqueue([&is_executed] { is_executed = true; });
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (!is_executed && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::yield();
+    }
+    CHECK(is_executed);
+    CHECK(num_resumed == 0);
+
+    // The coroutines are resumed in the arena where the work is completed
+    arena.execute([&reservations] { reservations.clear(); });
+    arena.execute([&outer] { outer.wait(); });
+    CHECK(num_resumed == num_coroutines);
+}
+
+#if TBB_USE_EXCEPTIONS
+static tbb::coro_task<int> failing() {
+    throw std::runtime_error("failure");
+    co_return 0;
+}
+
+//! Testing that the exceptions are propagated to the awaiting coroutine and to the task group
+//! \brief \ref error_guessing
+TEST_CASE("Exceptions in coroutines") {
+    std::atomic<bool> is_caught{false};
+    auto catching = [](std::atomic<bool>& caught) -> tbb::coro_task<> {
+        try {
+            co_await failing();
+        } catch (const std::runtime_error&) {
+            caught = true;
+        }
+    };
+    tbb::task_group tg;
+    tg.run(catching(is_caught));
+    tg.wait();
+    CHECK(is_caught);
+
+    auto throwing = []() -> tbb::coro_task<> {
+        co_await failing();
+    };
+    tg.run(throwing());
+    CHECK_THROWS_AS(tg.wait(), std::runtime_error);
+}
+#endif // TBB_USE_EXCEPTIONS
+
+#endif // __TBB_CPP20_COROUTINES_PRESENT
@@ -0,0 +1,143 @@
+/*
+    Copyright (c) 2024 Intel Corporation
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#define TBB_PREVIEW_PARALLEL_FOR_CHAIN 1
+
+#include "common/test.h"
+#include "common/utils.h"
+#include "common/utils_concurrency_limit.h"
+
+#include "tbb/parallel_for_chain.h"
+#include "tbb/blocked_range2d.h"
+#include "tbb/global_control.h"
+#include "tbb/spin_mutex.h"
+#include "tbb/task_arena.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+//! \file test_parallel_for_chain.cpp
+//! \brief Test for [algorithms.parallel_for_chain]
+
+//! Testing that every phase sees the results of the whole previous phase
+//! \brief \ref requirement
+TEST_CASE("parallel_for_chain phases are separated") {
+    for (auto concurrency_level : utils::concurrency_range()) {
+        tbb::global_control control(tbb::global_control::max_allowed_parallelism, concurrency_level);
+        for (std::size_t size : {std::size_t(1), std::size_t(7), std::size_t(1000), std::size_t(100000)}) {
+            // Each phase computes b[i] = a[i - 1] + a[i + 1] and swaps the arrays, so the phases must not overlap
+            std::vector<long> a(size, 1), b(size, 0);
+            const std::size_t phase_count = 9;
+            tbb::parallel_for_chain(tbb::blocked_range<std::size_t>(0, size), phase_count,
+                [&](const tbb::blocked_range<std::size_t>& r, std::size_t phase) {
+                    const std::vector<long>& in = phase % 2 == 0 ? a : b;
+                    std::vector<long>& out = phase % 2 == 0 ? b : a;
+                    for (std::size_t i = r.begin(); i != r.end(); ++i) {
+                        out[i] = (i > 0 ? in[i - 1] : 0) + (i + 1 < size ? in[i + 1] : 0);
+                    }
+                });
+            std::vector<long> x(size, 1), y(size, 0);
+            for (std::size_t phase = 0; phase < phase_count; ++phase) {
+                for (std::size_t i = 0; i < size; ++i) {
+                    y[i] = (i > 0 ? x[i - 1] : 0) + (i + 1 < size ? x[i + 1] : 0);
+                }
+                std::swap(x, y);
+            }
+            REQUIRE(b == x);
+        }
+    }
+}
+
+//! Testing that the range is split into the same subranges in all phases
+//! \brief \ref requirement
+TEST_CASE("parallel_for_chain keeps the decomposition of the range") {
+    using range_type = tbb::blocked_range2d<int>;
+    for (auto concurrency_level : utils::concurrency_range()) {
+        tbb::global_control control(tbb::global_control::max_allowed_parallelism, concurrency_level);
+        const std::size_t phase_count = 4;
+        std::vector<std::vector<std::pair<int, int>>> chunks(phase_count);
+        std::vector<std::atomic<int>> visits(100 * 200);
+        for (auto& v : visits) {
+            v = 0;
+        }
+        tbb::spin_mutex mutex;
+        tbb::parallel_for_chain(range_type(0, 100, 0, 200), phase_count, [&](const range_type& r, std::size_t phase) {
+            for (int i = r.rows().begin(); i != r.rows().end(); ++i) {
+                for (int j = r.cols().begin(); j != r.cols().end(); ++j) {
+                    ++visits[i * 200 + j];
+                }
+            }
+            tbb::spin_mutex::scoped_lock lock(mutex);
+            chunks[phase].emplace_back(r.rows().begin() * 200 + r.cols().begin(), r.rows().end() * 200 + r.cols().end());
+        });
+        REQUIRE(std::count(visits.begin(), visits.end(), int(phase_count)) == int(visits.size()));
+        std::sort(chunks[0].begin(), chunks[0].end());
+        for (std::size_t phase = 1; phase < phase_count; ++phase) {
+            std::sort(chunks[phase].begin(), chunks[phase].end());
+            REQUIRE(chunks[phase] == chunks[0]);
+        }
+        REQUIRE(chunks[0].size() <= 4 * std::size_t(tbb::this_task_arena::max_concurrency()));
+    }
+}
+
+//! Testing empty ranges and zero phases
+//! \brief \ref boundary
+TEST_CASE("parallel_for_chain with nothing to do") {
+    int calls = 0;
+    auto body = [&calls](const tbb::blocked_range<int>&, std::size_t) { ++calls; };
+    tbb::parallel_for_chain(tbb::blocked_range<int>(5, 5), 10, body);
+    tbb::parallel_for_chain(tbb::blocked_range<int>(0, 100), 0, body);
+    REQUIRE(calls == 0);
+}
+
+//! Testing cancellation through the user-supplied context
+//! \brief \ref requirement
+TEST_CASE("parallel_for_chain cancellation") {
+    tbb::task_group_context context;
+    std::atomic<int> last_phase{-1};
+    tbb::parallel_for_chain(tbb::blocked_range<int>(0, 10000), 5, [&](const tbb::blocked_range<int>&, std::size_t phase) {
+        int current = last_phase;
+        while (current < int(phase) && !last_phase.compare_exchange_weak(current, int(phase))) {}
+        if (phase == 1) {
+            context.cancel_group_execution();
+        }
+    }, context);
+    REQUIRE(last_phase == 1);
+}
+
+#if TBB_USE_EXCEPTIONS
+//! Testing that an exception stops the chain
+//! \brief \ref error_guessing
+TEST_CASE("parallel_for_chain exception handling") {
+    for (auto concurrency_level : utils::concurrency_range()) {
+        tbb::global_control control(tbb::global_control::max_allowed_parallelism, concurrency_level);
+        std::atomic<int> last_phase{-1};
+        REQUIRE_THROWS_AS(tbb::parallel_for_chain(tbb::blocked_range<int>(0, 10000), 5,
+            [&](const tbb::blocked_range<int>& r, std::size_t phase) {
+                int current = last_phase;
+                while (current < int(phase) && !last_phase.compare_exchange_weak(current, int(phase))) {}
+                if (phase == 2 && r.begin() == 0) {
+                    throw std::runtime_error("phase exception");
+                }
+            }), std::runtime_error);
+        REQUIRE_MESSAGE(last_phase == 2, "The phases after the exception must not be started");
+    }
+}
+#endif // TBB_USE_EXCEPTIONS
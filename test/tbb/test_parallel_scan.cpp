@@ -1,5 +1,5 @@
 /*
-    Copyright (c) 2005-2022 Intel Corporation
+    Copyright (c) 2005-2024 Intel Corporation
 
     Licensed under the Apache License, Version 2.0 (the "License");
     you may not use this file except in compliance with the License.
@@ -18,6 +18,8 @@
 #pragma warning(disable : 2586) // decorated name length exceeded, name was truncated
 #endif
 
+#define TBB_PREVIEW_PARALLEL_PREFIX_SCAN 1
+
 #include "common/test.h"
 #include "common/config.h"
 #include "common/utils_concurrency_limit.h"
@@ -30,6 +32,10 @@
 #include "tbb/tick_count.h"
 #include <vector>
 #include <atomic>
+#include <cstdint>
+#include <functional>
+#include <numeric>
+#include <utility>
 
 //! \file test_parallel_scan.cpp
 //! \brief Test for [algorithms.parallel_scan] specification
@@ -563,6 +569,80 @@ TEST_CASE("parallel_scan testing with generic lambdas") {
 }
 #endif /* __TBB_CPP14_GENERIC_LAMBDAS_PRESENT */
 
+//! Testing parallel_inclusive_scan and parallel_exclusive_scan against the serial algorithms
+//! \brief \ref requirement
+TEST_CASE("parallel_inclusive_scan and parallel_exclusive_scan") {
+    for (auto concurrency_level : utils::concurrency_range()) {
+        tbb::global_control control(tbb::global_control::max_allowed_parallelism, concurrency_level);
+        for (std::size_t size : {std::size_t(0), std::size_t(1), std::size_t(1000), std::size_t(40000),
+                                 std::size_t(1000003)}) {
+            std::vector<long> input(size);
+            for (std::size_t i = 0; i < size; ++i) {
+                input[i] = long((i * 7919) % 1000) - 500;
+            }
+            std::vector<long> expected(size);
+            std::partial_sum(input.begin(), input.end(), expected.begin());
+
+            std::vector<long> output(size);
+            REQUIRE(tbb::parallel_inclusive_scan(input.begin(), input.end(), output.begin()) == output.end());
+            REQUIRE_MESSAGE(output == expected, "Wrong inclusive scan");
+
+            // In-place scan with an initial value
+            std::vector<long> inplace = input;
+            tbb::parallel_inclusive_scan(inplace.begin(), inplace.end(), inplace.begin(), std::plus<long>(), 10L);
+            bool is_correct = true;
+            for (std::size_t i = 0; i < size; ++i) {
+                is_correct = is_correct && inplace[i] == expected[i] + 10;
+            }
+            REQUIRE_MESSAGE(is_correct, "Wrong in-place inclusive scan");
+
+            inplace = input;
+            REQUIRE(tbb::parallel_exclusive_scan(inplace.begin(), inplace.end(), inplace.begin(), 10L) == inplace.end());
+            for (std::size_t i = 0; i < size; ++i) {
+                is_correct = is_correct && inplace[i] == (i == 0 ? 10 : expected[i - 1] + 10);
+            }
+            REQUIRE_MESSAGE(is_correct, "Wrong in-place exclusive scan");
+        }
+    }
+}
+
+//! Testing the scans with a non-commutative operation and different input and output types
+//! \brief \ref requirement
+TEST_CASE("parallel_inclusive_scan with non-commutative operation") {
+    // Composition of affine maps x -> a*x + b modulo 2^32 is associative but not commutative
+    using affine = std::pair<unsigned, unsigned>;
+    auto compose = [](const affine& f, const affine& g) {
+        return affine(g.first * f.first, g.first * f.second + g.second);
+    };
+    const std::size_t size = 300000;
+    std::vector<affine> input(size);
+    for (std::size_t i = 0; i < size; ++i) {
+        input[i] = affine(unsigned(i % 7 + 1), unsigned(i));
+    }
+    std::vector<affine> expected(size);
+    affine sum(1, 0);
+    for (std::size_t i = 0; i < size; ++i) {
+        sum = compose(sum, input[i]);
+        expected[i] = sum;
+    }
+    for (auto concurrency_level : utils::concurrency_range()) {
+        tbb::global_control control(tbb::global_control::max_allowed_parallelism, concurrency_level);
+        std::vector<affine> output(size);
+        tbb::parallel_inclusive_scan(input.begin(), input.end(), output.begin(), compose);
+        REQUIRE_MESSAGE(output == expected, "Wrong inclusive scan");
+
+        tbb::parallel_exclusive_scan(input.begin(), input.end(), output.begin(), affine(1, 0), compose);
+        REQUIRE_MESSAGE(std::equal(output.begin() + 1, output.end(), expected.begin()), "Wrong exclusive scan");
+    }
+
+    // Accumulation in a wider type
+    std::vector<std::uint8_t> bytes(100000, 255);
+    std::vector<std::uint64_t> sums(bytes.size());
+    tbb::parallel_inclusive_scan(bytes.data(), bytes.data() + bytes.size(), sums.data(),
+                                 std::plus<std::uint64_t>(), std::uint64_t(0));
+    REQUIRE(sums.back() == 255 * bytes.size());
+}
+
 #if __TBB_CPP20_CONCEPTS_PRESENT
 //! \brief \ref error_guessing
 TEST_CASE("parallel_scan constraints") {
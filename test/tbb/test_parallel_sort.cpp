@@ -1,5 +1,5 @@
 /*
-    Copyright (c) 2005-2022 Intel Corporation
+    Copyright (c) 2005-2024 Intel Corporation
 
     Licensed under the Apache License, Version 2.0 (the "License");
     you may not use this file except in compliance with the License.
@@ -14,6 +14,9 @@
     limitations under the License.
 */
 
+#define TBB_PREVIEW_PARALLEL_SORT_STRATEGIES 1
+#define TBB_PREVIEW_PARALLEL_PARTIAL_SORT 1
+
 #include "common/test.h"
 #include "common/utils_concurrency_limit.h"
 #include "common/cpu_usertime.h"
@@ -31,6 +34,9 @@
 #include <cstring>
 #include <cstddef>
 #include <iterator>
+#include <limits>
+#include <random>
+#include <stdexcept>
 #include <type_traits>
 
 //! \file test_parallel_sort.cpp
@@ -422,6 +428,222 @@ TEST_CASE("That all workers sleep when no work") {
     TestCPUUserTime(utils::get_platform_max_threads());
 }
 
+template <typename T, typename Compare, typename Strategy>
+void test_sort_strategy(std::vector<T> data, const Compare& comp, Strategy strategy) {
+    std::vector<T> expected = data;
+    std::sort(expected.begin(), expected.end(), comp);
+    tbb::parallel_sort(data.begin(), data.end(), comp, strategy);
+    REQUIRE_MESSAGE(std::is_sorted(data.begin(), data.end(), comp), "Testing data not sorted");
+    // Equivalent values may be permuted, but the values themselves must be preserved
+    std::sort(data.begin(), data.end(), comp);
+    bool values_preserved = true;
+    for (std::size_t i = 0; i < data.size(); ++i) {
+        values_preserved = values_preserved && !comp(data[i], expected[i]) && !comp(expected[i], data[i]);
+    }
+    REQUIRE_MESSAGE(values_preserved, "Values are lost");
+}
+
+template <typename T>
+std::vector<T> generate_radix_sort_data(std::size_t size, int pattern) {
+    std::mt19937_64 rng(size + pattern);
+    std::vector<T> data(size);
+    for (std::size_t i = 0; i < size; ++i) {
+        switch (pattern) {
+        case 0: // random values over the whole value domain
+            data[i] = static_cast<T>(std::is_floating_point<T>::value ? (double(rng()) - double(rng())) / 3. : double(rng() >> 1));
+            if (!std::is_floating_point<T>::value) {
+                std::uint64_t bits = rng();
+                std::memcpy(&data[i], &bits, sizeof(T));
+            }
+            break;
+        case 1: // small values that differ only in the lowest digit
+            data[i] = static_cast<T>(rng() % 100);
+            break;
+        default: // reversed sequence with a few negative zeros for floating point types
+            data[i] = static_cast<T>(size - i) / 2;
+            if (std::is_floating_point<T>::value && i % 1000 == 0) data[i] = -static_cast<T>(0);
+        }
+    }
+    return data;
+}
+
+template <typename T>
+void test_radix_sort_for_type() {
+    for (std::size_t size : {std::size_t(0), std::size_t(600), std::size_t(70000), std::size_t(300000)}) {
+        for (int pattern = 0; pattern < 3; ++pattern) {
+            std::vector<T> data = generate_radix_sort_data<T>(size, pattern);
+            test_sort_strategy(data, std::less<T>(), tbb::radix_sort_tag());
+            test_sort_strategy(data, std::greater<T>(), tbb::radix_sort_tag());
+        }
+    }
+    // The automatically selected algorithm
+    std::vector<T> data = generate_radix_sort_data<T>(tbb::detail::d1::radix_sort_min_size * 2, 0);
+    tbb::parallel_sort(data);
+    REQUIRE_MESSAGE(std::is_sorted(data.begin(), data.end()), "Testing data not sorted");
+}
+
+//! Testing radix sort of arithmetic values
+//! \brief \ref requirement
+TEST_CASE("parallel_sort with radix_sort_tag") {
+    for (auto concurrency_level : utils::concurrency_range()) {
+        tbb::global_control control(tbb::global_control::max_allowed_parallelism, concurrency_level);
+        test_radix_sort_for_type<std::int8_t>();
+        test_radix_sort_for_type<std::uint16_t>();
+        test_radix_sort_for_type<int>();
+        test_radix_sort_for_type<unsigned>();
+        test_radix_sort_for_type<std::int64_t>();
+        test_radix_sort_for_type<float>();
+        test_radix_sort_for_type<double>();
+    }
+}
+
+//! Testing radix sort of an array and with the transparent comparator
+//! \brief \ref requirement
+TEST_CASE("parallel_sort with radix_sort_tag for an array") {
+    sort_array_test([](int (&array)[array_size]) {
+        tbb::parallel_sort(array, std::less<int>(), tbb::radix_sort_tag());
+    });
+#if __cpp_lib_transparent_operators
+    std::vector<double> data = generate_radix_sort_data<double>(100000, 0);
+    test_sort_strategy(data, std::greater<>(), tbb::radix_sort_tag());
+#endif
+}
+
+//! Testing sample sort
+//! \brief \ref requirement
+TEST_CASE("parallel_sort with sample_sort_tag") {
+    for (auto concurrency_level : utils::concurrency_range()) {
+        tbb::global_control control(tbb::global_control::max_allowed_parallelism, concurrency_level);
+        for (std::size_t size : {std::size_t(10), std::size_t(9999), std::size_t(100000)}) {
+            std::vector<std::string> strings(size);
+            std::vector<int> duplicates(size);
+            for (std::size_t i = 0; i < size; ++i) {
+                strings[i] = std::to_string(static_cast<float>(sin(float(i))));
+                duplicates[i] = int(i % 3);
+            }
+            test_sort_strategy(strings, std::less<std::string>(), tbb::sample_sort_tag());
+            test_sort_strategy(strings, std::greater<std::string>(), tbb::sample_sort_tag());
+            test_sort_strategy(duplicates, std::less<int>(), tbb::sample_sort_tag());
+            test_sort_strategy(duplicates, [](int lhs, int rhs) { return lhs % 2 < rhs % 2; }, tbb::sample_sort_tag());
+        }
+    }
+}
+
+//! Testing the quicksort strategy
+//! \brief \ref requirement
+TEST_CASE("parallel_sort with quick_sort_tag") {
+    std::vector<double> data = generate_radix_sort_data<double>(100000, 0);
+    test_sort_strategy(data, std::less<double>(), tbb::quick_sort_tag());
+    parallel_sort_test_suite<std::vector<Minimal>, MinimalLessCompare>();
+    sort_array_test([](int (&array)[array_size]) {
+        tbb::parallel_sort(minimal_span<int>{array, array_size}, std::less<int>(), tbb::quick_sort_tag());
+    });
+}
+
+template <typename Compare>
+void test_nth_element_and_partial_sort(const std::vector<double>& data, const Compare& comp) {
+    std::vector<double> sorted = data;
+    std::sort(sorted.begin(), sorted.end(), comp);
+    const std::size_t size = data.size();
+    for (std::size_t position : {std::size_t(0), size / 3, size / 2, size - size / 100, size - 1, size}) {
+        std::vector<double> actual = data;
+        tbb::parallel_nth_element(actual.begin(), actual.begin() + position, actual.end(), comp);
+        if (position < size) {
+            REQUIRE_MESSAGE(actual[position] == sorted[position], "Wrong nth element");
+            bool is_partitioned = true;
+            for (std::size_t i = 0; i < size; ++i) {
+                if (i < position ? comp(actual[position], actual[i]) : comp(actual[i], actual[position])) {
+                    is_partitioned = false;
+                }
+            }
+            REQUIRE_MESSAGE(is_partitioned, "The sequence is not partitioned around the nth element");
+        }
+        std::sort(actual.begin(), actual.end(), comp);
+        REQUIRE_MESSAGE(actual == sorted, "Values are lost");
+
+        actual = data;
+        tbb::parallel_partial_sort(actual.begin(), actual.begin() + position, actual.end(), comp);
+        REQUIRE_MESSAGE(std::equal(actual.begin(), actual.begin() + position, sorted.begin()),
+                        "The prefix does not hold the smallest elements in sorted order");
+        std::sort(actual.begin() + position, actual.end(), comp);
+        REQUIRE_MESSAGE(actual == sorted, "Values are lost");
+    }
+}
+
+//! Testing parallel_nth_element and parallel_partial_sort
+//! \brief \ref requirement
+TEST_CASE("parallel_nth_element and parallel_partial_sort") {
+    for (auto concurrency_level : utils::concurrency_range()) {
+        tbb::global_control control(tbb::global_control::max_allowed_parallelism, concurrency_level);
+        for (std::size_t size : {std::size_t(1), std::size_t(100), std::size_t(5000), std::size_t(200000)}) {
+            for (int pattern = 0; pattern < 3; ++pattern) {
+                std::vector<double> data = generate_radix_sort_data<double>(size, pattern);
+                test_nth_element_and_partial_sort(data, std::less<double>());
+                test_nth_element_and_partial_sort(data, std::greater<double>());
+            }
+        }
+    }
+    // Default comparator and empty sequences
+    std::vector<int> data(10000);
+    for (std::size_t i = 0; i < data.size(); ++i) {
+        data[i] = int((i * 7919) % data.size());
+    }
+    tbb::parallel_nth_element(data.begin(), data.begin() + 42, data.end());
+    REQUIRE(data[42] == 42);
+    tbb::parallel_partial_sort(data.begin(), data.begin() + 100, data.end());
+    for (int i = 0; i < 100; ++i) {
+        REQUIRE(data[i] == i);
+    }
+    tbb::parallel_nth_element(data.begin(), data.begin(), data.begin());
+    tbb::parallel_partial_sort(data.begin(), data.begin(), data.end());
+}
+
+//! Testing that the partitions that cannot contain the nth element are not processed
+//! \brief \ref requirement
+TEST_CASE("parallel_nth_element does linear work") {
+    std::vector<double> data = generate_radix_sort_data<double>(1 << 20, 0);
+    std::atomic<std::size_t> comparisons{0};
+    tbb::parallel_nth_element(data.begin(), data.begin() + data.size() / 2, data.end(),
+                              [&comparisons](double lhs, double rhs) {
+        comparisons.fetch_add(1, std::memory_order_relaxed);
+        return lhs < rhs;
+    });
+    // Sorting of the whole sequence needs more than 20 comparisons per element
+    REQUIRE_MESSAGE(comparisons < 8 * data.size(), "Too many comparisons");
+}
+
+#if TBB_USE_EXCEPTIONS
+//! Testing that sample sort keeps all elements if the comparator throws
+//! \brief \ref error_guessing
+TEST_CASE("parallel_sort with sample_sort_tag and throwing comparator") {
+    constexpr std::size_t size = 100000;
+    std::vector<std::string> data(size);
+    for (std::size_t i = 0; i < size; ++i) {
+        data[i] = std::to_string(size - i);
+    }
+    std::vector<std::string> expected = data;
+    std::sort(expected.begin(), expected.end());
+
+    // Throw during the classification and during the sorting of the buckets
+    for (std::size_t limit : {size / 2, size * 10}) {
+        std::atomic<std::size_t> count{0};
+        bool caught = false;
+        try {
+            tbb::parallel_sort(data, [&](const std::string& lhs, const std::string& rhs) {
+                if (++count == limit) throw std::runtime_error("comparator exception");
+                return lhs < rhs;
+            }, tbb::sample_sort_tag());
+        } catch (const std::runtime_error&) {
+            caught = true;
+        }
+        REQUIRE_MESSAGE(caught, "The exception was not propagated");
+        std::vector<std::string> actual = data;
+        std::sort(actual.begin(), actual.end());
+        REQUIRE_MESSAGE(actual == expected, "Elements were lost after the exception");
+    }
+}
+#endif // TBB_USE_EXCEPTIONS
+
 #if __TBB_CPP20_CONCEPTS_PRESENT
 //! \brief \ref error_guessing
 TEST_CASE("parallel_sort constraints") {
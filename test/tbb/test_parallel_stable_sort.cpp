@@ -0,0 +1,199 @@
+/*
+    Copyright (c) 2024 Intel Corporation
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#define TBB_PREVIEW_PARALLEL_STABLE_SORT 1
+
+#include "common/test.h"
+#include "common/utils.h"
+#include "common/utils_concurrency_limit.h"
+
+#include "tbb/parallel_stable_sort.h"
+#include "tbb/concurrent_vector.h"
+#include "tbb/global_control.h"
+
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+//! \file test_parallel_stable_sort.cpp
+//! \brief Test for [algorithms.parallel_stable_sort]
+
+//! Value with a sort key and the original position used to check stability
+struct KeyAndPosition {
+    int key;
+    std::size_t position;
+};
+
+struct KeyLess {
+    bool operator()(const KeyAndPosition& lhs, const KeyAndPosition& rhs) const {
+        return lhs.key < rhs.key;
+    }
+};
+
+struct KeyGreater {
+    bool operator()(const KeyAndPosition& lhs, const KeyAndPosition& rhs) const {
+        return lhs.key > rhs.key;
+    }
+};
+
+template <typename Container>
+void fill(Container& data, std::size_t size, int num_keys) {
+    data.clear();
+    for (std::size_t i = 0; i < size; ++i) {
+        data.push_back(KeyAndPosition{int((i * 7919) % std::size_t(num_keys)), i});
+    }
+}
+
+template <typename Iterator, typename Compare>
+void check_stable_sorted(Iterator begin, Iterator end, const Compare& comp, std::size_t expected_size) {
+    REQUIRE(std::size_t(end - begin) == expected_size);
+    bool is_stable_sorted = true;
+    for (Iterator it = begin; it != end && it + 1 != end; ++it) {
+        if (comp(*(it + 1), *it) || (!comp(*it, *(it + 1)) && it->position > (it + 1)->position)) {
+            is_stable_sorted = false;
+        }
+    }
+    REQUIRE_MESSAGE(is_stable_sorted, "The sequence is not sorted or the order of equivalent elements is changed");
+}
+
+template <typename Container, typename Compare>
+void test_stable_sort(const Compare& comp) {
+    for (std::size_t size : {std::size_t(0), std::size_t(1), std::size_t(10), std::size_t(499),
+                             std::size_t(2500), std::size_t(50000), std::size_t(200000)}) {
+        for (int num_keys : {1, 10, 1000, 1 << 30}) {
+            Container data;
+            fill(data, size, num_keys);
+            tbb::parallel_stable_sort(data.begin(), data.end(), comp);
+            check_stable_sorted(data.begin(), data.end(), comp, size);
+
+            fill(data, size, num_keys);
+            tbb::parallel_stable_sort(data, comp);
+            check_stable_sorted(data.begin(), data.end(), comp, size);
+        }
+    }
+}
+
+//! Testing stability of the sort for different sequence sizes and numbers of equivalent elements
+//! \brief \ref requirement
+TEST_CASE("parallel_stable_sort keeps the order of equivalent elements") {
+    for (auto concurrency_level : utils::concurrency_range()) {
+        tbb::global_control control(tbb::global_control::max_allowed_parallelism, concurrency_level);
+        test_stable_sort<std::vector<KeyAndPosition>>(KeyLess());
+        test_stable_sort<std::vector<KeyAndPosition>>(KeyGreater());
+    }
+}
+
+//! Testing sequences that are not stored contiguously
+//! \brief \ref requirement
+TEST_CASE("parallel_stable_sort of non-contiguous sequences") {
+    test_stable_sort<std::deque<KeyAndPosition>>(KeyLess());
+    test_stable_sort<tbb::concurrent_vector<KeyAndPosition>>(KeyLess());
+}
+
+//! Testing the default comparator
+//! \brief \ref requirement
+TEST_CASE("parallel_stable_sort with the default comparator") {
+    std::vector<std::string> data(30000);
+    for (std::size_t i = 0; i < data.size(); ++i) {
+        data[i] = std::to_string((i * 7919) % 10007);
+    }
+    std::vector<std::string> expected = data;
+    std::stable_sort(expected.begin(), expected.end());
+
+    std::vector<std::string> copy = data;
+    tbb::parallel_stable_sort(copy.begin(), copy.end());
+    REQUIRE(copy == expected);
+
+    tbb::parallel_stable_sort(data);
+    REQUIRE(data == expected);
+
+    int array[1000];
+    for (int i = 0; i < 1000; ++i) {
+        array[i] = (i * 31) % 1000;
+    }
+    tbb::parallel_stable_sort(array);
+    REQUIRE(std::is_sorted(array, array + 1000));
+}
+
+//! Movable but not copyable and not default constructible value
+class MoveOnlyValue {
+    std::unique_ptr<int> my_value;
+public:
+    explicit MoveOnlyValue(int value) : my_value(new int(value)) {}
+    MoveOnlyValue(MoveOnlyValue&&) = default;
+    MoveOnlyValue& operator=(MoveOnlyValue&&) = default;
+    int value() const { return *my_value; }
+};
+
+//! Testing the minimal requirements on the value type
+//! \brief \ref requirement
+TEST_CASE("parallel_stable_sort of move-only values") {
+    std::vector<MoveOnlyValue> data;
+    for (int i = 0; i < 10000; ++i) {
+        data.emplace_back(10000 - i);
+    }
+    tbb::parallel_stable_sort(data, [](const MoveOnlyValue& lhs, const MoveOnlyValue& rhs) {
+        return lhs.value() < rhs.value();
+    });
+    for (int i = 0; i < 10000; ++i) {
+        REQUIRE(data[i].value() == i + 1);
+    }
+}
+
+#if TBB_USE_EXCEPTIONS
+//! Value that tracks the number of live objects
+struct CountedValue {
+    static std::atomic<long> live_objects;
+    int key;
+    CountedValue(int k) : key(k) { ++live_objects; }
+    CountedValue(const CountedValue& other) : key(other.key) { ++live_objects; }
+    CountedValue(CountedValue&& other) noexcept : key(other.key) { ++live_objects; }
+    CountedValue& operator=(const CountedValue&) = default;
+    CountedValue& operator=(CountedValue&&) = default;
+    ~CountedValue() { --live_objects; }
+};
+std::atomic<long> CountedValue::live_objects{0};
+
+//! Testing that the buffer is released and the exception is propagated if the comparator throws
+//! \brief \ref error_guessing
+TEST_CASE("parallel_stable_sort with throwing comparator") {
+    {
+        std::vector<CountedValue> data;
+        for (int i = 0; i < 100000; ++i) {
+            data.emplace_back(100000 - i);
+        }
+        long expected_live_objects = CountedValue::live_objects;
+        std::atomic<int> count{0};
+        bool caught = false;
+        try {
+            tbb::parallel_stable_sort(data, [&](const CountedValue& lhs, const CountedValue& rhs) {
+                if (++count == 200000) throw std::runtime_error("comparator exception");
+                return lhs.key < rhs.key;
+            });
+        } catch (const std::runtime_error&) {
+            caught = true;
+        }
+        REQUIRE_MESSAGE(caught, "The exception was not propagated");
+        REQUIRE_MESSAGE(CountedValue::live_objects == expected_live_objects, "Objects of the buffer are not destroyed");
+    }
+    REQUIRE(CountedValue::live_objects == 0);
+}
+#endif // TBB_USE_EXCEPTIONS
@@ -0,0 +1,213 @@
+/*
+    Copyright (c) 2024 Intel Corporation
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#define TBB_PREVIEW_PARALLEL_TRANSFORM_REDUCE 1
+
+#include "common/test.h"
+#include "common/utils.h"
+#include "common/utils_concurrency_limit.h"
+
+#include "tbb/parallel_transform_reduce.h"
+#include "tbb/global_control.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+//! \file test_parallel_transform_reduce.cpp
+//! \brief Test for [algorithms.parallel_transform_reduce]
+
+//! Testing the transform reduction of one and two sequences
+//! \brief \ref requirement
+TEST_CASE("parallel_transform_reduce") {
+    for (auto concurrency_level : utils::concurrency_range()) {
+        tbb::global_control control(tbb::global_control::max_allowed_parallelism, concurrency_level);
+        for (std::size_t size : {std::size_t(0), std::size_t(1), std::size_t(1000), std::size_t(100000)}) {
+            std::vector<long> data(size);
+            std::iota(data.begin(), data.end(), 0L);
+            long sum_of_squares = 0;
+            for (long x : data) {
+                sum_of_squares += x * x;
+            }
+            long result = tbb::parallel_transform_reduce(data.begin(), data.end(), 5L, std::plus<long>(),
+                                                         [](long x) { return x * x; });
+            REQUIRE(result == sum_of_squares + 5);
+
+            std::deque<long> other(data.begin(), data.end());
+            result = tbb::parallel_transform_reduce(data.begin(), data.end(), other.begin(), 5L, std::plus<long>(),
+                                                    std::multiplies<long>());
+            REQUIRE(result == sum_of_squares + 5);
+        }
+    }
+}
+
+//! Testing that the order of the elements is kept for a non-commutative reduction
+//! \brief \ref requirement
+TEST_CASE("parallel_transform_reduce with non-commutative reduction") {
+    for (auto concurrency_level : utils::concurrency_range()) {
+        tbb::global_control control(tbb::global_control::max_allowed_parallelism, concurrency_level);
+        std::vector<int> data(20000);
+        for (std::size_t i = 0; i < data.size(); ++i) {
+            data[i] = int(i % 10);
+        }
+        std::string expected = "<";
+        for (int x : data) {
+            expected += char('0' + x);
+        }
+        std::string result = tbb::parallel_transform_reduce(data.begin(), data.end(), std::string("<"),
+            [](std::string lhs, std::string rhs) { return lhs + rhs; },
+            [](int x) { return std::string(1, char('0' + x)); });
+        REQUIRE(result == expected);
+    }
+}
+
+//! Value that counts its copies
+struct CopyCounter {
+    static std::atomic<int> copies;
+    long value;
+    CopyCounter(long v) : value(v) {}
+    CopyCounter(const CopyCounter& other) : value(other.value) { ++copies; }
+    CopyCounter(CopyCounter&&) = default;
+    CopyCounter& operator=(const CopyCounter& other) { value = other.value; ++copies; return *this; }
+    CopyCounter& operator=(CopyCounter&&) = default;
+};
+std::atomic<int> CopyCounter::copies{0};
+
+//! Testing that the accumulated values are moved and not copied
+//! \brief \ref requirement
+TEST_CASE("parallel_transform_reduce moves values") {
+    for (auto concurrency_level : utils::concurrency_range()) {
+        tbb::global_control control(tbb::global_control::max_allowed_parallelism, concurrency_level);
+        std::vector<long> data(100000, 1);
+        CopyCounter::copies = 0;
+        CopyCounter result = tbb::parallel_transform_reduce(data.begin(), data.end(), CopyCounter(0),
+            [](CopyCounter&& lhs, CopyCounter&& rhs) { return CopyCounter(lhs.value + rhs.value); },
+            [](long x) { return CopyCounter(x); });
+        REQUIRE(result.value == long(data.size()));
+        REQUIRE_MESSAGE(CopyCounter::copies == 0, "Values are copied");
+    }
+}
+
+//! Testing parallel_transform for one and two input sequences, including the in-place transformation
+//! \brief \ref requirement
+TEST_CASE("parallel_transform") {
+    for (auto concurrency_level : utils::concurrency_range()) {
+        tbb::global_control control(tbb::global_control::max_allowed_parallelism, concurrency_level);
+        for (std::size_t size : {std::size_t(0), std::size_t(1), std::size_t(100000)}) {
+            std::vector<int> data(size);
+            std::iota(data.begin(), data.end(), 0);
+            std::vector<long> output(size);
+            REQUIRE(tbb::parallel_transform(data.begin(), data.end(), output.begin(),
+                                            [](int x) { return 2L * x; }) == output.end());
+            REQUIRE(tbb::parallel_transform(data.begin(), data.end(), output.begin(), output.begin(),
+                                            [](int x, long y) { return x + y; }) == output.end());
+            bool is_correct = true;
+            for (std::size_t i = 0; i < size; ++i) {
+                is_correct = is_correct && output[i] == 3L * long(i);
+            }
+            REQUIRE(is_correct);
+
+            tbb::parallel_transform(data.begin(), data.end(), data.begin(), [](int x) { return -x; });
+            REQUIRE(std::accumulate(data.begin(), data.end(), 0L) == -std::accumulate(output.begin(), output.end(), 0L) / 3);
+        }
+    }
+}
+
+//! Testing parallel_count_if
+//! \brief \ref requirement
+TEST_CASE("parallel_count_if") {
+    for (auto concurrency_level : utils::concurrency_range()) {
+        tbb::global_control control(tbb::global_control::max_allowed_parallelism, concurrency_level);
+        for (std::size_t size : {std::size_t(0), std::size_t(1), std::size_t(100001)}) {
+            std::vector<int> data(size);
+            std::iota(data.begin(), data.end(), 0);
+            auto is_odd = [](int x) { return x % 2 != 0; };
+            REQUIRE(tbb::parallel_count_if(data.begin(), data.end(), is_odd) ==
+                    std::count_if(data.begin(), data.end(), is_odd));
+        }
+        std::vector<bool> flags(10000);
+        for (std::size_t i = 0; i < flags.size(); i += 3) {
+            flags[i] = true;
+        }
+        REQUIRE(tbb::parallel_count_if(flags.begin(), flags.end(), [](bool b) { return b; }) == 3334);
+    }
+}
+
+//! Testing that parallel_find_if returns the first matching element
+//! \brief \ref requirement
+TEST_CASE("parallel_find_if") {
+    for (auto concurrency_level : utils::concurrency_range()) {
+        tbb::global_control control(tbb::global_control::max_allowed_parallelism, concurrency_level);
+        const int size = 200000;
+        std::vector<int> data(size);
+        std::iota(data.begin(), data.end(), 0);
+        for (int position : {0, 1, 5000, size / 2, size - 1}) {
+            // Every element from position on matches
+            auto it = tbb::parallel_find_if(data.begin(), data.end(), [position](int x) { return x >= position; });
+            REQUIRE(it == data.begin() + position);
+        }
+        REQUIRE(tbb::parallel_find_if(data.begin(), data.end(), [](int x) { return x < 0; }) == data.end());
+        REQUIRE(tbb::parallel_find_if(data.begin(), data.begin(), [](int) { return true; }) == data.begin());
+    }
+}
+
+//! Testing that the search stops early
+//! \brief \ref requirement
+TEST_CASE("parallel_find_if and parallel_any_of early termination") {
+    for (auto concurrency_level : utils::concurrency_range()) {
+        tbb::global_control control(tbb::global_control::max_allowed_parallelism, concurrency_level);
+        const std::size_t size = 1 << 22;
+        std::vector<int> data(size, 0);
+        data[1000] = 1;
+        std::atomic<std::size_t> checked{0};
+        auto is_one = [&checked](int x) {
+            checked.fetch_add(1, std::memory_order_relaxed);
+            return x == 1;
+        };
+        REQUIRE(tbb::parallel_find_if(data.begin(), data.end(), is_one) == data.begin() + 1000);
+        REQUIRE_MESSAGE(checked < size / 2, "The search was not stopped");
+
+        checked = 0;
+        REQUIRE(tbb::parallel_any_of(data.begin(), data.end(), is_one));
+        REQUIRE_MESSAGE(checked < size / 2, "The search was not cancelled");
+
+        data[1000] = 0;
+        REQUIRE_FALSE(tbb::parallel_any_of(data.begin(), data.end(), [](int x) { return x == 1; }));
+        REQUIRE_FALSE(tbb::parallel_any_of(data.begin(), data.begin(), [](int) { return true; }));
+    }
+}
+
+#if TBB_USE_EXCEPTIONS
+//! Testing exception propagation
+//! \brief \ref error_guessing
+TEST_CASE("parallel_transform_reduce exception propagation") {
+    std::vector<int> data(100000, 1);
+    REQUIRE_THROWS_AS(tbb::parallel_transform_reduce(data.begin(), data.end(), 0, std::plus<int>(), [](int x) {
+        if (x == 1) throw std::runtime_error("transform exception");
+        return x;
+    }), std::runtime_error);
+    REQUIRE_THROWS_AS(tbb::parallel_any_of(data.begin(), data.end(), [](int x) -> bool {
+        if (x == 1) throw std::runtime_error("predicate exception");
+        return false;
+    }), std::runtime_error);
+}
+#endif // TBB_USE_EXCEPTIONS
@@ -0,0 +1,154 @@
+/*
+    Copyright (c) 2024 Intel Corporation
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#define TBB_PREVIEW_PARALLEL_WAVEFRONT 1
+
+#include "common/test.h"
+#include "common/utils.h"
+#include "common/utils_concurrency_limit.h"
+
+#include "tbb/parallel_wavefront.h"
+#include "tbb/global_control.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+//! \file test_parallel_wavefront.cpp
+//! \brief Test for [algorithms.parallel_wavefront]
+
+static std::string make_sequence(std::size_t size, unsigned seed) {
+    std::string s(size, 'A');
+    for (std::size_t i = 0; i < size; ++i) {
+        seed = seed * 1103515245u + 12345u;
+        s[i] = "ACGT"[(seed >> 16) % 4];
+    }
+    return s;
+}
+
+//! Length of the longest common subsequence of the prefixes, computed serially
+static std::vector<int> serial_lcs(const std::string& a, const std::string& b) {
+    const std::size_t cols = b.size() + 1;
+    std::vector<int> table((a.size() + 1) * cols, 0);
+    for (std::size_t i = 1; i <= a.size(); ++i) {
+        for (std::size_t j = 1; j <= b.size(); ++j) {
+            table[i * cols + j] = a[i - 1] == b[j - 1] ? table[(i - 1) * cols + j - 1] + 1
+                                                       : std::max(table[(i - 1) * cols + j], table[i * cols + j - 1]);
+        }
+    }
+    return table;
+}
+
+//! Testing a dynamic programming computation against the serial one
+//! \brief \ref requirement
+TEST_CASE("parallel_wavefront computes the longest common subsequence") {
+    for (auto concurrency_level : utils::concurrency_range()) {
+        tbb::global_control control(tbb::global_control::max_allowed_parallelism, concurrency_level);
+        const std::string a = make_sequence(700, 1), b = make_sequence(500, 2);
+        const std::vector<int> expected = serial_lcs(a, b);
+        const std::size_t cols = b.size() + 1;
+        for (std::size_t grainsize : {std::size_t(1), std::size_t(7), std::size_t(64), std::size_t(1000)}) {
+            std::vector<int> table((a.size() + 1) * cols, 0);
+            tbb::parallel_wavefront(tbb::blocked_range2d<std::size_t>(1, a.size() + 1, grainsize, 1, b.size() + 1, grainsize),
+                [&](const tbb::blocked_range2d<std::size_t>& r) {
+                    for (std::size_t i = r.rows().begin(); i != r.rows().end(); ++i) {
+                        for (std::size_t j = r.cols().begin(); j != r.cols().end(); ++j) {
+                            table[i * cols + j] = a[i - 1] == b[j - 1] ? table[(i - 1) * cols + j - 1] + 1
+                                : std::max(table[(i - 1) * cols + j], table[i * cols + j - 1]);
+                        }
+                    }
+                });
+            REQUIRE(table == expected);
+        }
+    }
+}
+
+//! Testing that every block is processed once and after its predecessors
+//! \brief \ref requirement
+TEST_CASE("parallel_wavefront dependencies") {
+    for (auto concurrency_level : utils::concurrency_range()) {
+        tbb::global_control control(tbb::global_control::max_allowed_parallelism, concurrency_level);
+        // 13 x 9 blocks, the last ones are incomplete
+        const int rows = 13, cols = 9;
+        std::vector<std::atomic<int>> done(rows * cols);
+        for (auto& d : done) {
+            d = 0;
+        }
+        std::atomic<bool> is_order_correct{true};
+        tbb::parallel_wavefront(tbb::blocked_range2d<int>(0, 4 * rows - 1, 4, 10, 10 + 3 * cols - 2, 3),
+            [&](const tbb::blocked_range2d<int>& r) {
+                const int i = r.rows().begin() / 4, j = (r.cols().begin() - 10) / 3;
+                if ((i > 0 && done[(i - 1) * cols + j] != 1) || (j > 0 && done[i * cols + j - 1] != 1)) {
+                    is_order_correct = false;
+                }
+                ++done[i * cols + j];
+            });
+        REQUIRE_MESSAGE(is_order_correct, "A block is processed before its predecessors");
+        REQUIRE(std::count_if(done.begin(), done.end(), [](const std::atomic<int>& d) { return d == 1; }) == rows * cols);
+    }
+}
+
+//! Testing empty ranges
+//! \brief \ref boundary
+TEST_CASE("parallel_wavefront with an empty range") {
+    int calls = 0;
+    auto body = [&calls](const tbb::blocked_range2d<int>&) { ++calls; };
+    tbb::parallel_wavefront(tbb::blocked_range2d<int>(0, 0, 0, 10), body);
+    tbb::parallel_wavefront(tbb::blocked_range2d<int>(0, 10, 5, 5), body);
+    REQUIRE(calls == 0);
+    tbb::parallel_wavefront(tbb::blocked_range2d<int>(0, 1, 0, 1), body);
+    REQUIRE(calls == 1);
+}
+
+//! Testing cancellation through the user-supplied context
+//! \brief \ref requirement
+TEST_CASE("parallel_wavefront cancellation") {
+    for (auto concurrency_level : utils::concurrency_range()) {
+        tbb::global_control control(tbb::global_control::max_allowed_parallelism, concurrency_level);
+        tbb::task_group_context context;
+        std::atomic<int> calls{0};
+        tbb::parallel_wavefront(tbb::blocked_range2d<int>(0, 100, 0, 100), [&](const tbb::blocked_range2d<int>& r) {
+            ++calls;
+            if (r.rows().begin() == 5 && r.cols().begin() == 5) {
+                context.cancel_group_execution();
+            }
+        }, context);
+        REQUIRE(context.is_group_execution_cancelled());
+        REQUIRE_MESSAGE(calls < 100 * 100, "The blocks after cancellation must not be processed");
+    }
+}
+
+#if TBB_USE_EXCEPTIONS
+//! Testing exception propagation
+//! \brief \ref error_guessing
+TEST_CASE("parallel_wavefront exception handling") {
+    for (auto concurrency_level : utils::concurrency_range()) {
+        tbb::global_control control(tbb::global_control::max_allowed_parallelism, concurrency_level);
+        std::atomic<int> calls{0};
+        REQUIRE_THROWS_AS(tbb::parallel_wavefront(tbb::blocked_range2d<int>(0, 100, 0, 100),
+            [&](const tbb::blocked_range2d<int>& r) {
+                ++calls;
+                if (r.rows().begin() == 10 && r.cols().begin() == 10) {
+                    throw std::runtime_error("block exception");
+                }
+            }), std::runtime_error);
+        REQUIRE_MESSAGE(calls < 100 * 100, "The blocks after the exception must not be processed");
+    }
+}
+#endif // TBB_USE_EXCEPTIONS
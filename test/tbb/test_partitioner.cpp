@@ -14,9 +14,12 @@
     limitations under the License.
 */
 
+#define TBB_PREVIEW_LEARNING_PARTITIONER 1
+
 #include "common/test.h"
 
 #include "tbb/parallel_for.h"
+#include "tbb/parallel_reduce.h"
 #include "tbb/task_arena.h"
 #include "tbb/task_scheduler_observer.h"
 #include "tbb/global_control.h"
@@ -31,6 +34,8 @@
 #include <utility>
 #include <vector>
 #include <algorithm> // std::min_element
+#include <atomic>
+#include <functional>
 
 //! \file test_partitioner.cpp
 //! \brief Test for [internal] functionality
@@ -227,3 +232,64 @@ TEST_CASE("Test partitioned tasks count and size for static_partitioner") {
 
     test_custom_range<custom_range_with_psplit>(1);
 }
+
+//! Testing that the algorithms produce correct results with learning_partitioner over repeated runs
+//! \brief \ref requirement
+TEST_CASE("learning_partitioner correctness") {
+    for (auto concurrency_level : utils::concurrency_range()) {
+        tbb::global_control control(tbb::global_control::max_allowed_parallelism, concurrency_level);
+        tbb::learning_partitioner partitioner;
+        const int size = 10000;
+        std::vector<int> data(size);
+        for (int run = 0; run < 20; ++run) {
+            // Skewed body: the first elements are much more expensive
+            tbb::parallel_for(tbb::blocked_range<int>(0, size), [&] (const tbb::blocked_range<int>& r) {
+                for (int i = r.begin(); i != r.end(); ++i) {
+                    utils::doDummyWork(i < size / 16 ? 1000 : 10);
+                    data[i] = run + i;
+                }
+            }, partitioner);
+            long expected = 0;
+            for (int i = 0; i < size; ++i) {
+                expected += run + i;
+            }
+            long sum = tbb::parallel_reduce(tbb::blocked_range<int>(0, size), 0L,
+                [&] (const tbb::blocked_range<int>& r, long init) {
+                    for (int i = r.begin(); i != r.end(); ++i) {
+                        init += data[i];
+                    }
+                    return init;
+                }, std::plus<long>(), partitioner);
+            REQUIRE(sum == expected);
+
+            std::atomic<long> index_sum{0};
+            tbb::parallel_for(0, size, [&] (int i) { index_sum += data[i]; }, partitioner);
+            REQUIRE(index_sum == expected);
+        }
+    }
+}
+
+//! Testing that learning_partitioner makes the chunks of a cheap loop larger
+//! \brief \ref requirement
+TEST_CASE("learning_partitioner coarsens cheap loops") {
+    for (auto concurrency_level : utils::concurrency_range()) {
+        tbb::global_control control(tbb::global_control::max_allowed_parallelism, concurrency_level);
+        tbb::learning_partitioner partitioner;
+        auto count_chunks = [&partitioner] {
+            std::atomic<int> chunks{0};
+            tbb::parallel_for(tbb::blocked_range<int>(0, 1000), [&chunks] (const tbb::blocked_range<int>&) {
+                ++chunks;
+            }, partitioner);
+            return chunks.load();
+        };
+        int initial_chunks = count_chunks();
+        int chunks = initial_chunks;
+        for (int run = 0; run < 50; ++run) {
+            chunks = count_chunks();
+        }
+        REQUIRE_MESSAGE(chunks < initial_chunks, "The grain size of a cheap loop was not increased");
+
+        partitioner.reset();
+        REQUIRE(count_chunks() > chunks);
+    }
+}
@@ -0,0 +1,382 @@
+/*
+    Copyright (c) 2024 Intel Corporation
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#define TBB_PREVIEW_SCHEDULER_STATISTICS 1
+
+#include "common/test.h"
+#include "common/utils.h"
+#include "common/utils_concurrency_limit.h"
+#include "common/dummy_body.h"
+#include "common/spin_barrier.h"
+
+#include "tbb/scheduler_statistics.h"
+#include "tbb/parallel_for.h"
+#include "tbb/global_control.h"
+#include "tbb/task_arena.h"
+#include "tbb/task_group.h"
+#include "tbb/task.h"
+#include "tbb/info.h"
+#include "tbb/task_scheduler_observer.h"
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+//! \file test_scheduler_statistics.cpp
+//! \brief Test for [scheduler.statistics] preview feature
+
+static bool is_consistent(const tbb::steal_statistics& stats) {
+    return stats.attempts == stats.successes + stats.failures && stats.tasks_stolen >= stats.successes &&
+           stats.cache_local_steals <= stats.successes;
+}
+
+static std::uint64_t total_successes(const std::vector<tbb::steal_statistics>& stats) {
+    std::uint64_t successes = 0;
+    for (const auto& s : stats) {
+        successes += s.successes;
+    }
+    return successes;
+}
+
+//! Testing the counters of the calling thread
+//! \brief \ref requirement
+TEST_CASE("Steal statistics of the calling thread") {
+    tbb::steal_statistics before = tbb::info::this_thread_steal_statistics();
+    CHECK(is_consistent(before));
+    for (auto concurrency_level : utils::concurrency_range()) {
+        tbb::global_control control(tbb::global_control::max_allowed_parallelism, concurrency_level);
+        tbb::parallel_for(0, 10000, [](int) { utils::doDummyWork(10); });
+        tbb::steal_statistics after = tbb::info::this_thread_steal_statistics();
+        CHECK(is_consistent(after));
+        bool is_monotonic = after.successes >= before.successes && after.failures >= before.failures &&
+                            after.tasks_stolen >= before.tasks_stolen;
+        CHECK_MESSAGE(is_monotonic, "The counters must not decrease");
+        before = after;
+    }
+}
+
+//! Testing that the workers report their steals
+//! \brief \ref requirement
+TEST_CASE("Steal statistics of all threads") {
+    for (auto concurrency_level : utils::concurrency_range()) {
+        tbb::global_control control(tbb::global_control::max_allowed_parallelism, concurrency_level);
+        std::uint64_t successes_before = total_successes(tbb::info::threads_steal_statistics());
+        // Every thread has to take a task for the barrier to be passed; the workers can only steal them
+        utils::SpinBarrier barrier(concurrency_level);
+        tbb::parallel_for(std::size_t(0), concurrency_level, [&barrier](std::size_t) {
+            barrier.wait();
+        }, tbb::simple_partitioner());
+        std::vector<tbb::steal_statistics> stats = tbb::info::threads_steal_statistics();
+        REQUIRE(stats.size() >= concurrency_level);
+        for (const auto& s : stats) {
+            CHECK(is_consistent(s));
+        }
+        CHECK(total_successes(stats) >= successes_before + concurrency_level - 1);
+    }
+}
+
+//! Testing that the external threads are reported while they are alive
+//! \brief \ref requirement
+TEST_CASE("Steal statistics of external threads") {
+    tbb::parallel_for(0, 100, [](int) {});
+    std::size_t num_threads = tbb::info::threads_steal_statistics().size();
+    REQUIRE(num_threads >= 1);
+
+    std::atomic<bool> is_registered{false}, is_checked{false};
+    std::thread external([&] {
+        tbb::parallel_for(0, 100, [](int) {});
+        CHECK(is_consistent(tbb::info::this_thread_steal_statistics()));
+        is_registered = true;
+        utils::SpinWaitUntilEq(is_checked, true);
+    });
+    utils::SpinWaitUntilEq(is_registered, true);
+    CHECK(tbb::info::threads_steal_statistics().size() >= num_threads + 1);
+    is_checked = true;
+    external.join();
+}
+
+static bool is_monotonic(const tbb::scheduler_metrics& before, const tbb::scheduler_metrics& after) {
+    return after.tasks_spawned >= before.tasks_spawned && after.tasks_stolen >= before.tasks_stolen &&
+           after.mailbox_tasks_executed >= before.mailbox_tasks_executed &&
+           after.worker_spin_time >= before.worker_spin_time && after.monitor_wakeups >= before.monitor_wakeups &&
+           after.worker_wakeups >= before.worker_wakeups && after.empty_worker_wakeups >= before.empty_worker_wakeups &&
+           after.worker_wakeup_latency >= before.worker_wakeup_latency &&
+           after.coroutine_stack_hits >= before.coroutine_stack_hits &&
+           after.coroutine_stack_misses >= before.coroutine_stack_misses &&
+           after.trimmed_coroutine_stacks >= before.trimmed_coroutine_stacks;
+}
+
+//! Testing the activity counters of an arena
+//! \brief \ref requirement
+TEST_CASE("Metrics of an arena") {
+    std::size_t num_threads = utils::get_platform_max_threads();
+    tbb::global_control control(tbb::global_control::max_allowed_parallelism, num_threads);
+    tbb::task_arena arena(static_cast<int>(num_threads));
+    tbb::scheduler_metrics empty = arena.metrics();
+    CHECK(empty.tasks_spawned == 0);
+    CHECK(empty.active_workers == 0);
+
+    constexpr int num_tasks = 100;
+    arena.execute([] {
+        tbb::task_group tg;
+        for (int i = 0; i < num_tasks; ++i) {
+            tg.run([] { utils::doDummyWork(100); });
+        }
+        tg.wait();
+    });
+    tbb::scheduler_metrics first = arena.metrics();
+    CHECK(first.tasks_spawned >= std::uint64_t(num_tasks));
+    CHECK(first.sleeping_workers == 0);
+    CHECK(first.active_workers <= num_threads);
+
+    arena.execute([] {
+        tbb::parallel_for(0, 1000, [](int) { utils::doDummyWork(100); });
+    });
+    tbb::scheduler_metrics second = arena.metrics();
+    CHECK_MESSAGE(is_monotonic(first, second), "The counters must not decrease");
+    CHECK(second.tasks_spawned > first.tasks_spawned);
+}
+
+//! Testing that the global counters include the destroyed arenas
+//! \brief \ref requirement
+TEST_CASE("Global scheduler metrics") {
+    std::size_t num_threads = utils::get_platform_max_threads();
+    tbb::global_control control(tbb::global_control::max_allowed_parallelism, num_threads);
+    tbb::scheduler_metrics before = tbb::info::global_scheduler_metrics();
+    tbb::scheduler_metrics arena_metrics;
+    {
+        tbb::task_arena arena(static_cast<int>(num_threads));
+        arena.execute([] {
+            tbb::parallel_for(0, 1000, [](int) { utils::doDummyWork(100); });
+        });
+        arena_metrics = arena.metrics();
+        REQUIRE(arena_metrics.tasks_spawned > 0);
+    }
+    tbb::scheduler_metrics after = tbb::info::global_scheduler_metrics();
+    CHECK_MESSAGE(is_monotonic(before, after), "The counters must not decrease");
+    CHECK(after.tasks_spawned >= before.tasks_spawned + arena_metrics.tasks_spawned);
+    CHECK(after.tasks_stolen >= before.tasks_stolen + arena_metrics.tasks_stolen);
+}
+
+//! Testing the counters of the worker threads joining an arena on request
+//! \brief \ref requirement
+TEST_CASE("Worker wake-up metrics") {
+    std::size_t num_threads = utils::get_platform_max_threads();
+    tbb::global_control control(tbb::global_control::max_allowed_parallelism, num_threads);
+    tbb::task_arena arena(static_cast<int>(num_threads));
+    arena.initialize();
+    tbb::scheduler_metrics empty = arena.metrics();
+    CHECK(empty.worker_wakeups == 0);
+    CHECK(empty.worker_wakeup_latency == 0);
+
+    // The enqueued task can be executed only by a worker thread
+    std::atomic<bool> is_executed{false};
+    arena.enqueue([&is_executed] { is_executed = true; });
+    utils::SpinWaitUntilEq(is_executed, true);
+    tbb::scheduler_metrics metrics = arena.metrics();
+    CHECK(metrics.worker_wakeups >= 1);
+
+    arena.execute([] {
+        tbb::parallel_for(0, 1000, [](int) { utils::doDummyWork(100); });
+    });
+    tbb::scheduler_metrics after = arena.metrics();
+    CHECK_MESSAGE(is_monotonic(metrics, after), "The counters must not decrease");
+    bool is_max_consistent = after.max_worker_wakeup_latency <= after.worker_wakeup_latency;
+    CHECK(is_max_consistent);
+}
+
+#if __TBB_RESUMABLE_TASKS && !__TBB_RESUMABLE_TASKS_USE_THREADS && !(_WIN32 || _WIN64)
+//! Suspends and resumes a task in a new arena, whose destruction releases the stack of the coroutine
+static void suspend_in_new_arena() {
+    tbb::task_arena arena(1, 1);
+    arena.execute([] {
+        tbb::task::suspend([] (tbb::task::suspend_point sp) { tbb::task::resume(sp); });
+    });
+}
+
+//! Testing that the stacks of the coroutines are reused by the next arenas
+//! \brief \ref requirement
+TEST_CASE("Coroutine stack pool metrics") {
+    tbb::scheduler_metrics before = tbb::info::global_scheduler_metrics();
+    constexpr int num_arenas = 10;
+    for (int i = 0; i < num_arenas; ++i) {
+        suspend_in_new_arena();
+    }
+    tbb::scheduler_metrics after = tbb::info::global_scheduler_metrics();
+    CHECK_MESSAGE(is_monotonic(before, after), "The counters must not decrease");
+    std::uint64_t num_acquired = after.coroutine_stack_hits + after.coroutine_stack_misses -
+                                 before.coroutine_stack_hits - before.coroutine_stack_misses;
+    CHECK(num_acquired >= std::uint64_t(num_arenas));
+    CHECK(after.coroutine_stack_hits > before.coroutine_stack_hits);
+    CHECK(after.cached_coroutine_stacks > 0);
+
+    // The stacks of another size are not taken from the cache
+    tbb::global_control control(tbb::global_control::coroutine_stack_size, 64 * 1024);
+    CHECK(tbb::global_control::active_value(tbb::global_control::coroutine_stack_size) == 64 * 1024);
+    suspend_in_new_arena();
+    tbb::scheduler_metrics small = tbb::info::global_scheduler_metrics();
+    CHECK(small.coroutine_stack_misses > after.coroutine_stack_misses);
+    suspend_in_new_arena();
+    tbb::scheduler_metrics reused = tbb::info::global_scheduler_metrics();
+    CHECK(reused.coroutine_stack_hits > small.coroutine_stack_hits);
+}
+#endif // __TBB_RESUMABLE_TASKS && !__TBB_RESUMABLE_TASKS_USE_THREADS && !(_WIN32 || _WIN64)
+
+struct pool_object {
+    char payload[64];
+};
+
+constexpr int num_pool_objects = 32 * 10;
+
+//! Allocates the objects in the small object pool of the calling thread and deallocates them in another thread
+static tbb::small_object_pool_statistics deallocate_in_another_thread() {
+    tbb::detail::d1::small_object_allocator alloc{};
+    std::vector<pool_object*> objects;
+    for (int i = 0; i < num_pool_objects; ++i) {
+        objects.push_back(alloc.new_object<pool_object>());
+    }
+    tbb::small_object_pool_statistics remote_stats;
+    std::thread thread([&] {
+        for (pool_object* object : objects) {
+            alloc.delete_object(object);
+        }
+        remote_stats = tbb::info::this_thread_small_object_pool_statistics();
+    });
+    thread.join();
+    return remote_stats;
+}
+
+//! Testing that the objects deallocated by other threads are returned to their pool in batches
+//! \brief \ref requirement
+TEST_CASE("Small object pool statistics") {
+    tbb::small_object_pool_statistics before = tbb::info::this_thread_small_object_pool_statistics();
+    tbb::small_object_pool_statistics remote_stats = deallocate_in_another_thread();
+    CHECK(remote_stats.remote_deallocations == std::uint64_t(num_pool_objects));
+    CHECK(remote_stats.local_deallocations == 0);
+    bool is_batched = remote_stats.remote_batches > 0 && remote_stats.remote_batches < remote_stats.remote_deallocations;
+    CHECK(is_batched);
+
+    tbb::small_object_pool_statistics after = tbb::info::this_thread_small_object_pool_statistics();
+    std::uint64_t num_allocated = after.local_allocations + after.remote_allocations + after.new_allocations -
+        before.local_allocations - before.remote_allocations - before.new_allocations;
+    CHECK(num_allocated == std::uint64_t(num_pool_objects));
+    // The batches are returned when the deallocating thread exits at the latest
+    CHECK(after.public_list_length >= std::uint64_t(num_pool_objects));
+
+    // The returned objects are reused by the owning thread
+    tbb::detail::d1::small_object_allocator alloc{};
+    std::vector<pool_object*> objects;
+    for (int i = 0; i < num_pool_objects; ++i) {
+        objects.push_back(alloc.new_object<pool_object>());
+    }
+    tbb::small_object_pool_statistics reused = tbb::info::this_thread_small_object_pool_statistics();
+    CHECK(reused.new_allocations == after.new_allocations);
+    CHECK(reused.remote_allocations > after.remote_allocations);
+    for (pool_object* object : objects) {
+        alloc.delete_object(object);
+    }
+    tbb::small_object_pool_statistics freed = tbb::info::this_thread_small_object_pool_statistics();
+    CHECK(freed.local_deallocations - reused.local_deallocations == std::uint64_t(num_pool_objects));
+}
+
+//! Testing the counters of the small object pools of all threads
+//! \brief \ref interface
+TEST_CASE("Small object pool statistics of all threads") {
+    tbb::parallel_for(0, 10000, [](int) { utils::doDummyWork(10); });
+    std::vector<tbb::small_object_pool_statistics> stats = tbb::info::threads_small_object_pool_statistics();
+    CHECK(!stats.empty());
+    std::uint64_t num_allocated = 0;
+    for (const auto& s : stats) {
+        num_allocated += s.local_allocations + s.remote_allocations + s.new_allocations;
+    }
+    CHECK(num_allocated > 0);
+}
+
+#if OS_AFFINITY_SYSCALL_PRESENT
+//! Pins the calling thread to the first processor available to it
+static void pin_to_first_processor() {
+    std::size_t ncpus = 0;
+    std::vector<int> free_indexes;
+    utils::get_thread_affinity_mask(ncpus, free_indexes);
+    std::atomic<int> first_index{0};
+    utils::pin_thread_imp(ncpus, free_indexes, first_index);
+}
+
+//! Pins the workers joining the arena to the same processor as the external thread
+class single_processor_observer : public tbb::task_scheduler_observer {
+public:
+    single_processor_observer(tbb::task_arena& a) : tbb::task_scheduler_observer(a) {
+        observe(true);
+    }
+
+    ~single_processor_observer() {
+        observe(false);
+    }
+
+    void on_scheduler_entry(bool is_worker) override {
+        if (is_worker) {
+            pin_to_first_processor();
+        }
+    }
+};
+
+//! Testing that the steals between the threads sharing a cache are counted as cache local.
+//! The workers stay pinned to one processor, so the test case goes last.
+//! \brief \ref requirement
+TEST_CASE("Cache local steals") {
+    // Victim selection uses the cache domains only if the topology has been loaded
+    std::vector<tbb::numa_node_id> numa_nodes = tbb::info::numa_nodes();
+    bool is_topology_available = numa_nodes.front() != tbb::task_arena::automatic;
+
+    const std::size_t num_threads = 4;
+    tbb::global_control control(tbb::global_control::max_allowed_parallelism, num_threads);
+    pin_to_first_processor();
+    tbb::task_arena arena(int(num_threads), 1);
+    single_processor_observer observer(arena);
+
+    auto total = [] (const std::vector<tbb::steal_statistics>& stats, std::uint64_t tbb::steal_statistics::* counter) {
+        std::uint64_t sum = 0;
+        for (const auto& s : stats) {
+            sum += s.*counter;
+        }
+        return sum;
+    };
+    std::vector<tbb::steal_statistics> before = tbb::info::threads_steal_statistics();
+    arena.execute([] {
+        for (int i = 0; i < 10; ++i) {
+            // Every thread has to take a task for the barrier to be passed; the workers can only steal them
+            utils::SpinBarrier barrier(num_threads);
+            tbb::parallel_for(std::size_t(0), num_threads, [&barrier](std::size_t) {
+                barrier.wait();
+            }, tbb::simple_partitioner());
+        }
+    });
+    std::vector<tbb::steal_statistics> after = tbb::info::threads_steal_statistics();
+    for (const auto& s : after) {
+        CHECK(is_consistent(s));
+    }
+    std::uint64_t successes = total(after, &tbb::steal_statistics::successes) -
+                              total(before, &tbb::steal_statistics::successes);
+    std::uint64_t local_steals = total(after, &tbb::steal_statistics::cache_local_steals) -
+                                 total(before, &tbb::steal_statistics::cache_local_steals);
+    CHECK(successes >= 10 * (num_threads - 1));
+    // All threads run on the same processor, so the victims share a cache with the thieves unless
+    // the cache domains are unknown
+    bool are_steals_local = local_steals == successes || (!is_topology_available && local_steals == 0);
+    CHECK_MESSAGE(are_steals_local, "The steals between the threads on the same processor must be cache local");
+}
+#endif /* OS_AFFINITY_SYSCALL_PRESENT */
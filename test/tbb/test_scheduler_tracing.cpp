@@ -0,0 +1,254 @@
+/*
+    Copyright (c) 2024 Intel Corporation
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#define TBB_PREVIEW_SCHEDULER_TRACING 1
+
+#include "common/test.h"
+#include "common/utils.h"
+#include "common/utils_concurrency_limit.h"
+#include "common/spin_barrier.h"
+
+#include "tbb/scheduler_tracing.h"
+#include "tbb/global_control.h"
+#include "tbb/parallel_for.h"
+#include "tbb/task.h"
+#include "tbb/task_arena.h"
+#include "tbb/task_group.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+//! \file test_scheduler_tracing.cpp
+//! \brief Test for [scheduler.tracing] preview feature
+
+static const char* trace_file_name = "test_scheduler_tracing.json";
+
+static std::string read_trace() {
+    std::ifstream file(trace_file_name);
+    std::stringstream content;
+    content << file.rdbuf();
+    return content.str();
+}
+
+static std::size_t count_occurrences(const std::string& text, const std::string& pattern) {
+    std::size_t count = 0;
+    for (std::size_t pos = text.find(pattern); pos != std::string::npos; pos = text.find(pattern, pos + pattern.size())) {
+        ++count;
+    }
+    return count;
+}
+
+static void run_work() {
+    tbb::task_group tg;
+    for (int i = 0; i < 10; ++i) {
+        tg.run([] { utils::doDummyWork(100); });
+    }
+    tg.wait();
+    tbb::task_arena arena;
+    arena.execute([] {
+        tbb::parallel_for(0, 100, [](int) { utils::doDummyWork(10); });
+    });
+}
+
+//! Testing that the events are recorded and written in the trace event format
+//! \brief \ref requirement
+TEST_CASE("Scheduler events are dumped") {
+    {
+        tbb::global_control tracing(tbb::global_control::scheduler_tracing, 1);
+        CHECK(tbb::global_control::active_value(tbb::global_control::scheduler_tracing) == 1);
+        for (auto concurrency_level : utils::concurrency_range()) {
+            tbb::global_control control(tbb::global_control::max_allowed_parallelism, concurrency_level);
+            run_work();
+        }
+    }
+    REQUIRE(tbb::dump_scheduler_trace(trace_file_name));
+    std::string trace = read_trace();
+    std::remove(trace_file_name);
+
+    CHECK(trace.find("{\"traceEvents\":[") == 0);
+    bool is_balanced = std::count(trace.begin(), trace.end(), '{') == std::count(trace.begin(), trace.end(), '}') &&
+                       std::count(trace.begin(), trace.end(), '[') == std::count(trace.begin(), trace.end(), ']');
+    CHECK_MESSAGE(is_balanced, "The trace is malformed");
+    CHECK(count_occurrences(trace, "\"name\":\"spawn\"") >= 10);
+    CHECK(count_occurrences(trace, "\"name\":\"execute\",\"cat\":\"scheduler\",\"ph\":\"B\"") >= 10);
+    CHECK(count_occurrences(trace, "\"name\":\"arena\",\"cat\":\"scheduler\",\"ph\":\"B\"") >= 1);
+    CHECK(count_occurrences(trace, "\"name\":\"thread_name\"") >= 1);
+}
+
+//! Testing that the events are not recorded when the tracing is disabled
+//! \brief \ref requirement
+TEST_CASE("Scheduler tracing can be disabled") {
+    tbb::global_control tracing(tbb::global_control::scheduler_tracing, 0);
+    CHECK(tbb::global_control::active_value(tbb::global_control::scheduler_tracing) == 0);
+    REQUIRE(tbb::dump_scheduler_trace(trace_file_name));
+    std::size_t num_events = count_occurrences(read_trace(), "\"ph\":");
+
+    run_work();
+    REQUIRE(tbb::dump_scheduler_trace(trace_file_name));
+    CHECK(count_occurrences(read_trace(), "\"ph\":") == num_events);
+    std::remove(trace_file_name);
+}
+
+//! Testing that the failure to write the trace is reported
+//! \brief \ref error_guessing
+TEST_CASE("Scheduler trace cannot be written") {
+    CHECK_FALSE(tbb::dump_scheduler_trace("non_existent_directory/trace.json"));
+}
+
+//! Returns the parts of the trace with the events of each thread
+static std::vector<std::string> split_by_threads(const std::string& trace) {
+    const std::string thread_name = "\"name\":\"thread_name\"";
+    std::vector<std::string> threads;
+    std::size_t pos = trace.find(thread_name);
+    while (pos != std::string::npos) {
+        std::size_t next = trace.find(thread_name, pos + thread_name.size());
+        threads.push_back(trace.substr(pos, next == std::string::npos ? std::string::npos : next - pos));
+        pos = next;
+    }
+    return threads;
+}
+
+//! Testing that the buffers of the exited threads are reused by the new threads
+//! \brief \ref requirement
+TEST_CASE("Trace buffers of exited threads are reused") {
+    tbb::global_control tracing(tbb::global_control::scheduler_tracing, 1);
+    // The workers do not join, so only the external threads record the events
+    tbb::global_control control(tbb::global_control::max_allowed_parallelism, 1);
+    auto record_in_new_thread = [] {
+        std::thread thread([] {
+            tbb::parallel_for(0, 100, [](int) { utils::doDummyWork(10); });
+        });
+        thread.join();
+    };
+    record_in_new_thread();
+    REQUIRE(tbb::dump_scheduler_trace(trace_file_name));
+    std::size_t num_threads = split_by_threads(read_trace()).size();
+
+    for (int i = 0; i < 20; ++i) {
+        record_in_new_thread();
+    }
+    REQUIRE(tbb::dump_scheduler_trace(trace_file_name));
+    std::vector<std::string> threads = split_by_threads(read_trace());
+    std::remove(trace_file_name);
+    CHECK(threads.size() == num_threads);
+    // The last thread has reused a buffer and reports only its own events
+    std::size_t num_parallel_for_threads = 0;
+    for (const std::string& thread : threads) {
+        if (count_occurrences(thread, "\"name\":\"execute\",\"cat\":\"scheduler\",\"ph\":\"B\"") > 0) {
+            ++num_parallel_for_threads;
+        }
+    }
+    CHECK(num_parallel_for_threads >= 1);
+}
+
+//! Checks that every execution begun in the trace of a thread is ended there
+static void check_executions_are_ended(const std::string& trace) {
+    for (const std::string& thread_events : split_by_threads(trace)) {
+        // The ring buffers that have wrapped around can lose the beginnings of the executions
+        std::size_t num_events = count_occurrences(thread_events, "\"ph\":\"") - 1;
+        if (num_events < 16 * 1024) {
+            std::size_t num_begins = count_occurrences(thread_events, "\"name\":\"execute\",\"cat\":\"scheduler\",\"ph\":\"B\"");
+            std::size_t num_ends = count_occurrences(thread_events, "\"name\":\"execute\",\"cat\":\"scheduler\",\"ph\":\"E\"");
+            CHECK(num_begins == num_ends);
+        }
+    }
+}
+
+#if TBB_USE_EXCEPTIONS
+//! Testing that the execution of a task is ended in the trace when the task throws
+//! \brief \ref error_guessing
+TEST_CASE("Execution of a throwing task is ended in the trace") {
+    tbb::global_control tracing(tbb::global_control::scheduler_tracing, 1);
+    tbb::global_control control(tbb::global_control::max_allowed_parallelism, 1);
+    std::thread thread([] {
+        tbb::task_group tg;
+        for (int i = 0; i < 10; ++i) {
+            tg.run([] { throw std::runtime_error("test"); });
+        }
+        CHECK_THROWS_AS(tg.wait(), std::runtime_error);
+    });
+    thread.join();
+
+    REQUIRE(tbb::dump_scheduler_trace(trace_file_name));
+    check_executions_are_ended(read_trace());
+    std::remove(trace_file_name);
+}
+#endif /* TBB_USE_EXCEPTIONS */
+
+#if __TBB_RESUMABLE_TASKS
+//! Testing that the execution of a suspended task is ended by the thread that suspends it
+//! \brief \ref error_guessing
+TEST_CASE("Execution of a resumed task is begun again in the trace") {
+    tbb::global_control tracing(tbb::global_control::scheduler_tracing, 1);
+    tbb::global_control control(tbb::global_control::max_allowed_parallelism, 2);
+    tbb::task_arena arena(2);
+    std::atomic<std::thread::id> suspending_thread{};
+    std::atomic<bool> is_suspending_thread_busy{false};
+    std::atomic<bool> is_resumed{false};
+    std::thread resumers[2];
+    arena.execute([&] {
+        tbb::task_group tg;
+        constexpr int num_tasks = 100;
+        for (int i = 0; i < num_tasks; ++i) {
+            tg.run([&, i] {
+                if (i == num_tasks - 1) {
+                    // The task executed first is resumed only by its thread, which continues on a coroutine
+                    tbb::task::suspend([&](tbb::task::suspend_point sp) {
+                        resumers[0] = std::thread([&, sp] {
+                            utils::SpinWaitUntilEq(is_resumed, true);
+                            tbb::task::resume(sp);
+                        });
+                    });
+                } else if (i == num_tasks - 2) {
+                    // The task suspended on the coroutine can be resumed by another thread
+                    suspending_thread = std::this_thread::get_id();
+                    tbb::task::suspend([&](tbb::task::suspend_point sp) {
+                        resumers[1] = std::thread([&, sp] {
+                            auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+                            while (!is_suspending_thread_busy && std::chrono::steady_clock::now() < deadline) {
+                                std::this_thread::yield();
+                            }
+                            tbb::task::resume(sp);
+                        });
+                    });
+                    is_resumed = true;
+                } else if (std::this_thread::get_id() == suspending_thread && !is_resumed) {
+                    is_suspending_thread_busy = true;
+                    utils::SpinWaitUntilEq(is_resumed, true);
+                }
+            });
+        }
+        tg.wait();
+    });
+    for (std::thread& resumer : resumers) {
+        resumer.join();
+    }
+
+    REQUIRE(tbb::dump_scheduler_trace(trace_file_name));
+    std::string trace = read_trace();
+    std::remove(trace_file_name);
+    CHECK(count_occurrences(trace, "\"name\":\"suspend\"") > 0);
+    check_executions_are_ended(trace);
+}
+#endif /* __TBB_RESUMABLE_TASKS */
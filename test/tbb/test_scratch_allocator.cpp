@@ -0,0 +1,154 @@
+/*
+    Copyright (c) 2024 Intel Corporation
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#define TBB_PREVIEW_SCRATCH_ALLOCATOR 1
+
+#include "common/test.h"
+#include "common/utils.h"
+
+#include "tbb/parallel_for.h"
+#include "tbb/scratch_allocator.h"
+#include "tbb/task_arena.h"
+#include "tbb/task_group.h"
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+//! \file test_scratch_allocator.cpp
+//! \brief Test for [scheduler.scratch_allocator] preview feature
+
+using scratch_string = std::basic_string<char, std::char_traits<char>, tbb::scratch_allocator<char>>;
+
+constexpr int num_iterations = 10000;
+
+//! Testing the containers that use the scratch memory inside the task bodies
+//! \brief \ref interface
+TEST_CASE("Containers in parallel_for") {
+    std::atomic<long> sum{0};
+    tbb::parallel_for(0, num_iterations, [&sum](int i) {
+        std::vector<int, tbb::scratch_allocator<int>> values;
+        for (int j = 0; j <= i % 100; ++j) {
+            values.push_back(j);
+        }
+        scratch_string text(std::size_t(i % 50 + 20), 'x');
+        long local_sum = 0;
+        for (int value : values) {
+            local_sum += value;
+        }
+        sum += local_sum + long(text.size());
+    });
+    long expected = 0;
+    for (int i = 0; i < num_iterations; ++i) {
+        int n = i % 100;
+        expected += long(n) * (n + 1) / 2 + i % 50 + 20;
+    }
+    CHECK(sum == expected);
+}
+
+//! Testing that the memory of a completed task is reused by the next one
+//! \brief \ref requirement
+TEST_CASE("Memory reuse after the task completion") {
+    tbb::task_arena arena(1);
+    void* first = nullptr;
+    void* second = nullptr;
+    arena.execute([&] {
+        tbb::task_group tg;
+        tg.run_and_wait([&first] { first = tbb::this_task_arena::scratch_allocate(100); });
+        tg.run_and_wait([&second] { second = tbb::this_task_arena::scratch_allocate(100); });
+    });
+    CHECK(first != nullptr);
+    CHECK(first == second);
+
+    // The memory allocated inside task_arena::execute is released when the functor returns
+    arena.execute([&first] { first = tbb::this_task_arena::scratch_allocate(100); });
+    arena.execute([&second] { second = tbb::this_task_arena::scratch_allocate(100); });
+    CHECK(first == second);
+}
+
+//! Testing that the memory is kept while the task is executed, including its nested waits
+//! \brief \ref requirement
+TEST_CASE("Nested waits") {
+    std::atomic<int> num_failures{0};
+    tbb::parallel_for(0, 100, [&num_failures](int i) {
+        unsigned char* outer = static_cast<unsigned char*>(tbb::this_task_arena::scratch_allocate(1000));
+        std::memset(outer, i, 1000);
+        tbb::parallel_for(0, 100, [](int j) {
+            void* inner = tbb::this_task_arena::scratch_allocate(std::size_t(j) + 1);
+            std::memset(inner, 0xff, std::size_t(j) + 1);
+        });
+        for (int k = 0; k < 1000; ++k) {
+            if (outer[k] != (unsigned char)i) {
+                ++num_failures;
+                break;
+            }
+        }
+    });
+    CHECK(num_failures == 0);
+}
+
+//! Testing the alignment and the allocations greater than the chunk of the arena
+//! \brief \ref error_guessing
+TEST_CASE("Alignment and large allocations") {
+    std::atomic<int> num_failures{0};
+    tbb::parallel_for(0, 1000, [&num_failures](int i) {
+        for (std::size_t alignment = 1; alignment <= 4096; alignment *= 2) {
+            void* p = tbb::this_task_arena::scratch_allocate(std::size_t(i % 7), alignment);
+            if (std::uintptr_t(p) % alignment != 0) {
+                ++num_failures;
+            }
+        }
+        std::size_t large_size = std::size_t(i % 3 + 1) * 100 * 1024;
+        char* large = static_cast<char*>(tbb::this_task_arena::scratch_allocate(large_size, 64));
+        if (std::uintptr_t(large) % 64 != 0) {
+            ++num_failures;
+        }
+        std::memset(large, 1, large_size);
+    });
+    CHECK(num_failures == 0);
+}
+
+//! Testing the allocation with the execution data passed to the task
+//! \brief \ref interface
+TEST_CASE("Allocation with the execution data") {
+    struct scratch_task : tbb::detail::d1::task {
+        tbb::detail::d1::wait_context& wait_ctx;
+        bool is_allocated{false};
+
+        explicit scratch_task(tbb::detail::d1::wait_context& w) : wait_ctx(w) {}
+
+        tbb::detail::d1::task* execute(tbb::detail::d1::execution_data& ed) override {
+            void* p = tbb::this_task_arena::scratch_allocate(ed, 256, 32);
+            is_allocated = p != nullptr && std::uintptr_t(p) % 32 == 0;
+            std::memset(p, 0, 256);
+            wait_ctx.release();
+            return nullptr;
+        }
+
+        tbb::detail::d1::task* cancel(tbb::detail::d1::execution_data&) override {
+            wait_ctx.release();
+            return nullptr;
+        }
+    };
+
+    tbb::detail::d1::wait_context wait_ctx{1};
+    tbb::task_group_context ctx;
+    scratch_task t{wait_ctx};
+    tbb::detail::d1::execute_and_wait(t, ctx, wait_ctx, ctx);
+    CHECK(t.is_allocated);
+}
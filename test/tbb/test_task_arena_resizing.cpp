@@ -0,0 +1,208 @@
+/*
+    Copyright (c) 2024 Intel Corporation
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#define TBB_PREVIEW_TASK_ARENA_RESIZING 1
+
+#include "common/test.h"
+#include "common/utils.h"
+#include "common/utils_concurrency_limit.h"
+#include "common/spin_barrier.h"
+
+#include "tbb/global_control.h"
+#include "tbb/parallel_for.h"
+#include "tbb/task_arena.h"
+#include "tbb/task_group.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+//! \file test_task_arena_resizing.cpp
+//! \brief Test for [scheduler.task_arena_resizing] preview feature
+
+//! Runs the work in the arena and checks that it is executed
+static void run_work(tbb::task_arena& arena) {
+    std::atomic<int> sum{0};
+    arena.execute([&sum] {
+        tbb::parallel_for(0, 1000, [&sum](int i) {
+            utils::doDummyWork(100);
+            sum += i;
+        });
+    });
+    CHECK(sum == 999 * 1000 / 2);
+}
+
+//! Creates the arena whose concurrency can grow up to the default concurrency
+static tbb::task_arena make_growable_arena(int max_concurrency) {
+    return tbb::task_arena(max_concurrency, 1, tbb::task_arena::priority::normal,
+                           tbb::task_arena::resizing_policy::growable);
+}
+
+//! Testing that the concurrency of an initialized arena can be decreased and increased
+//! \brief \ref requirement
+TEST_CASE("Resizing an initialized arena") {
+    int num_threads = static_cast<int>(utils::get_platform_max_threads());
+    tbb::global_control control(tbb::global_control::max_allowed_parallelism, num_threads);
+    tbb::task_arena arena = make_growable_arena(1);
+    arena.initialize();
+    CHECK(arena.max_concurrency() == 1);
+    run_work(arena);
+
+    arena.set_max_concurrency(num_threads);
+    CHECK(arena.max_concurrency() == num_threads);
+    run_work(arena);
+    CHECK(tbb::this_task_arena::max_concurrency() == num_threads);
+    int concurrency_inside = arena.execute([] { return tbb::this_task_arena::max_concurrency(); });
+    CHECK(concurrency_inside == num_threads);
+
+    arena.set_max_concurrency(1);
+    CHECK(arena.max_concurrency() == 1);
+    run_work(arena);
+}
+
+//! Testing that the concurrency is limited by the preallocated slots
+//! \brief \ref requirement
+TEST_CASE("Resizing beyond the preallocated slots") {
+    int num_threads = static_cast<int>(utils::get_platform_max_threads());
+    tbb::task_arena arena = make_growable_arena(tbb::task_arena::automatic);
+    arena.initialize();
+    arena.set_max_concurrency(num_threads * 4);
+    CHECK(arena.max_concurrency() <= std::max(num_threads, 2));
+    run_work(arena);
+
+    arena.set_max_concurrency(tbb::task_arena::automatic);
+    CHECK(arena.max_concurrency() >= num_threads);
+    run_work(arena);
+}
+
+//! Testing that only the arenas created with the growable policy grow beyond the initial concurrency
+//! \brief \ref interface
+TEST_CASE("Resizing policies") {
+    int num_threads = static_cast<int>(utils::get_platform_max_threads());
+    // One slot is reserved, so the arenas have at least two slots
+    tbb::task_arena fixed_arena(1);
+    fixed_arena.initialize();
+    fixed_arena.set_max_concurrency(num_threads + 2);
+    CHECK(fixed_arena.max_concurrency() == 2);
+    run_work(fixed_arena);
+
+    tbb::task_arena growable_arena = make_growable_arena(1);
+    tbb::task_arena growable_copy(growable_arena);
+    for (tbb::task_arena* arena : {&growable_arena, &growable_copy}) {
+        arena->initialize();
+        arena->set_max_concurrency(num_threads + 2);
+        CHECK(arena->max_concurrency() == std::max(num_threads, 2));
+        run_work(*arena);
+    }
+}
+
+//! Testing the change of the reserved slots and of the settings of an uninitialized arena
+//! \brief \ref requirement
+TEST_CASE("Resizing the reserved slots") {
+    int num_threads = static_cast<int>(utils::get_platform_max_threads());
+    tbb::task_arena arena;
+    arena.set_max_concurrency(num_threads, 0);
+    arena.initialize();
+    CHECK(arena.max_concurrency() == num_threads);
+
+    arena.set_max_concurrency(num_threads, 1);
+    run_work(arena);
+    std::atomic<bool> is_executed{false};
+    arena.enqueue([&is_executed] { is_executed = true; });
+    utils::SpinWaitUntilEq(is_executed, true);
+
+    arena.set_max_concurrency(num_threads, num_threads);
+    run_work(arena);
+    arena.set_max_concurrency(num_threads, 1);
+    run_work(arena);
+}
+
+//! Testing that the arena is resized while the work is executed in it
+//! \brief \ref error_guessing
+TEST_CASE("Resizing a busy arena") {
+    int num_threads = static_cast<int>(utils::get_platform_max_threads());
+    tbb::global_control control(tbb::global_control::max_allowed_parallelism, num_threads);
+    tbb::task_arena arena(num_threads);
+    arena.initialize();
+    std::atomic<bool> is_done{false};
+    tbb::task_group tg;
+    arena.execute([&] {
+        tg.run([&] {
+            for (int i = 0; i < 50; ++i) {
+                tbb::parallel_for(0, 100, [](int) { utils::doDummyWork(100); });
+            }
+            is_done = true;
+        });
+    });
+    // Without worker threads the work is executed only by the waiting thread
+    for (int i = 0; i < 10000 && !is_done; ++i) {
+        arena.set_max_concurrency(i % num_threads + 1);
+        std::this_thread::yield();
+    }
+    arena.execute([&tg] { tg.wait(); });
+    arena.set_max_concurrency(num_threads);
+    run_work(arena);
+}
+
+//! Counts the arena slots marked in the mask
+static int num_slots_in(unsigned mask) {
+    int num_slots = 0;
+    for (; mask != 0; mask &= mask - 1) {
+        ++num_slots;
+    }
+    return num_slots;
+}
+
+//! Testing that the workers occupying the slots beyond the new concurrency leave a busy arena
+//! \brief \ref requirement
+TEST_CASE("Shrinking a busy arena") {
+    const int num_threads = 8;
+    const int new_concurrency = 2;
+    tbb::global_control control(tbb::global_control::max_allowed_parallelism, num_threads);
+    tbb::task_arena arena(num_threads);
+    arena.initialize();
+
+    std::atomic<unsigned> used_slots{0};
+    tbb::task_group_context ctx;
+    unsigned slots_after_shrink = 0;
+    std::thread resizer([&] {
+        // Shrink the arena after the workers have joined it
+        while (num_slots_in(used_slots) <= new_concurrency) {
+            std::this_thread::yield();
+        }
+        arena.set_max_concurrency(new_concurrency);
+        // Let the workers finish their current tasks, then look at the slots executing the tasks
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+        used_slots = 0;
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+        slots_after_shrink = used_slots;
+        ctx.cancel_group_execution();
+    });
+
+    // The arena does not run out of work until the check is done, so the workers do not leave it
+    // for the lack of tasks
+    arena.execute([&] {
+        tbb::parallel_for(0, 1 << 30, [&used_slots](int) {
+            used_slots |= 1u << tbb::this_task_arena::current_thread_index();
+            utils::doDummyWork(100);
+        }, tbb::simple_partitioner(), ctx);
+    });
+    resizer.join();
+    CHECK(slots_after_shrink != 0);
+    // The slots keep their indices, so the threads are in the first slots
+    CHECK((slots_after_shrink >> new_concurrency) == 0);
+}
@@ -0,0 +1,197 @@
+/*
+    Copyright (c) 2024 Intel Corporation
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#define TBB_PREVIEW_TASK_ARENA_WEIGHTS 1
+#define TBB_PREVIEW_SCHEDULER_STATISTICS 1
+
+#include "common/test.h"
+#include "common/utils.h"
+
+#include "tbb/global_control.h"
+#include "tbb/parallel_for.h"
+#include "tbb/scheduler_statistics.h"
+#include "tbb/task_arena.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+//! \file test_task_arena_weights.cpp
+//! \brief Test for [scheduler.task_arena_weights] preview feature
+
+constexpr int num_workers = 10;
+
+//! Keeps the arena busy with tasks that need all its workers until the work is released
+class busy_arena {
+public:
+    busy_arena(tbb::task_arena& arena) : my_arena(arena) {
+        for (int i = 0; i < 2 * num_workers; ++i) {
+            my_arena.enqueue([this] {
+                ++my_num_started;
+                while (!my_is_released) {
+                    std::this_thread::yield();
+                }
+                ++my_num_finished;
+            });
+        }
+        // Every new task increases the request of the arena
+        while (my_arena.metrics().requested_workers < std::size_t(num_workers)) {
+            std::this_thread::yield();
+        }
+    }
+
+    void release() {
+        my_is_released = true;
+        while (my_num_finished < 2 * num_workers) {
+            std::this_thread::yield();
+        }
+    }
+
+    ~busy_arena() {
+        if (!my_is_released) {
+            release();
+        }
+    }
+
+private:
+    tbb::task_arena& my_arena;
+    std::atomic<bool> my_is_released{false};
+    std::atomic<int> my_num_started{0};
+    std::atomic<int> my_num_finished{0};
+};
+
+static std::size_t allotted_workers(const tbb::task_arena& arena) {
+    return arena.metrics().allotted_workers;
+}
+
+//! Waits until the workers leave the arenas of the previous test cases and their requests are dropped
+static void wait_for_idle_workers() {
+    while (tbb::info::global_scheduler_metrics().requested_workers != 0) {
+        std::this_thread::yield();
+    }
+}
+
+//! Testing the default weight and the limits of the weight
+//! \brief \ref interface
+TEST_CASE("Weight of an arena") {
+    tbb::task_arena arena;
+    unsigned default_weight = tbb::task_arena::default_weight;
+    unsigned max_weight = tbb::task_arena::max_weight;
+    CHECK(arena.weight() == default_weight);
+    arena.set_weight(7);
+    CHECK(arena.is_active());
+    CHECK(arena.weight() == 7);
+    arena.set_weight(0);
+    CHECK(arena.weight() == 1);
+    arena.set_weight(max_weight + 1);
+    CHECK(arena.weight() == max_weight);
+}
+
+//! Testing that the workers are shared in proportion to the weights under contention
+//! \brief \ref requirement
+TEST_CASE("Workers are shared according to the weights") {
+    tbb::global_control control(tbb::global_control::max_allowed_parallelism, num_workers + 1);
+    wait_for_idle_workers();
+    tbb::task_arena first(num_workers + 1), second(num_workers + 1);
+    first.set_weight(7);
+    second.set_weight(3);
+
+    busy_arena busy_first(first);
+    busy_arena busy_second(second);
+    CHECK(allotted_workers(first) == 7);
+    CHECK(allotted_workers(second) == 3);
+
+    second.set_weight(7);
+    CHECK(allotted_workers(first) == 5);
+    CHECK(allotted_workers(second) == 5);
+
+    tbb::scheduler_metrics metrics = tbb::info::global_scheduler_metrics();
+    CHECK(metrics.allotted_workers == std::size_t(num_workers));
+    CHECK(metrics.requested_workers >= std::size_t(2 * num_workers));
+
+    // The idle arena does not limit the other one
+    busy_second.release();
+    while (allotted_workers(second) != 0) {
+        std::this_thread::yield();
+    }
+    CHECK(allotted_workers(first) == std::size_t(num_workers));
+}
+
+//! Testing that an arena with a small demand leaves the rest of its share to the others
+//! \brief \ref requirement
+TEST_CASE("Share exceeding the demand") {
+    tbb::global_control control(tbb::global_control::max_allowed_parallelism, num_workers + 1);
+    wait_for_idle_workers();
+    tbb::task_arena heavy(3), light(num_workers + 1);
+    heavy.set_weight(100);
+    light.set_weight(1);
+
+    busy_arena busy_light(light);
+    std::atomic<bool> is_released{false};
+    std::atomic<int> num_finished{0};
+    for (int i = 0; i < 4; ++i) {
+        heavy.enqueue([&] {
+            while (!is_released) {
+                std::this_thread::yield();
+            }
+            ++num_finished;
+        });
+    }
+    while (heavy.metrics().requested_workers < 2) {
+        std::this_thread::yield();
+    }
+    CHECK(allotted_workers(heavy) == 2);
+    CHECK(allotted_workers(light) == std::size_t(num_workers - 2));
+    is_released = true;
+    while (num_finished < 4) {
+        std::this_thread::yield();
+    }
+}
+
+//! Testing that the weights can be changed while the arenas request workers
+//! \brief \ref error_guessing
+TEST_CASE("Changing the weights while the arenas request workers") {
+    tbb::global_control control(tbb::global_control::max_allowed_parallelism, num_workers + 1);
+    wait_for_idle_workers();
+    tbb::task_arena first(num_workers + 1), second(num_workers + 1), third(num_workers + 1);
+    tbb::task_arena* arenas[] = { &first, &second, &third };
+
+    std::atomic<bool> is_done{false};
+    std::atomic<int> num_rounds{0};
+    std::vector<std::thread> threads;
+    for (tbb::task_arena* arena : arenas) {
+        threads.emplace_back([arena, &is_done, &num_rounds] {
+            // Every parallel_for makes the arena request the workers and drop the request at the end
+            while (!is_done) {
+                arena->execute([] {
+                    tbb::parallel_for(0, 1000, [](int) { utils::doDummyWork(10); });
+                });
+                ++num_rounds;
+            }
+        });
+    }
+    unsigned max_weight = tbb::task_arena::max_weight;
+    for (unsigned i = 0; i < 10000 || num_rounds < 100; ++i) {
+        arenas[i % 3]->set_weight(i % max_weight + 1);
+    }
+    is_done = true;
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    wait_for_idle_workers();
+    CHECK(tbb::info::global_scheduler_metrics().allotted_workers == 0);
+}
@@ -0,0 +1,166 @@
+/*
+    Copyright (c) 2024 Intel Corporation
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#define TBB_PREVIEW_TASK_DEADLINES 1
+
+#include "common/test.h"
+#include "common/utils.h"
+#include "common/utils_concurrency_limit.h"
+#include "common/spin_barrier.h"
+
+#include "tbb/global_control.h"
+#include "tbb/task_arena.h"
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+//! \file test_task_deadlines.cpp
+//! \brief Test for [scheduler.task_deadlines] preview feature
+
+//! Occupies the only worker of the arena until the work is released
+class blocker {
+public:
+    blocker(tbb::task_arena& arena) {
+        arena.enqueue([this] {
+            my_is_started = true;
+            while (!my_is_released) {
+                std::this_thread::yield();
+            }
+        });
+        utils::SpinWaitUntilEq(my_is_started, true);
+    }
+
+    void release() {
+        my_is_released = true;
+    }
+
+private:
+    std::atomic<bool> my_is_started{false};
+    std::atomic<bool> my_is_released{false};
+};
+
+//! Testing that the enqueued tasks are executed in the order of their deadlines
+//! \brief \ref requirement
+TEST_CASE("Earliest deadline first") {
+    tbb::global_control control(tbb::global_control::max_allowed_parallelism, 2);
+    tbb::task_arena arena(2, 1);
+    arena.initialize();
+
+    constexpr int num_tasks = 100;
+    std::mutex order_mutex;
+    std::vector<int> order;
+    std::atomic<int> num_executed{0};
+    auto record = [&](int id) {
+        return [&, id] {
+            {
+                std::lock_guard<std::mutex> lock(order_mutex);
+                order.push_back(id);
+            }
+            ++num_executed;
+        };
+    };
+
+    blocker b(arena);
+    auto start = std::chrono::steady_clock::now();
+    for (int i = num_tasks - 1; i >= 0; --i) {
+        // The tasks without deadlines are enqueued first but go last
+        arena.enqueue(record(num_tasks + i));
+        arena.enqueue(record(i), start + std::chrono::milliseconds(i));
+    }
+    b.release();
+    utils::SpinWaitUntilEq(num_executed, 2 * num_tasks);
+
+    bool is_deadline_order = true;
+    for (int i = 0; i < num_tasks; ++i) {
+        is_deadline_order = is_deadline_order && order[i] == i;
+    }
+    CHECK(is_deadline_order);
+    bool are_plain_tasks_last = true;
+    for (int i = num_tasks; i < 2 * num_tasks; ++i) {
+        are_plain_tasks_last = are_plain_tasks_last && order[i] >= num_tasks;
+    }
+    CHECK(are_plain_tasks_last);
+}
+
+//! Testing the latency overloads of task_arena and this_task_arena
+//! \brief \ref interface
+TEST_CASE("Enqueue with latency") {
+    tbb::task_arena arena;
+    std::atomic<int> num_executed{0};
+    arena.enqueue([&num_executed] { ++num_executed; }, std::chrono::microseconds(100));
+    arena.enqueue([&num_executed] { ++num_executed; }, std::chrono::steady_clock::now());
+    arena.execute([&num_executed] {
+        tbb::this_task_arena::enqueue([&num_executed] { ++num_executed; }, std::chrono::milliseconds(1));
+        tbb::this_task_arena::enqueue([&num_executed] { ++num_executed; },
+                                      std::chrono::steady_clock::time_point{});
+    });
+    utils::SpinWaitUntilEq(num_executed, 4);
+}
+
+//! Testing that the tasks with and without deadlines are executed under concurrent enqueueing
+//! \brief \ref error_guessing
+TEST_CASE("Concurrent enqueue with deadlines") {
+    tbb::task_arena arena;
+    constexpr int num_tasks = 1000;
+    std::size_t num_threads = utils::get_platform_max_threads();
+    std::atomic<int> num_executed{0};
+    utils::NativeParallelFor(num_threads, [&](std::size_t thread_idx) {
+        for (int i = 0; i < num_tasks; ++i) {
+            if ((i + thread_idx) % 3 == 0) {
+                arena.enqueue([&num_executed] { ++num_executed; });
+            } else {
+                arena.enqueue([&num_executed] { ++num_executed; }, std::chrono::microseconds(i % 17));
+            }
+        }
+    });
+    utils::SpinWaitUntilEq(num_executed, int(num_threads) * num_tasks);
+}
+
+//! Testing that a worker leaving an arena joins the arena with the earliest pending deadline
+//! \brief \ref requirement
+TEST_CASE("Worker joins the arena with the earliest deadline") {
+    // The only worker is shared by the arenas
+    tbb::global_control control(tbb::global_control::max_allowed_parallelism, 2);
+    for (int earliest : {0, 1}) {
+        tbb::task_arena busy_arena(2, 1);
+        tbb::task_arena arenas[2] = {{2, 1}, {2, 1}};
+        busy_arena.initialize();
+        arenas[0].initialize();
+        arenas[1].initialize();
+
+        std::atomic<int> num_executed{0};
+        std::atomic<int> first_executed{-1};
+        auto record = [&](int id) {
+            return [&, id] {
+                int expected = -1;
+                first_executed.compare_exchange_strong(expected, id);
+                ++num_executed;
+            };
+        };
+
+        blocker b(busy_arena);
+        auto now = std::chrono::steady_clock::now();
+        for (int i = 0; i < 2; ++i) {
+            arenas[i].enqueue(record(i), i == earliest ? now : now + std::chrono::hours(1));
+        }
+        b.release();
+        utils::SpinWaitUntilEq(num_executed, 2);
+        CHECK(first_executed == earliest);
+    }
+}
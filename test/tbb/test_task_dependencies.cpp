@@ -0,0 +1,246 @@
+/*
+    Copyright (c) 2024 Intel Corporation
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#define TBB_PREVIEW_TASK_DEPENDENCIES 1
+
+#include "common/test.h"
+#include "common/utils.h"
+
+#include "tbb/task_group.h"
+#include "tbb/task_arena.h"
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+//! \file test_task_dependencies.cpp
+//! \brief Test for [scheduler.task_dependencies] preview feature
+
+//! Testing that the tasks are executed in the order of the edges regardless of the order of submission
+//! \brief \ref interface \ref requirement
+TEST_CASE("Diamond of tasks") {
+    for (int i = 0; i < 100; ++i) {
+        tbb::task_group tg;
+        std::atomic<int> step{0};
+        std::atomic<bool> is_ordered{true};
+        auto check_after = [&is_ordered, &step] (int min_step) {
+            if (step.fetch_add(1) < min_step) {
+                is_ordered = false;
+            }
+        };
+        tbb::task_handle top = tg.defer([&] { check_after(0); });
+        tbb::task_handle left = tg.defer([&] { check_after(1); });
+        tbb::task_handle right = tg.defer([&] { check_after(1); });
+        tbb::task_handle bottom = tg.defer([&] { check_after(3); });
+        tbb::task_group::set_task_order(top, left);
+        tbb::task_group::set_task_order(top, right);
+        tbb::task_group::set_task_order(left, bottom);
+        tbb::task_group::set_task_order(right, bottom);
+
+        tg.run(std::move(bottom));
+        tg.run(std::move(right));
+        tg.run(std::move(left));
+        tg.run(std::move(top));
+        tg.wait();
+        CHECK(step == 4);
+        CHECK(is_ordered);
+    }
+}
+
+//! Testing the tasks with many predecessors and many successors
+//! \brief \ref requirement
+TEST_CASE("Wide fan-in and fan-out") {
+    constexpr int width = 1000;
+    tbb::task_group tg;
+    std::atomic<int> num_executed{0};
+    std::atomic<bool> is_ordered{true};
+
+    tbb::task_handle source = tg.defer([&] { ++num_executed; });
+    tbb::task_handle sink = tg.defer([&] {
+        if (num_executed != width + 1) {
+            is_ordered = false;
+        }
+    });
+    std::vector<tbb::task_handle> middle;
+    for (int i = 0; i < width; ++i) {
+        middle.push_back(tg.defer([&] {
+            if (num_executed.fetch_add(1) < 1) {
+                is_ordered = false;
+            }
+        }));
+        tbb::task_group::set_task_order(source, middle.back());
+        tbb::task_group::set_task_order(middle.back(), sink);
+    }
+    tg.run(std::move(sink));
+    for (auto& h : middle) {
+        tg.run(std::move(h));
+    }
+    tg.run(std::move(source));
+    tg.wait();
+    CHECK(num_executed == width + 1);
+    CHECK(is_ordered);
+}
+
+//! Testing a large graph of fine-grained tasks submitted concurrently with the execution
+//! \brief \ref requirement
+TEST_CASE("Large graph") {
+    constexpr std::size_t num_layers = 200;
+    constexpr std::size_t layer_size = 500;
+    std::vector<std::atomic<bool>> is_done(num_layers * layer_size);
+    std::atomic<std::size_t> num_violations{0};
+    tbb::task_group tg;
+
+    std::vector<tbb::task_handle> previous, current;
+    for (std::size_t layer = 0; layer < num_layers; ++layer) {
+        for (std::size_t i = 0; i < layer_size; ++i) {
+            std::size_t node = layer * layer_size + i;
+            current.push_back(tg.defer([&is_done, &num_violations, node] {
+                // Every node depends on two nodes of the previous layer
+                if (node >= layer_size) {
+                    std::size_t base = node - layer_size - node % layer_size;
+                    if (!is_done[node - layer_size] || !is_done[base + (node + 1) % layer_size]) {
+                        ++num_violations;
+                    }
+                }
+                is_done[node] = true;
+            }));
+            if (layer > 0) {
+                tbb::task_group::set_task_order(previous[i], current.back());
+                tbb::task_group::set_task_order(previous[(i + 1) % layer_size], current.back());
+            }
+        }
+        for (auto& h : previous) {
+            tg.run(std::move(h));
+        }
+        previous.swap(current);
+        current.clear();
+    }
+    for (auto& h : previous) {
+        tg.run(std::move(h));
+    }
+    tg.wait();
+    std::size_t num_done = 0;
+    for (auto& flag : is_done) {
+        num_done += flag ? 1 : 0;
+    }
+    CHECK(num_done == num_layers * layer_size);
+    CHECK(num_violations == 0);
+}
+
+//! Testing the destruction of the handles that were not submitted
+//! \brief \ref error_guessing
+TEST_CASE("Discarded task handles") {
+    tbb::task_group tg;
+    std::atomic<int> num_executed{0};
+    {
+        // The successors are released when the predecessor is discarded
+        tbb::task_handle predecessor = tg.defer([&] { ++num_executed; });
+        tbb::task_handle successor = tg.defer([&] { num_executed += 10; });
+        tbb::task_group::set_task_order(predecessor, successor);
+        tg.run(std::move(successor));
+    }
+    tg.wait();
+    CHECK(num_executed == 10);
+
+    num_executed = 0;
+    {
+        // The discarded successor is not executed, but its successors are
+        tbb::task_handle first = tg.defer([&] { ++num_executed; });
+        tbb::task_handle second = tg.defer([&] { num_executed += 10; });
+        tbb::task_handle third = tg.defer([&] { num_executed += 100; });
+        tbb::task_group::set_task_order(first, second);
+        tbb::task_group::set_task_order(second, third);
+        tg.run(std::move(third));
+        tbb::task_handle dropped = std::move(second);
+        tg.run(std::move(first));
+    }
+    tg.wait();
+    CHECK(num_executed == 101);
+}
+
+//! Testing that the successors released by a discarded handle go to the arena of the destroying thread
+//! \brief \ref requirement
+TEST_CASE("Successors of a handle discarded in another arena") {
+    tbb::task_arena submitting_arena(2);
+    tbb::task_arena destroying_arena(3);
+    tbb::task_group tg;
+    std::atomic<int> successor_arena_concurrency{0};
+    tbb::task_handle predecessor = tg.defer([] {});
+    submitting_arena.execute([&] {
+        tbb::task_handle successor = tg.defer([&] {
+            successor_arena_concurrency = tbb::this_task_arena::max_concurrency();
+        });
+        tbb::task_group::set_task_order(predecessor, successor);
+        tg.run(std::move(successor));
+    });
+    destroying_arena.execute([&] {
+        tbb::task_handle dropped = std::move(predecessor);
+    });
+    destroying_arena.execute([&tg] { tg.wait(); });
+    CHECK(successor_arena_concurrency == destroying_arena.max_concurrency());
+}
+
+//! Testing run_and_wait of the tasks with predecessors and task_arena::enqueue of their predecessors
+//! \brief \ref interface
+TEST_CASE("Submission of a task with predecessors") {
+    tbb::task_group tg;
+    std::atomic<int> num_executed{0};
+    tbb::task_handle first = tg.defer([&] { ++num_executed; });
+    tbb::task_handle second = tg.defer([&] { num_executed += 10; });
+    tbb::task_group::set_task_order(first, second);
+    tg.run(std::move(first));
+    CHECK(tg.run_and_wait(std::move(second)) == tbb::complete);
+    CHECK(num_executed == 11);
+
+    // The successor is spawned into the arena where its predecessor is executed
+    tbb::task_arena arena(2);
+    std::atomic<int> successor_arena_concurrency{0};
+    first = tg.defer([&] { ++num_executed; });
+    second = tg.defer([&] {
+        num_executed += 10;
+        successor_arena_concurrency = tbb::this_task_arena::max_concurrency();
+    });
+    tbb::task_group::set_task_order(first, second);
+    tg.run(std::move(second));
+    arena.enqueue(std::move(first));
+    arena.execute([&tg] { tg.wait(); });
+    CHECK(num_executed == 22);
+    CHECK(successor_arena_concurrency == arena.max_concurrency());
+}
+
+//! Testing that the cancellation of the group releases the successors of the cancelled tasks
+//! \brief \ref error_guessing
+TEST_CASE("Cancellation of a graph") {
+    constexpr int chain_length = 1000;
+    tbb::task_group tg;
+    std::atomic<int> num_executed{0};
+    std::vector<tbb::task_handle> chain;
+    for (int i = 0; i < chain_length; ++i) {
+        chain.push_back(tg.defer([&tg, &num_executed] {
+            if (++num_executed == chain_length / 2) {
+                tg.cancel();
+            }
+        }));
+        if (i > 0) {
+            tbb::task_group::set_task_order(chain[i - 1], chain[i]);
+        }
+    }
+    for (auto& h : chain) {
+        tg.run(std::move(h));
+    }
+    CHECK(tg.wait() == tbb::canceled);
+    CHECK(num_executed == chain_length / 2);
+}
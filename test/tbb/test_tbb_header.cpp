@@ -125,6 +125,12 @@ struct Body3 { // for parallel_scan
 struct Body3a { // for lambda-friednly parallel_scan
     int operator() ( const tbb::blocked_range<int>&, const int, bool ) const { return 0; }
 };
+struct Body4 { // for parallel_for_chain
+    void operator() ( const tbb::blocked_range<int>&, std::size_t ) const {}
+};
+struct Body5 { // for parallel_wavefront
+    void operator() ( const tbb::blocked_range2d<int>& ) const {}
+};
 struct Msg {};
 
 // Test if all the necessary symbols are exported for the exceptions thrown by TBB.
@@ -174,6 +180,27 @@ static void TestExceptionClassesExports () {
 static void TestPreviewNames() {
     TestTypeDefinitionPresence2( concurrent_lru_cache<int, int> );
     TestTypeDefinitionPresence( isolated_task_group );
+    TestTypeDefinitionPresence( radix_sort_tag );
+    TestFuncDefinitionPresence( parallel_sort, (int*, int*, const std::less<int>&, tbb::radix_sort_tag), void );
+    TestFuncDefinitionPresence( parallel_stable_sort, (int*, int*), void );
+    TestFuncDefinitionPresence( parallel_nth_element, (int*, int*, int*), void );
+    TestFuncDefinitionPresence( parallel_partial_sort, (int*, int*, int*, const std::less<int>&), void );
+    TestFuncDefinitionPresence( parallel_inclusive_scan, (int*, int*, int*), int* );
+    TestFuncDefinitionPresence( parallel_exclusive_scan, (int*, int*, int*, int), int* );
+    TestFuncDefinitionPresence( parallel_count_if, (int*, int*, const std::logical_not<int>&), std::ptrdiff_t );
+    TestFuncDefinitionPresence( parallel_find_if, (int*, int*, const std::logical_not<int>&), int* );
+    TestTypeDefinitionPresence( learning_partitioner );
+    TestTypeDefinitionPresence2( weighted_blocked_range<std::size_t, const std::size_t*> );
+    TestTypeDefinitionPresence( cache_oblivious_range<tbb::blocked_range2d<int>> );
+    TestTypeDefinitionPresence( traversal_order );
+    TestFuncDefinitionPresence( parallel_for_chain, (const tbb::blocked_range<int>&, std::size_t, const Body4&), void );
+    TestFuncDefinitionPresence( parallel_wavefront, (const tbb::blocked_range2d<int>&, const Body5&), void );
+    TestTypeDefinitionPresence( steal_statistics );
+    TestFuncDefinitionPresence( info::this_thread_steal_statistics, (), tbb::steal_statistics );
+    TestFuncDefinitionPresence( info::threads_steal_statistics, (), std::vector<tbb::steal_statistics> );
+    TestTypeDefinitionPresence( scheduler_metrics );
+    TestFuncDefinitionPresence( info::global_scheduler_metrics, (), tbb::scheduler_metrics );
+    TestFuncDefinitionPresence( dump_scheduler_trace, (const char*), bool );
 }
 #endif
 
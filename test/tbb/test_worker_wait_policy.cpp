@@ -0,0 +1,124 @@
+/*
+    Copyright (c) 2024 Intel Corporation
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#define TBB_PREVIEW_WORKER_WAIT_POLICY 1
+
+#include "common/test.h"
+#include "common/utils.h"
+#include "common/utils_concurrency_limit.h"
+
+#include "tbb/global_control.h"
+#include "tbb/parallel_for.h"
+#include "tbb/task_arena.h"
+#include "tbb/task_group.h"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+//! \file test_worker_wait_policy.cpp
+//! \brief Test for [scheduler.worker_wait_policy] preview feature
+
+using wait_policy = tbb::global_control::wait_policy;
+
+static std::size_t active_policy() {
+    return tbb::global_control::active_value(tbb::global_control::worker_wait_policy);
+}
+
+//! Runs the work in bursts separated by pauses, so the threads have to wait for it
+static void run_bursts(std::size_t concurrency_level) {
+    tbb::task_arena arena(static_cast<int>(concurrency_level));
+    for (int burst = 0; burst < 5; ++burst) {
+        std::atomic<int> sum{0};
+        arena.execute([&sum] {
+            tbb::parallel_for(0, 1000, [&sum](int i) {
+                utils::doDummyWork(10);
+                sum += i;
+            });
+        });
+        CHECK(sum == 999 * 1000 / 2);
+
+        std::atomic<int> num_executed{0};
+        tbb::task_group tg;
+        arena.execute([&tg, &num_executed] {
+            for (int i = 0; i < 10; ++i) {
+                tg.run([&num_executed] { ++num_executed; });
+            }
+        });
+        arena.execute([&tg] { tg.wait(); });
+        CHECK(num_executed == 10);
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+}
+
+//! Testing that the work is executed with every policy
+//! \brief \ref requirement
+TEST_CASE("Work is executed with every wait policy") {
+    CHECK(active_policy() == tbb::global_control::balanced_wait_policy);
+    const wait_policy policies[] = {
+        tbb::global_control::power_saving_wait_policy,
+        tbb::global_control::balanced_wait_policy,
+        tbb::global_control::low_latency_wait_policy
+    };
+    for (wait_policy policy : policies) {
+        tbb::global_control control(tbb::global_control::worker_wait_policy, policy);
+        CHECK(active_policy() == std::size_t(policy));
+        for (auto concurrency_level : utils::concurrency_range()) {
+            tbb::global_control parallelism(tbb::global_control::max_allowed_parallelism, concurrency_level);
+            run_bursts(concurrency_level);
+        }
+    }
+    CHECK(active_policy() == tbb::global_control::balanced_wait_policy);
+}
+
+//! Testing that the policy that spends less processor time is preferred
+//! \brief \ref requirement
+TEST_CASE("Several objects set the wait policy") {
+    {
+        tbb::global_control low_latency(tbb::global_control::worker_wait_policy,
+                                        tbb::global_control::low_latency_wait_policy);
+        CHECK(active_policy() == tbb::global_control::low_latency_wait_policy);
+        {
+            tbb::global_control power_saving(tbb::global_control::worker_wait_policy,
+                                             tbb::global_control::power_saving_wait_policy);
+            CHECK(active_policy() == tbb::global_control::power_saving_wait_policy);
+            run_bursts(utils::get_platform_max_threads());
+        }
+        CHECK(active_policy() == tbb::global_control::low_latency_wait_policy);
+    }
+    CHECK(active_policy() == tbb::global_control::balanced_wait_policy);
+}
+
+//! Testing that the policy can be changed while the threads wait for work
+//! \brief \ref error_guessing
+TEST_CASE("Wait policy is changed concurrently") {
+    std::size_t num_threads = utils::get_platform_max_threads();
+    tbb::global_control parallelism(tbb::global_control::max_allowed_parallelism, num_threads);
+    std::atomic<bool> is_done{false};
+    std::thread changer([&is_done] {
+        while (!is_done) {
+            tbb::global_control control(tbb::global_control::worker_wait_policy,
+                                        tbb::global_control::power_saving_wait_policy);
+            std::this_thread::yield();
+            tbb::global_control other(tbb::global_control::worker_wait_policy,
+                                      tbb::global_control::low_latency_wait_policy);
+            std::this_thread::yield();
+        }
+    });
+    run_bursts(num_threads);
+    is_done = true;
+    changer.join();
+}